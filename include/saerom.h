@@ -42,8 +42,75 @@
 #define MAX_STRING_SIZE          1024
 #define MAX_TEXT_LENGTH          256
 
+#define DEFAULT_DICT_PATH        "res/krdict.dict"
+
 /* | 자료형 정의... | */
 
+/* 작업 스레드 풀에서 호출될 함수를 나타내는 자료형. */
+typedef void (*sr_worker_callback)(void *data);
+
+/* 캐시를 나타내는 구조체. */
+struct sr_cache;
+
+/* 사전 데이터를 나타내는 구조체. */
+struct sr_dict;
+
+/* 검색에 사용되는 사전 데이터 파일의 목록을 나타내는 구조체. */
+struct sr_dict_snapshot;
+
+/* 사전 데이터 파일의 개별 뜻풀이를 나타내는 구조체. */
+struct sr_dict_sense {
+    const char *word;
+    const char *origin;
+    const char *pos;
+    const char *link;
+    const char *definition;
+    const char *trans_word;
+    const char *trans_dfn;
+    int order;
+    int level;
+};
+
+/* 사전 데이터의 학습 등급을 나타내는 열거형. */
+enum sr_dict_level {
+    SR_DICT_LEVEL_NONE,
+    SR_DICT_LEVEL_ADVANCED,
+    SR_DICT_LEVEL_INTERMEDIATE,
+    SR_DICT_LEVEL_BEGINNER
+};
+
+/* 자동 완성 색인을 나타내는 구조체. */
+struct sr_suggest;
+
+/* 블룸 필터를 나타내는 구조체. */
+struct sr_bloom;
+
+/* 캐시의 항목 교체 정책을 나타내는 열거형. */
+enum sr_cache_policy {
+    SR_CACHE_POLICY_LRU,
+    SR_CACHE_POLICY_TINYLFU
+};
+
+/* 캐시의 통계 정보를 나타내는 구조체. */
+struct sr_cache_stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t expirations;
+    uint64_t rejections;
+    size_t count;
+    size_t size;
+    size_t budget;
+};
+
+/* 크기가 정해진 버퍼에 문자열을 이어 붙이는 구조체. */
+struct sr_strbuf {
+    char *str;
+    size_t size;
+    size_t len;
+    bool truncated;
+};
+
 /* Discord 봇의 명령어를 나타내는 구조체. */
 struct sr_command {
     const char *name;
@@ -53,6 +120,7 @@ struct sr_command {
         struct discord *client,
         const struct discord_interaction *event
     );
+    void (*on_idle)(struct discord *client);
 };
 
 /* Discord 봇의 명령어 실행 정보를 나타내는 구조체. */
@@ -73,6 +141,29 @@ enum sr_status_flag {
     SR_STATUS_RUNNING = (1 << 0)
 };
 
+/* | `bloom` 모듈 함수... | */
+
+/* 
+    블룸 필터를 생성한다. 
+    `count`개의 항목을 추가했을 때, 오탐률이 `false_positive_rate`가 되도록 한다.
+*/
+struct sr_bloom *sr_bloom_create(size_t count, double false_positive_rate);
+
+/* 블룸 필터에 할당된 메모리를 해제한다. */
+void sr_bloom_release(struct sr_bloom *bloom);
+
+/* 블룸 필터에 주어진 문자열을 추가한다. */
+void sr_bloom_add(struct sr_bloom *bloom, const char *key);
+
+/*
+    블룸 필터에 주어진 문자열이 있을 수도 있는지 확인한다.
+    이 함수가 `false`를 반환했다면, 주어진 문자열은 블룸 필터에 절대로 없다.
+*/
+bool sr_bloom_test(const struct sr_bloom *bloom, const char *key);
+
+/* 블룸 필터의 메모리 사용량 (단위: 바이트)을 반환한다. */
+size_t sr_bloom_get_size(const struct sr_bloom *bloom);
+
 /* | `bot` 모듈 함수... | */
 
 /* Discord 봇을 초기화한다. */
@@ -102,6 +193,45 @@ double sr_get_ram_usage(void);
 /* Discord 봇의 작동 시간 (단위: 밀리초)을 반환한다. */
 uint64_t sr_get_uptime(void);
 
+/* | `cache` 모듈 함수... | */
+
+/* 캐시를 생성한다. */
+struct sr_cache *sr_cache_create(
+    size_t budget, 
+    uint64_t ttl, 
+    enum sr_cache_policy policy
+);
+
+/* 주어진 경로의 파일에 항목들을 기록하는 캐시를 생성한다. */
+struct sr_cache *sr_cache_open(
+    const char *path,
+    size_t budget, 
+    uint64_t ttl, 
+    enum sr_cache_policy policy
+);
+
+/* 캐시에 할당된 메모리를 해제한다. */
+void sr_cache_release(struct sr_cache *cache);
+
+/* 캐시에서 주어진 키에 해당하는 값을 읽는다. */
+size_t sr_cache_get(
+    struct sr_cache *cache,
+    const char *key,
+    void *buffer,
+    size_t size
+);
+
+/* 캐시에 주어진 키와 값을 저장한다. */
+void sr_cache_put(
+    struct sr_cache *cache,
+    const char *key,
+    const void *value,
+    size_t len
+);
+
+/* 캐시의 통계 정보를 반환한다. */
+void sr_cache_get_stats(struct sr_cache *cache, struct sr_cache_stats *stats);
+
 /* | `config` 모듈 함수... | */
 
 /* Discord 봇의 환경 설정을 초기화한다. */
@@ -134,12 +264,128 @@ const char *sr_config_get_papago_client_id(void);
 /* Discord 봇의 NAVER™ Papago NMT API 클라이언트 시크릿을 반환한다. */
 const char *sr_config_get_papago_client_secret(void);
 
+/* Discord 봇의 `/krd` 명령어 캐시의 메모리 예산 (단위: 바이트)을 반환한다. */
+size_t sr_config_get_krdict_cache_budget(void);
+
+/* Discord 봇의 `/krd` 명령어 캐시의 유효 기간 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_krdict_cache_ttl(void);
+
+/* Discord 봇의 `/krd` 명령어 캐시 파일의 경로를 반환한다. */
+const char *sr_config_get_krdict_cache_path(void);
+
+/* Discord 봇의 `/krd` 명령어 검색 결과가 없는 검색어 캐시의 유효 기간 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_krdict_cache_negative_ttl(void);
+
+/* Discord 봇의 `/krd` 명령어 사전 데이터 파일의 경로를 반환한다. */
+const char *sr_config_get_krdict_dict_path(void);
+
+/* Discord 봇의 `/krd` 명령어 사전 데이터 파일의 유효 기간 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_krdict_dict_max_age(void);
+
+/* Discord 봇의 `/krd` 명령어 표제어 블룸 필터의 오탐률을 반환한다. */
+double sr_config_get_krdict_dict_false_positive_rate(void);
+
+/* Discord 봇의 `/krd` 명령어 검색 기록 파일의 경로를 반환한다. */
+const char *sr_config_get_krdict_autocomplete_path(void);
+
+/* Discord 봇의 `/krd` 명령어가 두 오픈 API에 동시에 요청을 보내는지 확인한다. */
+bool sr_config_get_krdict_fanout_enabled(void);
+
+/* Discord 봇의 `/krd` 명령어가 두 오픈 API의 검색 결과를 합치는 기한 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_krdict_fanout_deadline(void);
+
+/* Discord 봇의 `/krd` 명령어가 표제어 검색 뒤에 같은 검색어의 용례를 미리 가져오는지 확인한다. */
+bool sr_config_get_krdict_prefetch_examples(void);
+
+/* Discord 봇의 `/krd` 명령어가 검색 결과를 미리 가져오는 요청의 1분당 최대 개수를 반환한다. */
+int sr_config_get_krdict_prefetch_rate(void);
+
+/* Discord 봇의 `/krd` 명령어가 사용하는 오픈 API 키마다 하루에 보낼 수 있는 요청의 개수를 반환한다. */
+int sr_config_get_krdict_prefetch_quota(void);
+
+/* Discord 봇의 `/ppg` 명령어 캐시의 메모리 예산 (단위: 바이트)을 반환한다. */
+size_t sr_config_get_papago_cache_budget(void);
+
+/* Discord 봇의 `/ppg` 명령어 캐시의 유효 기간 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_papago_cache_ttl(void);
+
+/* Discord 봇의 `/ppg` 명령어 캐시 파일의 경로를 반환한다. */
+const char *sr_config_get_papago_cache_path(void);
+
+/* Discord 봇의 작업 스레드 개수를 반환한다. */
+int sr_config_get_worker_count(void);
+
 /* Discord 봇의 모듈 플래그 데이터를 설정한다. */
 void sr_config_set_module_flags(u64bitmask flags);
 
 /* Discord 봇의 상태 플래그 데이터를 설정한다. */
 void sr_config_set_status_flags(u64bitmask flags);
 
+/* | `dict` 모듈 함수... | */
+
+/* 사전 데이터를 연다. */
+struct sr_dict *sr_dict_open(const char *path);
+
+/* 사전 데이터를 닫는다. */
+void sr_dict_close(struct sr_dict *dict);
+
+/* 새로 추가된 변경분 파일들을 읽고, 필요하다면 백그라운드에서 병합한다. */
+void sr_dict_refresh(struct sr_dict *dict);
+
+/* 검색에 사용할 사전 데이터 파일의 목록을 가져온다. */
+struct sr_dict_snapshot *sr_dict_acquire(struct sr_dict *dict);
+
+/* 검색에 사용한 사전 데이터 파일의 목록을 반환한다. */
+void sr_dict_release(struct sr_dict_snapshot *snapshot);
+
+/* 사전 데이터가 마지막으로 갱신된 시각 (단위: 밀리초)을 반환한다. */
+uint64_t sr_dict_get_timestamp(const struct sr_dict_snapshot *snapshot);
+
+/* 사전 데이터의 표제어 개수 (변경분 파일의 표제어 포함)를 반환한다. */
+size_t sr_dict_get_word_count(const struct sr_dict_snapshot *snapshot);
+
+/* 사전 데이터에서 주어진 표제어의 뜻풀이를 찾는다. */
+int sr_dict_find(
+    const struct sr_dict_snapshot *snapshot,
+    const char *word,
+    struct sr_dict_sense *senses,
+    int count,
+    int *total
+);
+
+/* 사전 데이터에서 주어진 문자열로 시작하는 표제어들을 바이트 순서로 찾는다. */
+int sr_dict_find_prefix(
+    const struct sr_dict_snapshot *snapshot,
+    const char *prefix,
+    const char **words,
+    int count
+);
+
+/* 사전 데이터에서 주어진 범위 (`first` 이상, `last` 미만)의 표제어들을 바이트 순서로 찾는다. */
+int sr_dict_find_range(
+    const struct sr_dict_snapshot *snapshot,
+    const char *first,
+    const char *last,
+    const char **words,
+    int count
+);
+
+/* 국립국어원 사전 데이터 (LMF 형식의 XML 파일)를 사전 데이터 파일로 변환한다. */
+bool sr_dict_import(
+    const char *inputs[], 
+    int count, 
+    const char *output, 
+    int threads
+);
+
+/* 국립국어원 사전 데이터의 변경분을 사전 데이터 파일의 새로운 변경분 파일로 변환한다. */
+bool sr_dict_update(
+    const char *inputs[], 
+    int count, 
+    const char *path, 
+    int threads
+);
+
 /* | `info` 모듈 함수... | */
 
 /* `/info` 명령어를 생성한다. */
@@ -154,6 +400,14 @@ void sr_command_info_run(
     const struct discord_interaction *event
 );
 
+/* | `keyboard` 모듈 함수... | */
+
+/*
+    두벌식 자판으로 입력한 로마자 문자열을 한글로 바꾼다.
+    모든 글자가 완성된 한글 음절로 바뀌었을 때만 `true`를 반환한다.
+*/
+bool sr_keyboard_to_hangul(const char *str, char *buffer, size_t size);
+
 /* | `krdict` 모듈 함수... | */
 
 /* `/krd` 명령어를 생성한다. */
@@ -162,28 +416,58 @@ void sr_command_krdict_init(struct discord *client);
 /* `/krd` 명령어에 할당된 메모리를 해제한다. */
 void sr_command_krdict_cleanup(struct discord *client);
 
+/* Discord 봇이 대기 중일 때 `/krd` 명령어의 기한이 지난 요청과 미뤄 둔 요청을 처리한다. */
+void sr_command_krdict_idle(struct discord *client);
+
 /* `/krd` 명령어를 실행한다. */
 void sr_command_krdict_run(
     struct discord *client,
     const struct discord_interaction *event
 );
 
-/* `/krd` 명령어의 오픈 API 요청을 생성한다. */
-void sr_command_krdict_create_request(
+/* `/krd` 명령어의 검색 요청을 처리한다. */
+void sr_command_krdict_search(
     struct discord *client,
     const struct discord_interaction *event,
-    curlv_read_callback on_response,
     const char *query,
     const char *part,
     const char *translated
 );
 
+/* 
+    `/krd` 명령어의 오픈 API 요청을 생성하고, 응답을 처리할 때 사용할 정보를 반환한다.
+    (`on_response`가 `NULL`이면 기본 함수를 사용한다.)
+*/
+struct sr_command_context *sr_command_krdict_create_request(
+    struct discord *client,
+    const struct discord_interaction *event,
+    curlv_read_callback on_response,
+    const char *query,
+    const char *part,
+    const char *translated,
+    int start
+);
+
 /* `/krd` 명령어 처리 과정에서 발생한 오류를 처리한다. */
 void sr_command_krdict_handle_error(
     struct sr_command_context *context, 
     const char *code
 );
 
+/*
+    `/krd` 명령어의 검색 결과를 전송한다. `count`는 이 페이지에서 보여준 항목의 개수이다.
+    검색 결과가 없다면, 캐시 키의 검색어와 비슷한 표제어들을 함께 보여준다.
+*/
+void sr_command_krdict_send_results(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *key,
+    const char *buffer,
+    int total,
+    int count,
+    bool deferred
+);
+
 /* `/krd` 명령어의 응답 데이터를 가공한다. */
 int sr_command_krdict_parse_data(
     CURLV_STR xml, 
@@ -192,6 +476,23 @@ int sr_command_krdict_parse_data(
     u64bitmask flags
 );
 
+/* `/krd` 명령어 캐시의 통계 정보를 반환한다. */
+void sr_command_krdict_get_cache_stats(struct sr_cache_stats *stats);
+
+/* | `lemma` 모듈 함수... | */
+
+/*
+    주어진 활용형의 기본형 후보들을 가능성이 높은 순서대로 찾는다.
+    각 후보는 `buffer`에 저장되며, `lemmas`는 `buffer`의 각 후보를 가리킨다.
+*/
+int sr_lemma_find(
+    const char *word,
+    char *buffer,
+    size_t size,
+    const char **lemmas,
+    int count
+);
+
 /* | `owner` 모듈 함수... | */
 
 /* `/msg` 명령어를 생성한다. */
@@ -238,6 +539,92 @@ void sr_command_papago_handle_error(
     const char *code
 );
 
+/* `/ppg` 명령어 캐시의 통계 정보를 반환한다. */
+void sr_command_papago_get_cache_stats(struct sr_cache_stats *stats);
+
+/* `/ppg` 명령어 캐시 덕분에 요청하지 않은 글자 수를 반환한다. */
+uint64_t sr_command_papago_get_saved_characters(void);
+
+/* | `strbuf` 모듈 함수... | */
+
+/* 문자열 버퍼를 초기화한다. */
+void sr_strbuf_init(struct sr_strbuf *sb, char *buffer, size_t size);
+
+/* 
+    문자열 버퍼에 주어진 문자열의 `len` 바이트를 추가한다. 
+    공간이 부족하여 문자열의 일부만 추가했다면, `false`를 반환한다.
+*/
+bool sr_strbuf_append(struct sr_strbuf *sb, const char *str, size_t len);
+
+/* 
+    문자열 버퍼에 주어진 형식의 문자열을 추가한다. 
+    공간이 부족하여 문자열의 일부만 추가했다면, `false`를 반환한다.
+*/
+bool sr_strbuf_printf(struct sr_strbuf *sb, const char *format, ...);
+
+/* 문자열 버퍼의 내용을 앞에서부터 `len` 바이트만 남기고 버린다. */
+void sr_strbuf_rewind(struct sr_strbuf *sb, size_t len);
+
+/* | `suggest` 모듈 함수... | */
+
+/* 자동 완성 색인을 생성한다. */
+struct sr_suggest *sr_suggest_create(void);
+
+/* 자동 완성 색인에 할당된 메모리를 해제한다. */
+void sr_suggest_release(struct sr_suggest *suggest);
+
+/*
+    자동 완성 색인에 주어진 표제어를 추가한다.
+    표제어 목록은 `sr_suggest_build()`를 호출한 뒤에 검색할 수 있다.
+*/
+void sr_suggest_add(struct sr_suggest *suggest, const char *word, int level);
+
+/* 자동 완성 색인의 표제어 목록을 검색할 수 있도록 정리한다. */
+void sr_suggest_build(struct sr_suggest *suggest);
+
+/* 
+    주어진 표제어의 검색 횟수를 늘린다. 
+    자동 완성 색인에 없는 표제어는 모아 두었다가 `sr_suggest_merge()`로 한꺼번에 추가한다.
+*/
+void sr_suggest_hit(struct sr_suggest *suggest, const char *word);
+
+/* 자동 완성 색인에 새로 추가할 표제어들이 충분히 모였다면, 합칠 준비를 한다. */
+bool sr_suggest_begin_merge(struct sr_suggest *suggest);
+
+/* 작업 스레드에서 자동 완성 색인과 새로 추가할 표제어들을 합친 새로운 색인을 만든다. */
+void sr_suggest_merge(struct sr_suggest *suggest);
+
+/* 자동 완성 색인을 작업 스레드에서 만든 새로운 색인으로 바꾼다. */
+void sr_suggest_end_merge(struct sr_suggest *suggest);
+
+/*
+    주어진 문자열로 시작하는 표제어들을 우선순위 (검색 횟수, 학습 등급 순)대로 찾는다.
+    이 함수는 메모리를 할당하지 않는다.
+*/
+int sr_suggest_find(
+    const struct sr_suggest *suggest,
+    const char *prefix,
+    const char **words,
+    int count
+);
+
+/*
+    주어진 문자열과 자모 단위의 편집 거리가 가까운 표제어들을 찾는다.
+    이 함수는 메모리를 할당하지 않는다.
+*/
+int sr_suggest_correct(
+    const struct sr_suggest *suggest,
+    const char *word,
+    const char **words,
+    int count
+);
+
+/* 자동 완성 색인의 검색 기록을 주어진 파일에서 읽는다. */
+bool sr_suggest_load(struct sr_suggest *suggest, const char *path);
+
+/* 자동 완성 색인의 검색 기록을 주어진 파일에 기록한다. */
+bool sr_suggest_save(const struct sr_suggest *suggest, const char *path);
+
 /* | `utils` 모듈 함수... | */
 
 /* 주어진 사용자의 프로필 사진 URL을 반환한다. */
@@ -249,7 +636,35 @@ void *read_input(void *arg);
 /* 두 문자열의 내용이 서로 같은지 확인한다. */
 bool streq(const char *s1, const char *s2);
 
+/* 주어진 문자열의 앞뒤 공백을 제거하고, 연속된 공백을 하나로 합친다. */
+size_t normalize_text(const char *str, char *buffer, size_t size);
+
 /* UTF-8로 인코딩된 문자열의 길이를 반환한다. */
 size_t utf8len(const char *str);
 
+/* | `worker` 모듈 함수... | */
+
+/* 작업 스레드 풀을 초기화한다. */
+void sr_worker_init(int count);
+
+/* 작업 스레드 풀에 할당된 메모리를 해제한다. */
+void sr_worker_cleanup(void);
+
+/* 작업 스레드 풀에 새로운 작업을 추가한다. */
+void sr_worker_push(
+    sr_worker_callback on_work,
+    sr_worker_callback on_done,
+    void *data
+);
+
+/* 작업 스레드 풀에 다른 작업이 없을 때만 처리할 새로운 작업을 추가한다. */
+void sr_worker_push_idle(
+    sr_worker_callback on_work,
+    sr_worker_callback on_done,
+    void *data
+);
+
+/* 작업 스레드 풀에서 처리가 끝난 작업들의 후처리 함수를 호출한다. */
+void sr_worker_read_results(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+
+#include <saerom.h>
+
+/* | `bloom` 모듈 매크로 정의... | */
+
+#define MIN_BIT_COUNT   64
+#define MAX_HASH_COUNT  16
+
+/* | `bloom` 모듈 자료형 정의... | */
+
+/* 블룸 필터를 나타내는 구조체. */
+struct sr_bloom {
+    uint64_t *bits;
+    uint64_t bit_count;
+    int hash_count;
+    size_t count;
+};
+
+/* | `bloom` 모듈 함수... | */
+
+/* 주어진 문자열의 64비트 해시 값을 구한다. */
+static uint64_t sr_bloom_hash(const char *key);
+
+/* 
+    블룸 필터를 생성한다. 
+    `count`개의 항목을 추가했을 때, 오탐률이 `false_positive_rate`가 되도록 한다.
+*/
+struct sr_bloom *sr_bloom_create(size_t count, double false_positive_rate) {
+    if (false_positive_rate <= 0.0 || false_positive_rate >= 1.0) return NULL;
+
+    if (count == 0) count = 1;
+
+    // 비트 수 `m = -n ln p / (ln 2)^2`, 해시 함수 개수 `k = (m / n) ln 2`
+    double bit_count = ceil(-(double) count * log(false_positive_rate) / (M_LN2 * M_LN2));
+
+    if (bit_count < MIN_BIT_COUNT) bit_count = MIN_BIT_COUNT;
+
+    int hash_count = (int) round((bit_count / count) * M_LN2);
+
+    if (hash_count < 1) hash_count = 1;
+    else if (hash_count > MAX_HASH_COUNT) hash_count = MAX_HASH_COUNT;
+
+    struct sr_bloom *result = calloc(1, sizeof(*result));
+
+    result->bit_count = ((uint64_t) bit_count + 63) & ~((uint64_t) 63);
+    result->hash_count = hash_count;
+    result->bits = calloc(result->bit_count / 64, sizeof(*result->bits));
+
+    return result;
+}
+
+/* 블룸 필터에 할당된 메모리를 해제한다. */
+void sr_bloom_release(struct sr_bloom *bloom) {
+    if (bloom == NULL) return;
+
+    free(bloom->bits);
+    free(bloom);
+}
+
+/* 블룸 필터에 주어진 문자열을 추가한다. */
+void sr_bloom_add(struct sr_bloom *bloom, const char *key) {
+    if (bloom == NULL || key == NULL) return;
+
+    const uint64_t hash = sr_bloom_hash(key);
+
+    // 두 해시 값의 선형 결합으로 `k`개의 해시 값을 만든다.
+    const uint32_t lhs = hash, rhs = (hash >> 32) | 1;
+
+    for (int i = 0; i < bloom->hash_count; i++) {
+        const uint64_t bit = ((uint64_t) lhs + (uint64_t) i * rhs) % bloom->bit_count;
+
+        bloom->bits[bit >> 6] |= (uint64_t) 1 << (bit & 63);
+    }
+
+    bloom->count++;
+}
+
+/*
+    블룸 필터에 주어진 문자열이 있을 수도 있는지 확인한다.
+    이 함수가 `false`를 반환했다면, 주어진 문자열은 블룸 필터에 절대로 없다.
+*/
+bool sr_bloom_test(const struct sr_bloom *bloom, const char *key) {
+    if (bloom == NULL || key == NULL) return true;
+
+    const uint64_t hash = sr_bloom_hash(key);
+
+    const uint32_t lhs = hash, rhs = (hash >> 32) | 1;
+
+    for (int i = 0; i < bloom->hash_count; i++) {
+        const uint64_t bit = ((uint64_t) lhs + (uint64_t) i * rhs) % bloom->bit_count;
+
+        if (!(bloom->bits[bit >> 6] & ((uint64_t) 1 << (bit & 63)))) return false;
+    }
+
+    return true;
+}
+
+/* 블룸 필터의 메모리 사용량 (단위: 바이트)을 반환한다. */
+size_t sr_bloom_get_size(const struct sr_bloom *bloom) {
+    return (bloom != NULL) ? bloom->bit_count / 8 : 0;
+}
+
+/* 주어진 문자열의 64비트 해시 값을 구한다. */
+static uint64_t sr_bloom_hash(const char *key) {
+    // FNV-1a 해시 함수를 사용한 뒤에, 상위 비트와 하위 비트를 섞는다.
+    uint64_t result = 14695981039346656037ULL;
+
+    for (const unsigned char *c = (const unsigned char *) key; *c != '\0'; c++)
+        result = (result ^ *c) * 1099511628211ULL;
+
+    result ^= result >> 33;
+    result *= 0xFF51AFD7ED558CCDULL;
+    result ^= result >> 33;
+
+    return result;
+}
\ No newline at end of file
@@ -41,7 +41,8 @@ static const struct sr_command commands[] = {
         .name = "krd",
         .on_init = sr_command_krdict_init,
         .on_cleanup = sr_command_krdict_cleanup,
-        .on_run = sr_command_krdict_run
+        .on_run = sr_command_krdict_run,
+        .on_idle = sr_command_krdict_idle
     },
     {
         .name = "msg",
@@ -124,6 +125,9 @@ void sr_bot_init(int argc, char *argv[]) {
 
 /* Discord 봇에 할당된 메모리를 해제한다. */
 void sr_bot_cleanup(void) {
+    // 작업 스레드에서 처리 중인 작업은 명령어의 캐시를 사용하므로, 작업 스레드를 먼저 종료한다.
+    sr_worker_cleanup();
+
     sr_release_commands(client);
 
     sr_core_cleanup();
@@ -203,6 +207,11 @@ static void on_idle(struct discord *client) {
     
     curlv_read_requests(curlv);
 
+    sr_worker_read_results();
+
+    for (int i = 0; i < sizeof(commands) / sizeof(*commands); i++)
+        if (commands[i].on_idle != NULL) commands[i].on_idle(client);
+
     // CPU 사용량 최적화
     cog_sleep_us(1L);
 }
@@ -301,6 +310,16 @@ static void on_interaction_create(
                     commands[i].on_run(client, event);
 
             break;
+
+        case DISCORD_INTERACTION_APPLICATION_COMMAND_AUTOCOMPLETE:
+            // 자동 완성 요청은 글자를 입력할 때마다 오므로, 기록하지 않는다.
+            context = event->data->name;
+
+            for (int i = 0; i < sizeof(commands) / sizeof(*commands); i++)
+                if (streq(context, commands[i].name))
+                    commands[i].on_run(client, event);
+
+            break;
     }
 }
 
@@ -313,13 +332,14 @@ static void sr_core_init(void) {
     sigar_open(&sigar);
 
     sr_config_init();
+    sr_worker_init(sr_config_get_worker_count());
     sr_input_reader_init();
 }
 
 /* Discord 봇의 추가 정보에 할당된 메모리를 해제한다. */
 static void sr_core_cleanup(void) {
     if (client == NULL) return;
-    
+
     sr_config_cleanup();
 
     curlv_cleanup(curlv);
@@ -0,0 +1,865 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <saerom.h>
+
+/* | `cache` 모듈 매크로 정의... | */
+
+#define INITIAL_BUCKET_COUNT  256
+
+#define SKETCH_DEPTH          4
+#define SKETCH_MIN_WIDTH      1024
+#define SKETCH_MAX_COUNT      15
+#define SKETCH_ENTRY_SIZE     256
+
+#define FILE_MAGIC            "SRCACHE2"
+#define FILE_MIN_CAPACITY     (1 << 20)
+
+#define RECORD_ALIGNMENT      8
+#define RECORD_LIVE           0x4C435253U
+#define RECORD_DEAD           0x44435253U
+
+/* | `cache` 모듈 자료형 정의... | */
+
+/* 캐시의 개별 항목을 나타내는 구조체. */
+struct sr_cache_entry {
+    struct sr_cache_entry *next;
+    struct sr_cache_entry *lru_prev;
+    struct sr_cache_entry *lru_next;
+    uint64_t hash;
+    uint64_t expiry;
+    size_t key_len;
+    size_t value_len;
+    size_t offset;
+    bool verified;
+    char data[];
+};
+
+/* 캐시 항목의 사용 빈도를 추정하는 Count-Min Sketch를 나타내는 구조체. */
+struct sr_cache_sketch {
+    unsigned char *counters;
+    size_t width;
+    size_t additions;
+    size_t sample_size;
+};
+
+/* 캐시 파일의 헤더를 나타내는 구조체. */
+struct sr_cache_file_header {
+    char magic[8];
+    uint64_t reserved;
+};
+
+/* 캐시 파일에 기록된 개별 항목을 나타내는 구조체. */
+struct sr_cache_record {
+    uint32_t state;
+    uint32_t key_len;
+    uint64_t value_len;
+    uint64_t hash;
+    uint64_t checksum;
+    uint64_t expiry;
+    char data[];
+};
+
+/* 캐시 항목이 기록되는 메모리 매핑 파일을 나타내는 구조체. */
+struct sr_cache_file {
+    char path[MAX_STRING_SIZE];
+    int fd;
+    char *map;
+    size_t capacity;
+    size_t tail;
+};
+
+/* 캐시를 나타내는 구조체. */
+struct sr_cache {
+    struct sr_cache_entry **buckets;
+    size_t bucket_count;
+    struct sr_cache_entry *lru_head;
+    struct sr_cache_entry *lru_tail;
+    size_t budget;
+    uint64_t ttl;
+    enum sr_cache_policy policy;
+    struct sr_cache_sketch sketch;
+    struct sr_cache_file file;
+    struct sr_cache_stats stats;
+    pthread_mutex_t lock;
+};
+
+/* | `cache` 모듈 함수... | */
+
+/* 주어진 키의 해시 값을 계산한다. */
+static uint64_t sr_cache_hash(const char *key, size_t len);
+
+/* 캐시 항목의 키를 반환한다. */
+static const char *sr_cache_entry_key(
+    const struct sr_cache *cache,
+    const struct sr_cache_entry *entry
+);
+
+/* 캐시 항목의 값을 반환한다. */
+static const char *sr_cache_entry_value(
+    const struct sr_cache *cache,
+    const struct sr_cache_entry *entry
+);
+
+/* 캐시에서 주어진 키에 해당하는 항목을 찾는다. */
+static struct sr_cache_entry **sr_cache_find(
+    struct sr_cache *cache,
+    const char *key,
+    size_t key_len,
+    uint64_t hash
+);
+
+/* 캐시의 LRU 목록 맨 앞에 주어진 항목을 추가한다. */
+static void sr_cache_insert(struct sr_cache *cache, struct sr_cache_entry *entry);
+
+/* 캐시에서 주어진 항목을 제거한다. */
+static void sr_cache_remove(struct sr_cache *cache, struct sr_cache_entry **slot);
+
+/* 캐시의 LRU 목록 맨 앞으로 주어진 항목을 옮긴다. */
+static void sr_cache_touch(struct sr_cache *cache, struct sr_cache_entry *entry);
+
+/* 캐시의 해시 테이블 크기를 두 배로 늘린다. */
+static void sr_cache_grow(struct sr_cache *cache);
+
+/* 캐시 항목의 사용 빈도를 1만큼 늘린다. */
+static void sr_cache_sketch_increment(struct sr_cache_sketch *sketch, uint64_t hash);
+
+/* 캐시 항목의 사용 빈도 추정치를 반환한다. */
+static int sr_cache_sketch_estimate(const struct sr_cache_sketch *sketch, uint64_t hash);
+
+/* 새로운 항목을 캐시에 추가할지 결정한다. */
+static bool sr_cache_admit(struct sr_cache *cache, uint64_t hash, size_t entry_size);
+
+/* 캐시 파일에 기록된 항목의 크기를 반환한다. */
+static size_t sr_cache_record_size(size_t key_len, size_t value_len);
+
+/* 캐시 파일을 열고, 파일에 기록된 항목들을 캐시에 추가한다. */
+static bool sr_cache_load(struct sr_cache *cache);
+
+/* 캐시 파일의 맨 뒤에 새로운 항목을 기록한다. */
+static bool sr_cache_append(
+    struct sr_cache *cache,
+    struct sr_cache_entry *entry,
+    const char *key,
+    const void *value
+);
+
+/* 캐시 파일에서 제거된 항목들을 정리한다. */
+static bool sr_cache_compact(struct sr_cache *cache);
+
+/* 캐시를 생성한다. */
+struct sr_cache *sr_cache_create(
+    size_t budget,
+    uint64_t ttl,
+    enum sr_cache_policy policy
+) {
+    struct sr_cache *result = calloc(1, sizeof(*result));
+
+    result->bucket_count = INITIAL_BUCKET_COUNT;
+    result->buckets = calloc(result->bucket_count, sizeof(*result->buckets));
+
+    result->budget = budget;
+    result->ttl = ttl;
+    result->policy = policy;
+
+    if (policy == SR_CACHE_POLICY_TINYLFU) {
+        size_t width = SKETCH_MIN_WIDTH;
+
+        // 메모리 예산으로 저장할 수 있는 항목 개수에 맞춰 크기를 정한다.
+        while (width < budget / SKETCH_ENTRY_SIZE) width <<= 1;
+
+        result->sketch.width = width;
+        result->sketch.sample_size = 10 * width;
+        result->sketch.counters = calloc(SKETCH_DEPTH * width, sizeof(unsigned char));
+    }
+
+    result->file.fd = -1;
+
+    result->stats.budget = budget;
+
+    pthread_mutex_init(&result->lock, NULL);
+
+    return result;
+}
+
+/* 주어진 경로의 파일에 항목들을 기록하는 캐시를 생성한다. */
+struct sr_cache *sr_cache_open(
+    const char *path,
+    size_t budget,
+    uint64_t ttl,
+    enum sr_cache_policy policy
+) {
+    struct sr_cache *result = sr_cache_create(budget, ttl, policy);
+
+    if (path == NULL || *path == '\0') return result;
+
+    strncpy(result->file.path, path, sizeof(result->file.path) - 1);
+
+    const uint64_t begin_time = cog_timestamp_ms();
+
+    // 캐시 파일을 사용할 수 없다면, 메모리에만 항목들을 저장한다.
+    if (!sr_cache_load(result)) {
+        log_warn("[SAEROM] Unable to map cache file \"%s\"", path);
+
+        *result->file.path = '\0';
+
+        return result;
+    }
+
+    log_info(
+        "[SAEROM] Loaded %zu cache entries from \"%s\" in %" PRIu64 "ms",
+        result->stats.count,
+        path,
+        cog_timestamp_ms() - begin_time
+    );
+
+    return result;
+}
+
+/* 캐시에 할당된 메모리를 해제한다. */
+void sr_cache_release(struct sr_cache *cache) {
+    if (cache == NULL) return;
+
+    struct sr_cache_entry *entry = cache->lru_head;
+
+    while (entry != NULL) {
+        struct sr_cache_entry *next = entry->lru_next;
+
+        free(entry);
+
+        entry = next;
+    }
+
+    if (cache->file.map != NULL) {
+        msync(cache->file.map, cache->file.tail, MS_SYNC);
+        munmap(cache->file.map, cache->file.capacity);
+    }
+
+    if (cache->file.fd >= 0) close(cache->file.fd);
+
+    pthread_mutex_destroy(&cache->lock);
+
+    free(cache->sketch.counters);
+    free(cache->buckets);
+    free(cache);
+}
+
+/* 캐시에서 주어진 키에 해당하는 값을 읽는다. */
+size_t sr_cache_get(
+    struct sr_cache *cache,
+    const char *key,
+    void *buffer,
+    size_t size
+) {
+    if (cache == NULL || key == NULL) return 0;
+
+    const size_t key_len = strlen(key);
+    const uint64_t hash = sr_cache_hash(key, key_len);
+
+    size_t result = 0;
+
+    pthread_mutex_lock(&cache->lock);
+
+    if (cache->policy == SR_CACHE_POLICY_TINYLFU)
+        sr_cache_sketch_increment(&cache->sketch, hash);
+
+    struct sr_cache_entry **slot = sr_cache_find(cache, key, key_len, hash);
+    struct sr_cache_entry *entry = *slot;
+
+    if (entry != NULL && entry->expiry <= cog_timestamp_ms()) {
+        sr_cache_remove(cache, slot);
+
+        cache->stats.expirations++;
+
+        entry = NULL;
+    }
+
+    // 캐시 파일에 기록된 항목은 처음 읽을 때 손상 여부를 확인한다.
+    if (entry != NULL && !entry->verified) {
+        const struct sr_cache_record *record = (const struct sr_cache_record *)
+            (cache->file.map + entry->offset);
+
+        if (sr_cache_hash(record->data, entry->key_len + 1 + entry->value_len)
+            != record->checksum) {
+            log_warn("[SAEROM] Discarding corrupted cache entry for \"%s\"", key);
+
+            sr_cache_remove(cache, slot);
+
+            entry = NULL;
+        } else {
+            entry->verified = true;
+        }
+    }
+
+    if (entry != NULL && entry->value_len <= size) {
+        memcpy(buffer, sr_cache_entry_value(cache, entry), entry->value_len);
+
+        sr_cache_touch(cache, entry);
+
+        result = entry->value_len;
+
+        cache->stats.hits++;
+    } else {
+        cache->stats.misses++;
+    }
+
+    pthread_mutex_unlock(&cache->lock);
+
+    return result;
+}
+
+/* 캐시에 주어진 키와 값을 저장한다. */
+void sr_cache_put(
+    struct sr_cache *cache,
+    const char *key,
+    const void *value,
+    size_t len
+) {
+    if (cache == NULL || key == NULL || value == NULL || len == 0) return;
+
+    const size_t key_len = strlen(key);
+    const size_t entry_size = sizeof(struct sr_cache_entry) + key_len + 1 + len;
+
+    // 메모리 예산보다 큰 항목은 저장하지 않는다.
+    if (entry_size > cache->budget) return;
+
+    const uint64_t hash = sr_cache_hash(key, key_len);
+
+    const bool persistent = (*cache->file.path != '\0');
+
+    // 캐시 파일을 사용한다면, 키와 값은 메모리가 아닌 파일에만 기록한다.
+    struct sr_cache_entry *entry = malloc(
+        persistent ? sizeof(*entry) : entry_size
+    );
+
+    entry->hash = hash;
+    entry->expiry = cog_timestamp_ms() + cache->ttl;
+    entry->key_len = key_len;
+    entry->value_len = len;
+    entry->offset = 0;
+    entry->verified = true;
+
+    if (!persistent) {
+        memcpy(entry->data, key, key_len + 1);
+        memcpy(entry->data + key_len + 1, value, len);
+    }
+
+    pthread_mutex_lock(&cache->lock);
+
+    struct sr_cache_entry **slot = sr_cache_find(cache, key, key_len, hash);
+
+    // 이미 캐시에 있는 항목의 값을 바꿀 때는, 새로운 값이 거절되어 기존 값까지 잃지 않도록 바로 바꾼다.
+    if (*slot != NULL) sr_cache_remove(cache, slot);
+    else if (cache->policy == SR_CACHE_POLICY_TINYLFU
+        && !sr_cache_admit(cache, hash, entry_size)) {
+        cache->stats.rejections++;
+
+        pthread_mutex_unlock(&cache->lock);
+
+        free(entry);
+
+        return;
+    }
+
+    // 메모리 예산을 초과하면, 가장 오래 사용되지 않은 항목부터 제거한다.
+    while (cache->lru_tail != NULL
+        && cache->stats.size + entry_size > cache->budget) {
+        struct sr_cache_entry *victim = cache->lru_tail;
+
+        sr_cache_remove(
+            cache,
+            sr_cache_find(
+                cache,
+                sr_cache_entry_key(cache, victim),
+                victim->key_len,
+                victim->hash
+            )
+        );
+
+        cache->stats.evictions++;
+    }
+
+    if (persistent && !sr_cache_append(cache, entry, key, value)) {
+        pthread_mutex_unlock(&cache->lock);
+
+        free(entry);
+
+        return;
+    }
+
+    sr_cache_insert(cache, entry);
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/* 캐시의 통계 정보를 반환한다. */
+void sr_cache_get_stats(struct sr_cache *cache, struct sr_cache_stats *stats) {
+    if (stats == NULL) return;
+
+    if (cache == NULL) {
+        memset(stats, 0, sizeof(*stats));
+
+        return;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+
+    *stats = cache->stats;
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/* 주어진 키의 해시 값을 계산한다. */
+static uint64_t sr_cache_hash(const char *key, size_t len) {
+    // FNV-1a
+    uint64_t result = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < len; i++) {
+        result ^= (unsigned char) key[i];
+        result *= 0x100000001b3ULL;
+    }
+
+    return result;
+}
+
+/* 캐시 항목의 키를 반환한다. */
+static const char *sr_cache_entry_key(
+    const struct sr_cache *cache,
+    const struct sr_cache_entry *entry
+) {
+    if (cache->file.map == NULL) return entry->data;
+
+    return ((const struct sr_cache_record *) (cache->file.map + entry->offset))->data;
+}
+
+/* 캐시 항목의 값을 반환한다. */
+static const char *sr_cache_entry_value(
+    const struct sr_cache *cache,
+    const struct sr_cache_entry *entry
+) {
+    return sr_cache_entry_key(cache, entry) + entry->key_len + 1;
+}
+
+/* 캐시에서 주어진 키에 해당하는 항목을 찾는다. */
+static struct sr_cache_entry **sr_cache_find(
+    struct sr_cache *cache,
+    const char *key,
+    size_t key_len,
+    uint64_t hash
+) {
+    struct sr_cache_entry **slot = &cache->buckets[hash & (cache->bucket_count - 1)];
+
+    while (*slot != NULL) {
+        if ((*slot)->hash == hash && (*slot)->key_len == key_len
+            && memcmp(sr_cache_entry_key(cache, *slot), key, key_len) == 0) break;
+
+        slot = &(*slot)->next;
+    }
+
+    return slot;
+}
+
+/* 캐시의 LRU 목록 맨 앞에 주어진 항목을 추가한다. */
+static void sr_cache_insert(struct sr_cache *cache, struct sr_cache_entry *entry) {
+    if (cache->stats.count >= cache->bucket_count) sr_cache_grow(cache);
+
+    size_t index = entry->hash & (cache->bucket_count - 1);
+
+    entry->next = cache->buckets[index];
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+
+    if (cache->lru_head != NULL) cache->lru_head->lru_prev = entry;
+    else cache->lru_tail = entry;
+
+    cache->buckets[index] = cache->lru_head = entry;
+
+    cache->stats.count++;
+    cache->stats.size += sizeof(*entry) + entry->key_len + 1 + entry->value_len;
+}
+
+/* 캐시에서 주어진 항목을 제거한다. */
+static void sr_cache_remove(struct sr_cache *cache, struct sr_cache_entry **slot) {
+    struct sr_cache_entry *entry = *slot;
+
+    *slot = entry->next;
+
+    if (entry->lru_prev != NULL) entry->lru_prev->lru_next = entry->lru_next;
+    else cache->lru_head = entry->lru_next;
+
+    if (entry->lru_next != NULL) entry->lru_next->lru_prev = entry->lru_prev;
+    else cache->lru_tail = entry->lru_prev;
+
+    // 캐시 파일에 기록된 항목은 다음 정리 작업 때까지 제거된 상태로 남는다.
+    if (cache->file.map != NULL)
+        ((struct sr_cache_record *) (cache->file.map + entry->offset))->state = RECORD_DEAD;
+
+    cache->stats.count--;
+    cache->stats.size -= sizeof(*entry) + entry->key_len + 1 + entry->value_len;
+
+    free(entry);
+}
+
+/* 캐시의 LRU 목록 맨 앞으로 주어진 항목을 옮긴다. */
+static void sr_cache_touch(struct sr_cache *cache, struct sr_cache_entry *entry) {
+    if (cache->lru_head == entry) return;
+
+    entry->lru_prev->lru_next = entry->lru_next;
+
+    if (entry->lru_next != NULL) entry->lru_next->lru_prev = entry->lru_prev;
+    else cache->lru_tail = entry->lru_prev;
+
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+
+    cache->lru_head->lru_prev = entry;
+    cache->lru_head = entry;
+}
+
+/* 캐시의 해시 테이블 크기를 두 배로 늘린다. */
+static void sr_cache_grow(struct sr_cache *cache) {
+    const size_t new_count = cache->bucket_count << 1;
+
+    struct sr_cache_entry **new_buckets = calloc(new_count, sizeof(*new_buckets));
+
+    if (new_buckets == NULL) return;
+
+    for (size_t i = 0; i < cache->bucket_count; i++) {
+        struct sr_cache_entry *entry = cache->buckets[i];
+
+        while (entry != NULL) {
+            struct sr_cache_entry *next = entry->next;
+
+            size_t index = entry->hash & (new_count - 1);
+
+            entry->next = new_buckets[index];
+            new_buckets[index] = entry;
+
+            entry = next;
+        }
+    }
+
+    free(cache->buckets);
+
+    cache->buckets = new_buckets;
+    cache->bucket_count = new_count;
+}
+
+/* 캐시 항목의 사용 빈도를 1만큼 늘린다. */
+static void sr_cache_sketch_increment(struct sr_cache_sketch *sketch, uint64_t hash) {
+    bool incremented = false;
+
+    for (int i = 0; i < SKETCH_DEPTH; i++) {
+        size_t index = (hash >> (16 * i)) & (sketch->width - 1);
+
+        unsigned char *counter = &sketch->counters[i * sketch->width + index];
+
+        if (*counter < SKETCH_MAX_COUNT) {
+            (*counter)++;
+
+            incremented = true;
+        }
+    }
+
+    // 일정 횟수마다 모든 빈도를 절반으로 줄여, 오래된 기록의 영향을 줄인다.
+    if (incremented && ++sketch->additions >= sketch->sample_size) {
+        for (size_t i = 0; i < SKETCH_DEPTH * sketch->width; i++)
+            sketch->counters[i] >>= 1;
+
+        sketch->additions >>= 1;
+    }
+}
+
+/* 캐시 항목의 사용 빈도 추정치를 반환한다. */
+static int sr_cache_sketch_estimate(const struct sr_cache_sketch *sketch, uint64_t hash) {
+    int result = SKETCH_MAX_COUNT;
+
+    for (int i = 0; i < SKETCH_DEPTH; i++) {
+        size_t index = (hash >> (16 * i)) & (sketch->width - 1);
+
+        int counter = sketch->counters[i * sketch->width + index];
+
+        if (result > counter) result = counter;
+    }
+
+    return result;
+}
+
+/* 새로운 항목을 캐시에 추가할지 결정한다. */
+static bool sr_cache_admit(struct sr_cache *cache, uint64_t hash, size_t entry_size) {
+    const int frequency = sr_cache_sketch_estimate(&cache->sketch, hash);
+
+    size_t size = cache->stats.size;
+
+    /*
+        새로운 항목을 추가하기 위해 제거해야 하는 모든 항목보다 사용 빈도가
+        높아야만 추가한다. (TinyLFU) 크기가 큰 항목일수록 더 많은 항목을
+        제거해야 하므로, 한 번만 사용된 긴 항목은 캐시에 들어오기 어렵다.
+    */
+
+    for (struct sr_cache_entry *victim = cache->lru_tail;
+        victim != NULL && size + entry_size > cache->budget;
+        victim = victim->lru_prev) {
+        if (sr_cache_sketch_estimate(&cache->sketch, victim->hash) >= frequency)
+            return false;
+
+        size -= sizeof(*victim) + victim->key_len + 1 + victim->value_len;
+    }
+
+    return true;
+}
+
+/* 캐시 파일에 기록된 항목의 크기를 반환한다. */
+static size_t sr_cache_record_size(size_t key_len, size_t value_len) {
+    const size_t result = sizeof(struct sr_cache_record) + key_len + 1 + value_len;
+
+    return (result + (RECORD_ALIGNMENT - 1)) & ~((size_t) RECORD_ALIGNMENT - 1);
+}
+
+/* 캐시 파일을 열고, 파일에 기록된 항목들을 캐시에 추가한다. */
+static bool sr_cache_load(struct sr_cache *cache) {
+    struct sr_cache_file *file = &cache->file;
+
+    file->fd = open(file->path, O_RDWR | O_CREAT, 0644);
+
+    if (file->fd < 0) return false;
+
+    struct stat st;
+
+    if (fstat(file->fd, &st) != 0) return false;
+
+    struct sr_cache_file_header header = { .magic = "" };
+
+    // 형식이 다른 파일이라면, 파일의 내용을 모두 지운다.
+    if (pread(file->fd, &header, sizeof(header), 0) != sizeof(header)
+        || memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0) {
+        if (ftruncate(file->fd, 0) != 0) return false;
+
+        memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+
+        if (pwrite(file->fd, &header, sizeof(header), 0) != sizeof(header))
+            return false;
+
+        st.st_size = 0;
+    }
+
+    // 메모리 예산의 두 배만큼 기록할 수 있도록, 파일의 크기를 정한다.
+    file->capacity = 2 * cache->budget;
+
+    if (file->capacity < FILE_MIN_CAPACITY) file->capacity = FILE_MIN_CAPACITY;
+    if (file->capacity < (size_t) st.st_size) file->capacity = st.st_size;
+
+    if (ftruncate(file->fd, file->capacity) != 0) return false;
+
+    file->map = mmap(
+        NULL,
+        file->capacity,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        file->fd,
+        0
+    );
+
+    if (file->map == MAP_FAILED) {
+        file->map = NULL;
+
+        return false;
+    }
+
+    const uint64_t now = cog_timestamp_ms();
+
+    size_t offset = sizeof(header);
+
+    /*
+        항목의 헤더만 읽고, 키와 값은 필요할 때 파일에서 바로 읽는다.
+        체크섬은 항목을 처음 읽을 때 확인한다.
+    */
+
+    while (offset + sizeof(struct sr_cache_record) <= file->capacity) {
+        struct sr_cache_record *record = (struct sr_cache_record *) (file->map + offset);
+
+        if (record->state != RECORD_LIVE && record->state != RECORD_DEAD) break;
+
+        const size_t record_size = sr_cache_record_size(record->key_len, record->value_len);
+
+        // 기록하는 도중에 중단된 항목이라면, 그 뒤의 내용은 무시한다.
+        if (record->value_len > file->capacity || record_size > file->capacity - offset)
+            break;
+
+        if (record->state == RECORD_LIVE && record->expiry <= now)
+            record->state = RECORD_DEAD;
+
+        if (record->state == RECORD_LIVE) {
+            struct sr_cache_entry **slot = sr_cache_find(
+                cache,
+                record->data,
+                record->key_len,
+                record->hash
+            );
+
+            // 같은 키에 대해서는 가장 나중에 기록된 항목만 사용한다.
+            if (*slot != NULL) sr_cache_remove(cache, slot);
+
+            struct sr_cache_entry *entry = malloc(sizeof(*entry));
+
+            entry->hash = record->hash;
+            entry->expiry = record->expiry;
+            entry->key_len = record->key_len;
+            entry->value_len = record->value_len;
+            entry->offset = offset;
+            entry->verified = false;
+
+            sr_cache_insert(cache, entry);
+        }
+
+        offset += record_size;
+    }
+
+    file->tail = offset;
+
+    // 메모리 예산이 줄어들었다면, 가장 오래된 항목부터 제거한다.
+    while (cache->lru_tail != NULL && cache->stats.size > cache->budget) {
+        struct sr_cache_entry *victim = cache->lru_tail;
+
+        sr_cache_remove(
+            cache,
+            sr_cache_find(
+                cache,
+                sr_cache_entry_key(cache, victim),
+                victim->key_len,
+                victim->hash
+            )
+        );
+    }
+
+    return true;
+}
+
+/* 캐시 파일의 맨 뒤에 새로운 항목을 기록한다. */
+static bool sr_cache_append(
+    struct sr_cache *cache,
+    struct sr_cache_entry *entry,
+    const char *key,
+    const void *value
+) {
+    struct sr_cache_file *file = &cache->file;
+
+    const size_t record_size = sr_cache_record_size(entry->key_len, entry->value_len);
+
+    if (file->tail + record_size > file->capacity
+        && (!sr_cache_compact(cache) || file->tail + record_size > file->capacity))
+        return false;
+
+    struct sr_cache_record *record = (struct sr_cache_record *) (file->map + file->tail);
+
+    record->key_len = entry->key_len;
+    record->value_len = entry->value_len;
+    record->hash = entry->hash;
+    record->expiry = entry->expiry;
+
+    memcpy(record->data, key, entry->key_len + 1);
+    memcpy(record->data + entry->key_len + 1, value, entry->value_len);
+
+    record->checksum = sr_cache_hash(
+        record->data,
+        entry->key_len + 1 + entry->value_len
+    );
+
+    // 항목의 상태는 마지막에 기록하여, 기록이 끝난 항목만 읽을 수 있도록 한다.
+    __atomic_store_n(&record->state, RECORD_LIVE, __ATOMIC_RELEASE);
+
+    entry->offset = file->tail;
+
+    file->tail += record_size;
+
+    return true;
+}
+
+/* 캐시 파일에서 제거된 항목들을 정리한다. */
+static bool sr_cache_compact(struct sr_cache *cache) {
+    struct sr_cache_file *file = &cache->file;
+
+    char path[MAX_STRING_SIZE + 4] = "";
+
+    snprintf(path, sizeof(path), "%s.tmp", file->path);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) return false;
+
+    if (ftruncate(fd, file->capacity) != 0) {
+        close(fd);
+        unlink(path);
+
+        return false;
+    }
+
+    char *map = mmap(NULL, file->capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (map == MAP_FAILED) {
+        close(fd);
+        unlink(path);
+
+        return false;
+    }
+
+    memcpy(map, file->map, sizeof(struct sr_cache_file_header));
+
+    size_t tail = sizeof(struct sr_cache_file_header);
+
+    // 다시 읽을 때 LRU 목록의 순서가 유지되도록, 오래된 항목부터 기록한다.
+    for (struct sr_cache_entry *entry = cache->lru_tail;
+        entry != NULL;
+        entry = entry->lru_prev) {
+        const size_t record_size = sr_cache_record_size(entry->key_len, entry->value_len);
+
+        memcpy(map + tail, file->map + entry->offset, record_size);
+
+        entry->offset = tail;
+
+        tail += record_size;
+    }
+
+    msync(map, tail, MS_SYNC);
+
+    if (rename(path, file->path) != 0) {
+        log_warn("[SAEROM] Unable to replace cache file \"%s\"", file->path);
+    }
+
+    munmap(file->map, file->capacity);
+    close(file->fd);
+
+    file->fd = fd;
+    file->map = map;
+    file->tail = tail;
+
+    log_info(
+        "[SAEROM] Compacted cache file \"%s\" to %zu bytes",
+        file->path,
+        file->tail
+    );
+
+    return true;
+}
\ No newline at end of file
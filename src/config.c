@@ -19,6 +19,26 @@
 
 #include <saerom.h>
 
+/* | `config` 모듈 매크로 정의... | */
+
+#define DEFAULT_KRDICT_CACHE_BUDGET  16
+#define DEFAULT_KRDICT_CACHE_TTL     86400
+
+#define DEFAULT_KRDICT_NEGATIVE_TTL  600
+
+#define DEFAULT_KRDICT_DICT_MAX_AGE  2592000
+#define DEFAULT_KRDICT_DICT_FP_RATE  0.01
+
+#define DEFAULT_KRDICT_FANOUT_DEADLINE  1.5
+
+#define DEFAULT_KRDICT_PREFETCH_RATE    30
+#define DEFAULT_KRDICT_PREFETCH_QUOTA   50000
+
+#define DEFAULT_PAPAGO_CACHE_BUDGET  4
+#define DEFAULT_PAPAGO_CACHE_TTL     604800
+
+#define DEFAULT_WORKER_COUNT         2
+
 /* | `config` 모듈 자료형 정의... | */
 
 /* Discord 봇의 환경 설정을 나타내는 구조체. */
@@ -32,11 +52,42 @@ struct sr_config {
     struct {
         char krd_api_key[MAX_STRING_SIZE];
         char urms_api_key[MAX_STRING_SIZE];
+        struct {
+            char path[MAX_STRING_SIZE];
+            size_t budget;
+            uint64_t ttl;
+            uint64_t negative_ttl;
+        } cache;
+        struct {
+            char path[MAX_STRING_SIZE];
+            uint64_t max_age;
+            double false_positive_rate;
+        } dict;
+        struct {
+            char path[MAX_STRING_SIZE];
+        } autocomplete;
+        struct {
+            bool enabled;
+            uint64_t deadline;
+        } fanout;
+        struct {
+            bool examples;
+            int rate;
+            int quota;
+        } prefetch;
     } krdict;
     struct {
         char client_id[MAX_STRING_SIZE];
         char client_secret[MAX_STRING_SIZE];
+        struct {
+            char path[MAX_STRING_SIZE];
+            size_t budget;
+            uint64_t ttl;
+        } cache;
     } papago;
+    struct {
+        int count;
+    } worker;
     pthread_mutex_t lock;
 };
 
@@ -47,6 +98,52 @@ static struct sr_config config;
 
 /* | `config` 모듈 함수... | */
 
+/* 환경 설정 파일에서 주어진 경로에 해당하는 정수 값을 읽는다. */
+static long sr_config_read_integer(
+    struct discord *client,
+    char *path[], 
+    unsigned depth,
+    long default_value
+) {
+    struct ccord_szbuf_readonly field = discord_config_get_field(client, path, depth);
+
+    char buffer[MAX_STRING_SIZE] = "";
+
+    if (field.start == NULL || field.size == 0 || field.size >= sizeof(buffer))
+        return default_value;
+
+    strncpy(buffer, field.start, field.size);
+
+    char *end = NULL;
+
+    long result = strtol(buffer, &end, 10);
+
+    return (end != buffer) ? result : default_value;
+}
+
+/* 환경 설정 파일에서 주어진 경로에 해당하는 실수 값을 읽는다. */
+static double sr_config_read_number(
+    struct discord *client,
+    char *path[], 
+    unsigned depth,
+    double default_value
+) {
+    struct ccord_szbuf_readonly field = discord_config_get_field(client, path, depth);
+
+    char buffer[MAX_STRING_SIZE] = "";
+
+    if (field.start == NULL || field.size == 0 || field.size >= sizeof(buffer))
+        return default_value;
+
+    strncpy(buffer, field.start, field.size);
+
+    char *end = NULL;
+
+    double result = strtod(buffer, &end);
+
+    return (end != buffer) ? result : default_value;
+}
+
 /* (Discord 봇의 환경 설정을 초기화한다.) */
 static void _sr_config_init(
     struct discord *client, 
@@ -132,6 +229,131 @@ void sr_config_init(void) {
         pthread_mutex_unlock(&config.lock);
     }
 
+    {
+        pthread_mutex_lock(&config.lock);
+
+        config.krdict.cache.budget = sr_config_read_integer(
+            client, 
+            (char *[4]) { "saerom", "krdict", "cache", "budget" }, 
+            4,
+            DEFAULT_KRDICT_CACHE_BUDGET
+        ) * 1024 * 1024;
+
+        config.krdict.cache.ttl = sr_config_read_integer(
+            client, 
+            (char *[4]) { "saerom", "krdict", "cache", "ttl" }, 
+            4,
+            DEFAULT_KRDICT_CACHE_TTL
+        ) * 1000;
+
+        config.krdict.cache.negative_ttl = sr_config_read_integer(
+            client, 
+            (char *[4]) { "saerom", "krdict", "cache", "negative_ttl" }, 
+            4,
+            DEFAULT_KRDICT_NEGATIVE_TTL
+        ) * 1000;
+
+        config.papago.cache.budget = sr_config_read_integer(
+            client, 
+            (char *[4]) { "saerom", "papago", "cache", "budget" }, 
+            4,
+            DEFAULT_PAPAGO_CACHE_BUDGET
+        ) * 1024 * 1024;
+
+        config.papago.cache.ttl = sr_config_read_integer(
+            client, 
+            (char *[4]) { "saerom", "papago", "cache", "ttl" }, 
+            4,
+            DEFAULT_PAPAGO_CACHE_TTL
+        ) * 1000;
+
+        field = discord_config_get_field(
+            client, (char *[4]) { "saerom", "krdict", "cache", "path" }, 4
+        );
+
+        if (field.start != NULL && field.size < sizeof(config.krdict.cache.path))
+            strncpy(config.krdict.cache.path, field.start, field.size);
+
+        field = discord_config_get_field(
+            client, (char *[4]) { "saerom", "krdict", "dict", "path" }, 4
+        );
+
+        if (field.start != NULL && field.size < sizeof(config.krdict.dict.path))
+            strncpy(config.krdict.dict.path, field.start, field.size);
+
+        config.krdict.dict.max_age = sr_config_read_integer(
+            client, 
+            (char *[4]) { "saerom", "krdict", "dict", "max_age" }, 
+            4,
+            DEFAULT_KRDICT_DICT_MAX_AGE
+        ) * 1000;
+
+        config.krdict.dict.false_positive_rate = sr_config_read_number(
+            client, 
+            (char *[4]) { "saerom", "krdict", "dict", "false_positive_rate" }, 
+            4,
+            DEFAULT_KRDICT_DICT_FP_RATE
+        );
+
+        field = discord_config_get_field(
+            client, (char *[4]) { "saerom", "krdict", "autocomplete", "path" }, 4
+        );
+
+        if (field.start != NULL && field.size < sizeof(config.krdict.autocomplete.path))
+            strncpy(config.krdict.autocomplete.path, field.start, field.size);
+
+        field = discord_config_get_field(
+            client, (char *[4]) { "saerom", "krdict", "fanout", "enable" }, 4
+        );
+
+        config.krdict.fanout.enabled = (field.start != NULL && field.size > 0
+            && strncmp("true", field.start, field.size) == 0);
+
+        config.krdict.fanout.deadline = sr_config_read_number(
+            client, 
+            (char *[4]) { "saerom", "krdict", "fanout", "deadline" }, 
+            4,
+            DEFAULT_KRDICT_FANOUT_DEADLINE
+        ) * 1000;
+
+        field = discord_config_get_field(
+            client, (char *[4]) { "saerom", "krdict", "prefetch", "examples" }, 4
+        );
+
+        config.krdict.prefetch.examples = (field.start != NULL && field.size > 0
+            && strncmp("true", field.start, field.size) == 0);
+
+        config.krdict.prefetch.rate = sr_config_read_integer(
+            client, 
+            (char *[4]) { "saerom", "krdict", "prefetch", "rate" }, 
+            4,
+            DEFAULT_KRDICT_PREFETCH_RATE
+        );
+
+        config.krdict.prefetch.quota = sr_config_read_integer(
+            client, 
+            (char *[4]) { "saerom", "krdict", "prefetch", "quota" }, 
+            4,
+            DEFAULT_KRDICT_PREFETCH_QUOTA
+        );
+
+        field = discord_config_get_field(
+            client, (char *[4]) { "saerom", "papago", "cache", "path" }, 4
+        );
+
+        if (field.start != NULL && field.size < sizeof(config.papago.cache.path))
+            strncpy(config.papago.cache.path, field.start, field.size);
+
+        config.worker.count = sr_config_read_integer(
+            client, 
+            (char *[3]) { "saerom", "worker", "threads" }, 
+            3,
+            DEFAULT_WORKER_COUNT
+        );
+
+        pthread_mutex_unlock(&config.lock);
+    }
+
     {
         pthread_mutex_lock(&config.lock);
 
@@ -193,6 +415,91 @@ const char *sr_config_get_papago_client_secret(void) {
     return config.papago.client_secret;
 }
 
+/* Discord 봇의 `/krd` 명령어 캐시의 메모리 예산 (단위: 바이트)을 반환한다. */
+size_t sr_config_get_krdict_cache_budget(void) {
+    return config.krdict.cache.budget;
+}
+
+/* Discord 봇의 `/krd` 명령어 캐시의 유효 기간 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_krdict_cache_ttl(void) {
+    return config.krdict.cache.ttl;
+}
+
+/* Discord 봇의 `/krd` 명령어 캐시 파일의 경로를 반환한다. */
+const char *sr_config_get_krdict_cache_path(void) {
+    return config.krdict.cache.path;
+}
+
+/* Discord 봇의 `/krd` 명령어 검색 결과가 없는 검색어 캐시의 유효 기간 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_krdict_cache_negative_ttl(void) {
+    return config.krdict.cache.negative_ttl;
+}
+
+/* Discord 봇의 `/krd` 명령어 사전 데이터 파일의 경로를 반환한다. */
+const char *sr_config_get_krdict_dict_path(void) {
+    return config.krdict.dict.path;
+}
+
+/* Discord 봇의 `/krd` 명령어 사전 데이터 파일의 유효 기간 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_krdict_dict_max_age(void) {
+    return config.krdict.dict.max_age;
+}
+
+/* Discord 봇의 `/krd` 명령어 표제어 블룸 필터의 오탐률을 반환한다. */
+double sr_config_get_krdict_dict_false_positive_rate(void) {
+    return config.krdict.dict.false_positive_rate;
+}
+
+/* Discord 봇의 `/krd` 명령어 검색 기록 파일의 경로를 반환한다. */
+const char *sr_config_get_krdict_autocomplete_path(void) {
+    return config.krdict.autocomplete.path;
+}
+
+/* Discord 봇의 `/krd` 명령어가 두 오픈 API에 동시에 요청을 보내는지 확인한다. */
+bool sr_config_get_krdict_fanout_enabled(void) {
+    return config.krdict.fanout.enabled;
+}
+
+/* Discord 봇의 `/krd` 명령어가 두 오픈 API의 검색 결과를 합치는 기한 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_krdict_fanout_deadline(void) {
+    return config.krdict.fanout.deadline;
+}
+
+/* Discord 봇의 `/krd` 명령어가 표제어 검색 뒤에 같은 검색어의 용례를 미리 가져오는지 확인한다. */
+bool sr_config_get_krdict_prefetch_examples(void) {
+    return config.krdict.prefetch.examples;
+}
+
+/* Discord 봇의 `/krd` 명령어가 검색 결과를 미리 가져오는 요청의 1분당 최대 개수를 반환한다. */
+int sr_config_get_krdict_prefetch_rate(void) {
+    return config.krdict.prefetch.rate;
+}
+
+/* Discord 봇의 `/krd` 명령어가 사용하는 오픈 API 키마다 하루에 보낼 수 있는 요청의 개수를 반환한다. */
+int sr_config_get_krdict_prefetch_quota(void) {
+    return config.krdict.prefetch.quota;
+}
+
+/* Discord 봇의 `/ppg` 명령어 캐시의 메모리 예산 (단위: 바이트)을 반환한다. */
+size_t sr_config_get_papago_cache_budget(void) {
+    return config.papago.cache.budget;
+}
+
+/* Discord 봇의 `/ppg` 명령어 캐시의 유효 기간 (단위: 밀리초)을 반환한다. */
+uint64_t sr_config_get_papago_cache_ttl(void) {
+    return config.papago.cache.ttl;
+}
+
+/* Discord 봇의 `/ppg` 명령어 캐시 파일의 경로를 반환한다. */
+const char *sr_config_get_papago_cache_path(void) {
+    return config.papago.cache.path;
+}
+
+/* Discord 봇의 작업 스레드 개수를 반환한다. */
+int sr_config_get_worker_count(void) {
+    return config.worker.count;
+}
+
 /* Discord 봇의 모듈 플래그 데이터를 설정한다. */
 void sr_config_set_module_flags(u64bitmask flags) {
     pthread_mutex_lock(&config.lock);
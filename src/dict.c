@@ -0,0 +1,2083 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <yxml.h>
+
+#include <saerom.h>
+
+/* | `dict` 모듈 매크로 정의... | */
+
+#define DICT_MAGIC              "SRDICT4"
+
+#define IMPORT_BUFFER_SIZE      65536
+#define IMPORT_STACK_SIZE       4096
+#define IMPORT_MAX_DEPTH        32
+
+#define INITIAL_INTERN_COUNT    65536
+#define INITIAL_TRIE_COUNT      65536
+
+#define TRIE_FREE               -1
+
+#define MAX_SEGMENT_COUNT       16
+#define REFRESH_INTERVAL        60000
+
+#define REQUEST_URL_KRDICT_VIEW "https://krdict.korean.go.kr/dicSearch/SearchView?ParaWordNo="
+
+/* | `dict` 모듈 자료형 정의... | */
+
+/* 사전 데이터 파일의 헤더를 나타내는 구조체. */
+struct sr_dict_header {
+    char magic[8];
+    uint64_t timestamp;
+    uint64_t sequence;
+    uint32_t word_count;
+    uint32_t record_count;
+    uint64_t words_offset;
+    uint64_t records_offset;
+    uint64_t trie_offset;
+    uint64_t trie_size;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+};
+
+/* 사전 데이터 파일의 표제어를 나타내는 구조체. */
+struct sr_dict_word {
+    uint32_t word;
+    uint32_t first_record;
+    uint32_t record_count;
+    uint32_t entry_count;
+};
+
+/* 사전 데이터 파일의 개별 뜻풀이를 나타내는 구조체. */
+struct sr_dict_record {
+    uint32_t word;
+    uint32_t origin;
+    uint32_t pos;
+    uint32_t link;
+    uint32_t definition;
+    uint32_t trans_word;
+    uint32_t trans_dfn;
+    uint32_t entry;
+    int32_t order;
+    int32_t level;
+};
+
+/* 
+    표제어로 표제어 목록의 위치를 찾는 이중 배열 트라이 (double-array trie)의
+    노드를 나타내는 구조체.
+*/
+struct sr_dict_trie_node {
+    int32_t base;
+    int32_t check;
+};
+
+/* 메모리에 매핑된 사전 데이터 파일 (기본 파일 또는 변경분 파일)을 나타내는 구조체. */
+struct sr_dict_segment {
+    char path[MAX_STRING_SIZE + 24];
+    int fd;
+    char *map;
+    size_t size;
+    const struct sr_dict_header *header;
+    const struct sr_dict_word *words;
+    const struct sr_dict_record *records;
+    const struct sr_dict_trie_node *nodes;
+    const char *strings;
+    int references;
+};
+
+/* 검색에 사용되는 사전 데이터 파일의 목록을 나타내는 구조체. */
+struct sr_dict_snapshot {
+    struct sr_dict_segment *segments[MAX_SEGMENT_COUNT];
+    int count;
+    int references;
+};
+
+/* 사전 데이터를 나타내는 구조체. */
+struct sr_dict {
+    char path[MAX_STRING_SIZE];
+    struct sr_dict_snapshot *snapshot;
+    pthread_mutex_t lock;
+    uint64_t refresh_time;
+    bool merging;
+    bool closed;
+};
+
+/* 여러 사전 데이터 파일에서 찾은 뜻풀이를 나타내는 구조체. */
+struct sr_dict_match {
+    const struct sr_dict_segment *segment;
+    const struct sr_dict_record *record;
+    const char *link;
+};
+
+/* 사전 데이터 파일로 변환 중인 XML 요소의 종류를 나타내는 열거형. */
+enum sr_dict_element {
+    SR_DICT_ELEMENT_OTHER,
+    SR_DICT_ELEMENT_ENTRY,
+    SR_DICT_ELEMENT_LEMMA,
+    SR_DICT_ELEMENT_SENSE,
+    SR_DICT_ELEMENT_EQUIVALENT,
+    SR_DICT_ELEMENT_FEAT
+};
+
+/* 사전 데이터 파일로 변환 중인 데이터를 나타내는 구조체. */
+struct sr_dict_importer {
+    char *strings;
+    size_t strings_len;
+    size_t strings_capacity;
+    uint32_t *interned;
+    size_t interned_count;
+    size_t interned_capacity;
+    struct sr_dict_record *records;
+    size_t record_count;
+    size_t record_capacity;
+    uint32_t entry_count;
+    uint64_t timestamp;
+    uint64_t sequence;
+};
+
+/* 사전 데이터 파일로 변환 중인 표제어 항목을 나타내는 구조체. */
+struct sr_dict_import_entry {
+    char id[MAX_STRING_SIZE];
+    char word[MAX_STRING_SIZE];
+    char origin[MAX_STRING_SIZE];
+    char pos[MAX_STRING_SIZE];
+    char definition[2 * MAX_STRING_SIZE];
+    char trans_word[MAX_STRING_SIZE];
+    char trans_dfn[2 * MAX_STRING_SIZE];
+    char language[MAX_STRING_SIZE];
+    char lemma[MAX_STRING_SIZE];
+    char equivalent[2 * MAX_STRING_SIZE];
+    char att[MAX_STRING_SIZE];
+    char val[2 * MAX_STRING_SIZE];
+    size_t first_record;
+    int order;
+    int level;
+};
+
+/* 사전 데이터 파일 변환 작업을 나타내는 구조체. */
+struct sr_dict_import_job {
+    const char *path;
+    struct sr_dict_importer importer;
+    uint64_t elapsed;
+    bool result;
+};
+
+/* 사전 데이터 파일 변환 작업의 진행 상황을 나타내는 구조체. */
+struct sr_dict_import_progress {
+    uint64_t total_bytes;
+    uint64_t read_bytes;
+    int percent;
+    int completed;
+    int count;
+};
+
+/* 이중 배열 트라이를 만드는 데 필요한 데이터를 나타내는 구조체. */
+struct sr_dict_trie_builder {
+    const struct sr_dict_word *words;
+    const char *strings;
+    struct sr_dict_trie_node *nodes;
+    size_t count;
+    size_t capacity;
+    size_t first_free;
+};
+
+/* 사전 데이터 파일 병합 작업을 나타내는 구조체. */
+struct sr_dict_merge_job {
+    struct sr_dict *dict;
+    struct sr_dict_snapshot *snapshot;
+    struct sr_dict_segment *result;
+};
+
+/* | `dict` 모듈 상수 및 변수... | */
+
+/* 사전 데이터 파일 변환 작업의 진행 상황. */
+static struct sr_dict_import_progress progress;
+
+/* | `dict` 모듈 함수... | */
+
+/* 사전 데이터 파일의 문자열을 반환한다. */
+static const char *sr_dict_get_string(
+    const struct sr_dict_segment *segment,
+    uint32_t offset
+);
+
+/* 주어진 문자열을 사전 데이터 파일의 문자열 목록에 추가한다. */
+static uint32_t sr_dict_intern(struct sr_dict_importer *importer, const char *str);
+
+/* 주어진 XML 파일의 표제어 항목들을 읽는다. */
+static bool sr_dict_import_file(struct sr_dict_importer *importer, const char *path);
+
+/* 사전 데이터 파일 변환 작업의 진행 상황을 갱신한다. */
+static void sr_dict_import_report(size_t len);
+
+/* 작업 스레드에서 주어진 XML 파일을 변환할 때 호출되는 함수. */
+static void on_import_work(void *data);
+
+/* 두 뜻풀이의 순서 (표제어, 항목, 뜻풀이 순)를 비교한다. */
+static int sr_dict_compare_records(
+    const char *lhs_strings,
+    const struct sr_dict_record *lhs,
+    const char *rhs_strings,
+    const struct sr_dict_record *rhs
+);
+
+/* 뜻풀이 목록을 정렬한다. */
+static void sr_dict_sort_records(
+    struct sr_dict_record *records,
+    size_t count,
+    const char *strings
+);
+
+/* 정렬된 뜻풀이 목록들을 하나로 합친다. */
+static void sr_dict_import_merge(
+    const struct sr_dict_importer *sources,
+    int count,
+    struct sr_dict_importer *importer
+);
+
+/* 속성 값을 고정 크기 필드에 잘라서 복사한다. */
+static void sr_dict_import_copy(char *dst, size_t size, const char *src);
+
+/* `<feat>` 요소의 속성을 처리한다. */
+static void sr_dict_import_feat(
+    struct sr_dict_import_entry *entry,
+    enum sr_dict_element parent
+);
+
+/* 뜻풀이를 사전 데이터 파일의 뜻풀이 목록에 추가한다. */
+static void sr_dict_import_sense(
+    struct sr_dict_importer *importer,
+    struct sr_dict_import_entry *entry
+);
+
+/* 사전 데이터 파일을 주어진 경로에 기록한다. */
+static bool sr_dict_import_write(
+    struct sr_dict_importer *importer,
+    const char *path
+);
+
+/* 주어진 XML 파일들을 변환하여, 주어진 번호의 사전 데이터 파일을 만든다. */
+static bool sr_dict_build(
+    const char *inputs[],
+    int count,
+    const char *output,
+    int threads,
+    uint64_t sequence
+);
+
+/* 주어진 번호의 변경분 파일의 경로를 만든다. */
+static void sr_dict_get_segment_path(
+    const char *path,
+    uint64_t sequence,
+    char *buffer,
+    size_t size
+);
+
+/* 사전 데이터 파일의 번호를 읽는다. */
+static bool sr_dict_read_sequence(const char *path, uint64_t *sequence);
+
+/* 사전 데이터 파일 하나를 메모리에 매핑한다. */
+static struct sr_dict_segment *sr_dict_segment_open(const char *path);
+
+/* 사전 데이터 파일 하나의 참조 횟수를 줄이고, 필요하다면 메모리를 해제한다. */
+static void sr_dict_segment_release(struct sr_dict_segment *segment);
+
+/* 사전 데이터 파일 하나에서 주어진 표제어를 찾는다. */
+static const struct sr_dict_word *sr_dict_segment_find(
+    const struct sr_dict_segment *segment,
+    const char *word
+);
+
+/* 이중 배열 트라이에서 주어진 노드의 자식 노드를 찾는다. */
+static int32_t sr_dict_trie_get_child(
+    const struct sr_dict_segment *segment,
+    int32_t node,
+    int label
+);
+
+/* 이중 배열 트라이에서 주어진 범위의 글자로 이어지는 첫 번째 자식 노드를 찾는다. */
+static int32_t sr_dict_trie_next_child(
+    const struct sr_dict_segment *segment,
+    int32_t node,
+    int first,
+    int last
+);
+
+/* 이중 배열 트라이에서 주어진 노드 아래의 첫 번째 (또는 마지막) 표제어를 찾는다. */
+static uint32_t sr_dict_trie_get_edge(
+    const struct sr_dict_segment *segment,
+    int32_t node,
+    bool last
+);
+
+/* 이중 배열 트라이에서 주어진 문자열보다 작지 않은 첫 번째 표제어를 찾는다. */
+static uint32_t sr_dict_trie_lower_bound(
+    const struct sr_dict_segment *segment,
+    const char *key
+);
+
+/* 여러 사전 데이터 파일에서 찾은 표제어 범위를 하나로 합친다. */
+static int sr_dict_collect_words(
+    const struct sr_dict_snapshot *snapshot,
+    uint32_t *first,
+    const uint32_t *last,
+    const char **words,
+    int count
+);
+
+/* 정렬된 표제어 목록으로 이중 배열 트라이를 만든다. */
+static void sr_dict_trie_build(
+    struct sr_dict_trie_builder *builder,
+    int32_t node,
+    uint32_t first,
+    uint32_t last,
+    size_t depth
+);
+
+/* 이중 배열 트라이에 주어진 자식 노드들을 모두 넣을 수 있는 위치를 찾는다. */
+static int32_t sr_dict_trie_find_base(
+    struct sr_dict_trie_builder *builder,
+    int32_t node,
+    const unsigned char *labels,
+    int count
+);
+
+/* 검색에 사용되는 사전 데이터 파일의 목록을 교체한다. */
+static void sr_dict_swap(struct sr_dict *dict, struct sr_dict_snapshot *snapshot);
+
+/* 변경분 파일들을 기본 파일에 병합하는 작업을 시작한다. */
+static void sr_dict_merge(struct sr_dict *dict);
+
+/* 작업 스레드에서 변경분 파일들을 병합할 때 호출되는 함수. */
+static void on_merge_work(void *data);
+
+/* 변경분 파일들의 병합이 끝났을 때 호출되는 함수. */
+static void on_merge_done(void *data);
+
+/* 사전 데이터를 연다. */
+struct sr_dict *sr_dict_open(const char *path) {
+    if (path == NULL || *path == '\0') return NULL;
+
+    struct sr_dict_segment *segment = sr_dict_segment_open(path);
+
+    if (segment == NULL) return NULL;
+
+    struct sr_dict *result = calloc(1, sizeof(*result));
+
+    strncpy(result->path, path, sizeof(result->path) - 1);
+
+    pthread_mutex_init(&result->lock, NULL);
+
+    result->snapshot = calloc(1, sizeof(*result->snapshot));
+
+    result->snapshot->segments[result->snapshot->count++] = segment;
+    result->snapshot->references = 1;
+
+    // 마지막으로 병합된 이후에 추가된 변경분 파일들을 함께 읽는다.
+    sr_dict_refresh(result);
+
+    return result;
+}
+
+/* 사전 데이터를 닫는다. */
+void sr_dict_close(struct sr_dict *dict) {
+    if (dict == NULL) return;
+
+    struct sr_dict_snapshot *snapshot = NULL;
+
+    {
+        pthread_mutex_lock(&dict->lock);
+
+        snapshot = dict->snapshot;
+
+        dict->snapshot = NULL;
+        dict->closed = true;
+
+        pthread_mutex_unlock(&dict->lock);
+    }
+
+    sr_dict_release(snapshot);
+
+    // 병합 작업이 끝나지 않았다면, 작업이 끝난 뒤에 메모리를 해제한다.
+    if (dict->merging) return;
+
+    pthread_mutex_destroy(&dict->lock);
+
+    free(dict);
+}
+
+/* 새로 추가된 변경분 파일들을 읽고, 필요하다면 백그라운드에서 병합한다. */
+void sr_dict_refresh(struct sr_dict *dict) {
+    if (dict == NULL || dict->closed) return;
+
+    const uint64_t now = cog_timestamp_ms();
+
+    if (dict->refresh_time > 0 && now - dict->refresh_time < REFRESH_INTERVAL) return;
+
+    dict->refresh_time = now;
+
+    struct sr_dict_snapshot *current = sr_dict_acquire(dict);
+
+    if (current == NULL) return;
+
+    struct sr_dict_snapshot *next = NULL;
+
+    uint64_t sequence = current->segments[current->count - 1]->header->sequence;
+
+    // 변경분 파일은 마지막으로 읽은 파일의 다음 번호부터 차례대로 읽는다.
+    for (int i = current->count; i < MAX_SEGMENT_COUNT; i++) {
+        char segment_path[MAX_STRING_SIZE + 24] = "";
+
+        sr_dict_get_segment_path(dict->path, ++sequence, segment_path, sizeof(segment_path));
+
+        struct sr_dict_segment *segment = sr_dict_segment_open(segment_path);
+
+        if (segment == NULL) break;
+
+        if (segment->header->sequence != sequence) {
+            log_warn("[SAEROM] Ignoring out-of-order dictionary update \"%s\"", segment_path);
+
+            sr_dict_segment_release(segment);
+
+            break;
+        }
+
+        if (next == NULL) {
+            next = calloc(1, sizeof(*next));
+
+            for (int j = 0; j < current->count; j++) {
+                __atomic_add_fetch(&current->segments[j]->references, 1, __ATOMIC_RELAXED);
+
+                next->segments[next->count++] = current->segments[j];
+            }
+
+            next->references = 1;
+        }
+
+        next->segments[next->count++] = segment;
+    }
+
+    if (next != NULL) {
+        log_info(
+            "[SAEROM] Applied %d dictionary update(s) to \"%s\"",
+            next->count - current->count,
+            dict->path
+        );
+
+        sr_dict_swap(dict, next);
+    }
+
+    sr_dict_release(current);
+
+    sr_dict_merge(dict);
+}
+
+/* 검색에 사용할 사전 데이터 파일의 목록을 가져온다. */
+struct sr_dict_snapshot *sr_dict_acquire(struct sr_dict *dict) {
+    if (dict == NULL) return NULL;
+
+    struct sr_dict_snapshot *result = NULL;
+
+    {
+        pthread_mutex_lock(&dict->lock);
+
+        result = dict->snapshot;
+
+        if (result != NULL) __atomic_add_fetch(&result->references, 1, __ATOMIC_RELAXED);
+
+        pthread_mutex_unlock(&dict->lock);
+    }
+
+    return result;
+}
+
+/* 검색에 사용한 사전 데이터 파일의 목록을 반환한다. */
+void sr_dict_release(struct sr_dict_snapshot *snapshot) {
+    if (snapshot == NULL) return;
+
+    if (__atomic_sub_fetch(&snapshot->references, 1, __ATOMIC_ACQ_REL) > 0) return;
+
+    for (int i = 0; i < snapshot->count; i++)
+        sr_dict_segment_release(snapshot->segments[i]);
+
+    free(snapshot);
+}
+
+/* 사전 데이터가 마지막으로 갱신된 시각 (단위: 밀리초)을 반환한다. */
+uint64_t sr_dict_get_timestamp(const struct sr_dict_snapshot *snapshot) {
+    if (snapshot == NULL) return 0;
+
+    uint64_t result = 0;
+
+    for (int i = 0; i < snapshot->count; i++)
+        if (result < snapshot->segments[i]->header->timestamp)
+            result = snapshot->segments[i]->header->timestamp;
+
+    return result;
+}
+
+/* 사전 데이터의 표제어 개수 (변경분 파일의 표제어 포함)를 반환한다. */
+size_t sr_dict_get_word_count(const struct sr_dict_snapshot *snapshot) {
+    if (snapshot == NULL) return 0;
+
+    size_t result = 0;
+
+    for (int i = 0; i < snapshot->count; i++)
+        result += snapshot->segments[i]->header->word_count;
+
+    return result;
+}
+
+/* 사전 데이터에서 주어진 표제어의 뜻풀이를 찾는다. */
+int sr_dict_find(
+    const struct sr_dict_snapshot *snapshot,
+    const char *word,
+    struct sr_dict_sense *senses,
+    int count,
+    int *total
+) {
+    if (total != NULL) *total = 0;
+
+    if (snapshot == NULL || word == NULL || senses == NULL) return 0;
+
+    const struct sr_dict_word *entries[MAX_SEGMENT_COUNT] = { NULL };
+
+    size_t capacity = 0;
+
+    for (int i = 0; i < snapshot->count; i++) {
+        entries[i] = sr_dict_segment_find(snapshot->segments[i], word);
+
+        if (entries[i] != NULL) capacity += entries[i]->record_count;
+    }
+
+    if (capacity == 0) return 0;
+
+    struct sr_dict_match *matches = malloc(capacity * sizeof(*matches));
+
+    size_t match_count = 0;
+
+    for (int i = 0; i < snapshot->count; i++) {
+        if (entries[i] == NULL) continue;
+
+        const struct sr_dict_segment *segment = snapshot->segments[i];
+
+        for (uint32_t j = 0; j < entries[i]->record_count; j++) {
+            const struct sr_dict_record *record =
+                &segment->records[entries[i]->first_record + j];
+
+            const char *link = sr_dict_get_string(segment, record->link);
+
+            bool replaced = false;
+
+            // 나중에 추가된 변경분 파일에 같은 항목이 있다면, 그 항목을 대신 사용한다.
+            for (int k = i + 1; k < snapshot->count && !replaced; k++) {
+                if (entries[k] == NULL) continue;
+
+                for (uint32_t l = 0; l < entries[k]->record_count && !replaced; l++) {
+                    const struct sr_dict_record *other =
+                        &snapshot->segments[k]->records[entries[k]->first_record + l];
+
+                    replaced = streq(sr_dict_get_string(snapshot->segments[k], other->link), link);
+                }
+            }
+
+            if (replaced) continue;
+
+            // 항목 (링크의 길이, 링크 순), 뜻풀이 순으로 정렬된 상태를 유지한다.
+            const size_t link_len = strlen(link);
+
+            size_t index = match_count;
+
+            for (; index > 0; index--) {
+                const struct sr_dict_match *prev = &matches[index - 1];
+
+                const size_t prev_len = strlen(prev->link);
+
+                int result = (prev_len != link_len)
+                    ? ((prev_len < link_len) ? -1 : 1)
+                    : strcmp(prev->link, link);
+
+                if (result == 0)
+                    result = (prev->record->order > record->order)
+                        - (prev->record->order < record->order);
+
+                if (result <= 0) break;
+
+                matches[index] = matches[index - 1];
+            }
+
+            matches[index] = (struct sr_dict_match) {
+                .segment = segment,
+                .record = record,
+                .link = link
+            };
+
+            match_count++;
+        }
+    }
+
+    int len = 0, entry_count = 0;
+
+    for (size_t i = 0; i < match_count; i++) {
+        const struct sr_dict_segment *segment = matches[i].segment;
+        const struct sr_dict_record *record = matches[i].record;
+
+        if (i == 0 || !streq(matches[i - 1].link, matches[i].link)) entry_count++;
+
+        if (len >= count) continue;
+
+        senses[len++] = (struct sr_dict_sense) {
+            .word = sr_dict_get_string(segment, record->word),
+            .origin = sr_dict_get_string(segment, record->origin),
+            .pos = sr_dict_get_string(segment, record->pos),
+            .link = matches[i].link,
+            .definition = sr_dict_get_string(segment, record->definition),
+            .trans_word = sr_dict_get_string(segment, record->trans_word),
+            .trans_dfn = sr_dict_get_string(segment, record->trans_dfn),
+            .order = record->order,
+            .level = record->level
+        };
+    }
+
+    free(matches);
+
+    if (total != NULL) *total = entry_count;
+
+    return len;
+}
+
+/* 사전 데이터에서 주어진 문자열로 시작하는 표제어들을 바이트 순서로 찾는다. */
+int sr_dict_find_prefix(
+    const struct sr_dict_snapshot *snapshot,
+    const char *prefix,
+    const char **words,
+    int count
+) {
+    if (snapshot == NULL || prefix == NULL || words == NULL) return 0;
+
+    uint32_t first[MAX_SEGMENT_COUNT] = { 0 }, last[MAX_SEGMENT_COUNT] = { 0 };
+
+    for (int i = 0; i < snapshot->count; i++) {
+        const struct sr_dict_segment *segment = snapshot->segments[i];
+
+        int32_t node = 0;
+
+        for (const char *c = prefix; *c != '\0' && node >= 0; c++)
+            node = sr_dict_trie_get_child(segment, node, (unsigned char) *c);
+
+        if (node < 0) continue;
+
+        // 같은 접두사를 가진 표제어들은 표제어 목록에서 연속된 위치에 있다.
+        first[i] = sr_dict_trie_get_edge(segment, node, false);
+        last[i] = sr_dict_trie_get_edge(segment, node, true);
+
+        if (last[i] < segment->header->word_count) last[i]++;
+        else first[i] = last[i] = 0;
+    }
+
+    return sr_dict_collect_words(snapshot, first, last, words, count);
+}
+
+/* 사전 데이터에서 주어진 범위 (`first` 이상, `last` 미만)의 표제어들을 바이트 순서로 찾는다. */
+int sr_dict_find_range(
+    const struct sr_dict_snapshot *snapshot,
+    const char *first,
+    const char *last,
+    const char **words,
+    int count
+) {
+    if (snapshot == NULL || words == NULL) return 0;
+
+    uint32_t lower[MAX_SEGMENT_COUNT] = { 0 }, upper[MAX_SEGMENT_COUNT] = { 0 };
+
+    for (int i = 0; i < snapshot->count; i++) {
+        const struct sr_dict_segment *segment = snapshot->segments[i];
+
+        lower[i] = (first != NULL) ? sr_dict_trie_lower_bound(segment, first) : 0;
+
+        upper[i] = (last != NULL)
+            ? sr_dict_trie_lower_bound(segment, last)
+            : segment->header->word_count;
+    }
+
+    return sr_dict_collect_words(snapshot, lower, upper, words, count);
+}
+
+/* 국립국어원 사전 데이터 (LMF 형식의 XML 파일)를 사전 데이터 파일로 변환한다. */
+bool sr_dict_import(
+    const char *inputs[],
+    int count,
+    const char *output,
+    int threads
+) {
+    return sr_dict_build(inputs, count, output, threads, 0);
+}
+
+/* 국립국어원 사전 데이터의 변경분을 사전 데이터 파일의 새로운 변경분 파일로 변환한다. */
+bool sr_dict_update(
+    const char *inputs[],
+    int count,
+    const char *path,
+    int threads
+) {
+    if (inputs == NULL || count <= 0 || path == NULL) return false;
+
+    uint64_t sequence = 0, last_sequence = 0;
+
+    // 기본 파일이 없다면, 변경분을 기본 파일로 사용한다.
+    if (!sr_dict_read_sequence(path, &sequence)) {
+        log_info("[SAEROM] No dictionary at \"%s\", importing a new one", path);
+
+        return sr_dict_import(inputs, count, path, threads);
+    }
+
+    char segment_path[MAX_STRING_SIZE + 24] = "";
+
+    // 실행 중인 Discord 봇이 변경분 파일들을 병합하는 중일 수 있으므로,
+    // 기본 파일의 번호가 바뀌지 않을 때까지 다시 확인한다.
+    do {
+        last_sequence = sequence;
+
+        for (;;) {
+            sr_dict_get_segment_path(path, sequence + 1, segment_path, sizeof(segment_path));
+
+            if (access(segment_path, F_OK) != 0) break;
+
+            sequence++;
+        }
+
+        uint64_t base_sequence = 0;
+
+        if (sr_dict_read_sequence(path, &base_sequence) && base_sequence > sequence)
+            sequence = base_sequence;
+    } while (sequence != last_sequence);
+
+    sr_dict_get_segment_path(path, ++sequence, segment_path, sizeof(segment_path));
+
+    return sr_dict_build(inputs, count, segment_path, threads, sequence);
+}
+
+/* 사전 데이터 파일의 문자열을 반환한다. */
+static const char *sr_dict_get_string(
+    const struct sr_dict_segment *segment,
+    uint32_t offset
+) {
+    return (offset < segment->header->strings_size) ? segment->strings + offset : "";
+}
+
+/* 주어진 문자열을 사전 데이터 파일의 문자열 목록에 추가한다. */
+static uint32_t sr_dict_intern(struct sr_dict_importer *importer, const char *str) {
+    const size_t len = strlen(str);
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char) str[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    // 같은 문자열 (품사, 원어 등)은 한 번만 저장한다.
+    if (2 * (importer->interned_count + 1) > importer->interned_capacity) {
+        size_t new_capacity = (importer->interned_capacity > 0)
+            ? importer->interned_capacity << 1
+            : INITIAL_INTERN_COUNT;
+
+        uint32_t *new_interned = malloc(new_capacity * sizeof(*new_interned));
+
+        memset(new_interned, 0xff, new_capacity * sizeof(*new_interned));
+
+        for (size_t i = 0; i < importer->interned_capacity; i++) {
+            uint32_t offset = importer->interned[i];
+
+            if (offset == UINT32_MAX) continue;
+
+            const char *s = importer->strings + offset;
+
+            uint64_t h = 0xcbf29ce484222325ULL;
+
+            for (; *s != '\0'; s++) {
+                h ^= (unsigned char) *s;
+                h *= 0x100000001b3ULL;
+            }
+
+            size_t index = h & (new_capacity - 1);
+
+            while (new_interned[index] != UINT32_MAX)
+                index = (index + 1) & (new_capacity - 1);
+
+            new_interned[index] = offset;
+        }
+
+        free(importer->interned);
+
+        importer->interned = new_interned;
+        importer->interned_capacity = new_capacity;
+    }
+
+    size_t index = hash & (importer->interned_capacity - 1);
+
+    while (importer->interned[index] != UINT32_MAX) {
+        uint32_t offset = importer->interned[index];
+
+        if (strcmp(importer->strings + offset, str) == 0) return offset;
+
+        index = (index + 1) & (importer->interned_capacity - 1);
+    }
+
+    if (importer->strings_len + len + 1 > importer->strings_capacity) {
+        size_t new_capacity = (importer->strings_capacity > 0)
+            ? importer->strings_capacity << 1
+            : IMPORT_BUFFER_SIZE;
+
+        while (importer->strings_len + len + 1 > new_capacity) new_capacity <<= 1;
+
+        importer->strings = realloc(importer->strings, new_capacity);
+        importer->strings_capacity = new_capacity;
+    }
+
+    const uint32_t result = importer->strings_len;
+
+    memcpy(importer->strings + result, str, len + 1);
+
+    importer->strings_len += len + 1;
+
+    importer->interned[index] = result;
+    importer->interned_count++;
+
+    return result;
+}
+
+/* 주어진 XML 파일의 표제어 항목들을 읽는다. */
+static bool sr_dict_import_file(struct sr_dict_importer *importer, const char *path) {
+    FILE *fp = fopen(path, "rb");
+
+    if (fp == NULL) return false;
+
+    yxml_t *parser = malloc(sizeof(*parser) + IMPORT_STACK_SIZE);
+
+    yxml_init(parser, parser + 1, IMPORT_STACK_SIZE);
+
+    struct sr_dict_import_entry *entry = calloc(1, sizeof(*entry));
+
+    enum sr_dict_element stack[IMPORT_MAX_DEPTH] = { SR_DICT_ELEMENT_OTHER };
+
+    char buffer[IMPORT_BUFFER_SIZE];
+
+    char *value = NULL;
+
+    size_t value_len = 0, value_size = 0;
+
+    int depth = 0;
+
+    bool result = true;
+
+    for (;;) {
+        size_t len = fread(buffer, 1, sizeof(buffer), fp);
+
+        if (len == 0) break;
+
+        sr_dict_import_report(len);
+
+        for (size_t i = 0; i < len && result; i++) {
+            yxml_ret_t token = yxml_parse(parser, buffer[i]);
+
+            if (token < 0) {
+                log_error(
+                    "[SAEROM] Malformed XML at line %u in \"%s\"",
+                    parser->line,
+                    path
+                );
+
+                result = false;
+
+                break;
+            }
+
+            switch (token) {
+                case YXML_ELEMSTART: {
+                    enum sr_dict_element element = SR_DICT_ELEMENT_OTHER;
+
+                    if (streq(parser->elem, "LexicalEntry")) {
+                        element = SR_DICT_ELEMENT_ENTRY;
+
+                        memset(entry, 0, sizeof(*entry));
+
+                        entry->first_record = importer->record_count;
+                    } else if (streq(parser->elem, "Lemma")) {
+                        element = SR_DICT_ELEMENT_LEMMA;
+                    } else if (streq(parser->elem, "Sense")) {
+                        element = SR_DICT_ELEMENT_SENSE;
+
+                        *entry->definition = *entry->trans_word = *entry->trans_dfn = '\0';
+                    } else if (streq(parser->elem, "Equivalent")) {
+                        element = SR_DICT_ELEMENT_EQUIVALENT;
+
+                        *entry->language = *entry->lemma = *entry->equivalent = '\0';
+                    } else if (streq(parser->elem, "feat")) {
+                        element = SR_DICT_ELEMENT_FEAT;
+
+                        *entry->att = *entry->val = '\0';
+                    }
+
+                    if (depth < IMPORT_MAX_DEPTH) stack[depth] = element;
+
+                    depth++;
+
+                    break;
+                }
+
+                case YXML_ATTRSTART:
+                    value_len = 0;
+
+                    break;
+
+                case YXML_ATTRVAL: {
+                    size_t data_len = strlen(parser->data);
+
+                    if (value_len + data_len + 1 > value_size) {
+                        value_size = (value_size > 0) ? value_size << 1 : MAX_STRING_SIZE;
+
+                        value = realloc(value, value_size);
+                    }
+
+                    memcpy(value + value_len, parser->data, data_len);
+
+                    value_len += data_len;
+
+                    break;
+                }
+
+                case YXML_ATTREND: {
+                    if (depth <= 0 || depth > IMPORT_MAX_DEPTH) break;
+
+                    if (value == NULL) break;
+
+                    value[value_len] = '\0';
+
+                    const enum sr_dict_element element = stack[depth - 1];
+
+                    if (element == SR_DICT_ELEMENT_FEAT) {
+                        if (streq(parser->attr, "att"))
+                            strncpy(entry->att, value, sizeof(entry->att) - 1);
+                        else if (streq(parser->attr, "val"))
+                            strncpy(entry->val, value, sizeof(entry->val) - 1);
+                    } else if (element == SR_DICT_ELEMENT_ENTRY) {
+                        // `<LexicalEntry att="id" val="...">`
+                        if (streq(parser->attr, "val"))
+                            strncpy(entry->id, value, sizeof(entry->id) - 1);
+                    }
+
+                    break;
+                }
+
+                case YXML_ELEMEND: {
+                    depth--;
+
+                    if (depth < 0 || depth >= IMPORT_MAX_DEPTH) break;
+
+                    const enum sr_dict_element element = stack[depth];
+
+                    const enum sr_dict_element parent = (depth > 0)
+                        ? stack[depth - 1]
+                        : SR_DICT_ELEMENT_OTHER;
+
+                    if (element == SR_DICT_ELEMENT_FEAT) {
+                        sr_dict_import_feat(entry, parent);
+                    } else if (element == SR_DICT_ELEMENT_EQUIVALENT) {
+                        // 영어 대역어만 사용한다.
+                        if (streq(entry->language, "영어") && *entry->trans_word == '\0') {
+                            strcpy(entry->trans_word, entry->lemma);
+                            strcpy(entry->trans_dfn, entry->equivalent);
+                        }
+                    } else if (element == SR_DICT_ELEMENT_SENSE) {
+                        sr_dict_import_sense(importer, entry);
+                    } else if (element == SR_DICT_ELEMENT_ENTRY) {
+                        if (importer->record_count > entry->first_record)
+                            importer->entry_count++;
+                    }
+
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        if (!result) break;
+    }
+
+    if (ferror(fp)) result = false;
+
+    free(value);
+    free(entry);
+    free(parser);
+
+    fclose(fp);
+
+    return result;
+}
+
+/* 속성 값을 고정 크기 필드에 잘라서 복사한다. */
+static void sr_dict_import_copy(char *dst, size_t size, const char *src) {
+    size_t len = strnlen(src, size - 1);
+
+    memcpy(dst, src, len);
+
+    dst[len] = '\0';
+}
+
+/* `<feat>` 요소의 속성을 처리한다. */
+static void sr_dict_import_feat(
+    struct sr_dict_import_entry *entry,
+    enum sr_dict_element parent
+) {
+    const char *att = entry->att, *val = entry->val;
+
+    // 원어는 `<LexicalEntry>` 또는 `<OriginalLanguageInfo>` 등의 하위 요소에 있다.
+    if ((streq(att, "originalLanguage") || streq(att, "origin"))
+        && *entry->origin == '\0') {
+        sr_dict_import_copy(entry->origin, sizeof(entry->origin), val);
+
+        return;
+    }
+
+    switch (parent) {
+        case SR_DICT_ELEMENT_ENTRY:
+            if (streq(att, "partOfSpeech"))
+                sr_dict_import_copy(entry->pos, sizeof(entry->pos), val);
+            else if (streq(att, "vocabularyLevel"))
+                entry->level = streq(val, "초급") ? SR_DICT_LEVEL_BEGINNER
+                    : streq(val, "중급") ? SR_DICT_LEVEL_INTERMEDIATE
+                    : streq(val, "고급") ? SR_DICT_LEVEL_ADVANCED
+                    : SR_DICT_LEVEL_NONE;
+
+            break;
+
+        case SR_DICT_ELEMENT_LEMMA:
+            if (streq(att, "writtenForm") && *entry->word == '\0')
+                sr_dict_import_copy(entry->word, sizeof(entry->word), val);
+
+            break;
+
+        case SR_DICT_ELEMENT_SENSE:
+            if (streq(att, "definition"))
+                sr_dict_import_copy(entry->definition, sizeof(entry->definition), val);
+
+            break;
+
+        case SR_DICT_ELEMENT_EQUIVALENT:
+            if (streq(att, "language"))
+                sr_dict_import_copy(entry->language, sizeof(entry->language), val);
+            else if (streq(att, "lemma"))
+                sr_dict_import_copy(entry->lemma, sizeof(entry->lemma), val);
+            else if (streq(att, "definition"))
+                sr_dict_import_copy(entry->equivalent, sizeof(entry->equivalent), val);
+
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* 뜻풀이를 사전 데이터 파일의 뜻풀이 목록에 추가한다. */
+static void sr_dict_import_sense(
+    struct sr_dict_importer *importer,
+    struct sr_dict_import_entry *entry
+) {
+    if (*entry->word == '\0') return;
+
+    if (importer->record_count >= importer->record_capacity) {
+        importer->record_capacity = (importer->record_capacity > 0)
+            ? importer->record_capacity << 1
+            : IMPORT_BUFFER_SIZE;
+
+        importer->records = realloc(
+            importer->records,
+            importer->record_capacity * sizeof(*importer->records)
+        );
+    }
+
+    char link[2 * MAX_STRING_SIZE] = "";
+
+    if (*entry->id != '\0')
+        snprintf(link, sizeof(link), "%s%s", REQUEST_URL_KRDICT_VIEW, entry->id);
+
+    importer->records[importer->record_count++] = (struct sr_dict_record) {
+        .word = sr_dict_intern(importer, entry->word),
+        .origin = sr_dict_intern(importer, entry->origin),
+        .pos = sr_dict_intern(importer, entry->pos),
+        .link = sr_dict_intern(importer, link),
+        .definition = sr_dict_intern(importer, entry->definition),
+        .trans_word = sr_dict_intern(importer, entry->trans_word),
+        .trans_dfn = sr_dict_intern(importer, entry->trans_dfn),
+        .entry = importer->entry_count,
+        .order = ++entry->order,
+        .level = entry->level
+    };
+}
+
+/* 사전 데이터 파일 변환 작업의 진행 상황을 갱신한다. */
+static void sr_dict_import_report(size_t len) {
+    const uint64_t read_bytes = __atomic_add_fetch(
+        &progress.read_bytes, 
+        len, 
+        __ATOMIC_RELAXED
+    );
+
+    if (progress.total_bytes == 0) return;
+
+    const int percent = (100 * read_bytes) / progress.total_bytes;
+
+    int last_percent = __atomic_load_n(&progress.percent, __ATOMIC_RELAXED);
+
+    // 10% 단위로 진행 상황을 출력한다.
+    if (percent / 10 > last_percent / 10
+        && __atomic_compare_exchange_n(
+            &progress.percent, 
+            &last_percent, 
+            percent, 
+            false, 
+            __ATOMIC_RELAXED, 
+            __ATOMIC_RELAXED
+        )) {
+        log_info(
+            "[SAEROM] Importing... %d%% (%" PRIu64 "/%" PRIu64 " bytes)",
+            percent,
+            read_bytes,
+            progress.total_bytes
+        );
+    }
+}
+
+/* 작업 스레드에서 주어진 XML 파일을 변환할 때 호출되는 함수. */
+static void on_import_work(void *data) {
+    struct sr_dict_import_job *job = data;
+
+    const uint64_t begin_time = cog_timestamp_ms();
+
+    sr_dict_intern(&job->importer, "");
+
+    job->result = sr_dict_import_file(&job->importer, job->path);
+
+    if (job->result) {
+        sr_dict_sort_records(
+            job->importer.records, 
+            job->importer.record_count, 
+            job->importer.strings
+        );
+    }
+
+    job->elapsed = cog_timestamp_ms() - begin_time;
+
+    const int completed = __atomic_add_fetch(&progress.completed, 1, __ATOMIC_RELAXED);
+
+    if (job->result) {
+        log_info(
+            "[SAEROM] [%d/%d] Parsed %zu senses from \"%s\" in %" PRIu64 "ms",
+            completed,
+            progress.count,
+            job->importer.record_count,
+            job->path,
+            job->elapsed
+        );
+    } else {
+        log_error(
+            "[SAEROM] [%d/%d] Failed to import \"%s\"", 
+            completed, 
+            progress.count, 
+            job->path
+        );
+    }
+}
+
+/* 두 뜻풀이의 순서 (표제어, 항목, 뜻풀이 순)를 비교한다. */
+static int sr_dict_compare_records(
+    const char *lhs_strings,
+    const struct sr_dict_record *lhs,
+    const char *rhs_strings,
+    const struct sr_dict_record *rhs
+) {
+    int result = strcmp(lhs_strings + lhs->word, rhs_strings + rhs->word);
+
+    if (result != 0) return result;
+
+    // 항목의 링크에 포함된 번호는 짧을수록 앞선다.
+    const char *lhs_link = lhs_strings + lhs->link;
+    const char *rhs_link = rhs_strings + rhs->link;
+
+    const size_t lhs_len = strlen(lhs_link), rhs_len = strlen(rhs_link);
+
+    if (lhs_len != rhs_len) return (lhs_len < rhs_len) ? -1 : 1;
+
+    result = strcmp(lhs_link, rhs_link);
+
+    if (result != 0) return result;
+
+    return (lhs->order > rhs->order) - (lhs->order < rhs->order);
+}
+
+/* 뜻풀이 목록을 정렬한다. */
+static void sr_dict_sort_records(
+    struct sr_dict_record *records,
+    size_t count,
+    const char *strings
+) {
+    if (count < 2) return;
+
+    struct sr_dict_record *temp = malloc(count * sizeof(*temp));
+
+    // 같은 뜻풀이의 순서가 유지되도록, 병합 정렬을 사용한다.
+    for (size_t width = 1; width < count; width <<= 1) {
+        for (size_t i = 0; i < count; i += 2 * width) {
+            const size_t mid = (i + width < count) ? i + width : count;
+            const size_t end = (i + 2 * width < count) ? i + 2 * width : count;
+
+            size_t left = i, right = mid, index = i;
+
+            while (left < mid && right < end) {
+                if (sr_dict_compare_records(
+                    strings, &records[right], strings, &records[left]
+                ) < 0) temp[index++] = records[right++];
+                else temp[index++] = records[left++];
+            }
+
+            while (left < mid) temp[index++] = records[left++];
+            while (right < end) temp[index++] = records[right++];
+        }
+
+        memcpy(records, temp, count * sizeof(*temp));
+    }
+
+    free(temp);
+}
+
+/* 정렬된 뜻풀이 목록들을 하나로 합친다. */
+static void sr_dict_import_merge(
+    const struct sr_dict_importer *sources,
+    int count,
+    struct sr_dict_importer *importer
+) {
+    size_t *heads = calloc(count, sizeof(*heads));
+
+    size_t total = 0;
+
+    for (int i = 0; i < count; i++)
+        total += sources[i].record_count;
+
+    importer->records = malloc((total + 1) * sizeof(*importer->records));
+    importer->record_capacity = total + 1;
+
+    const struct sr_dict_record *entry = NULL, *last = NULL;
+
+    const char *entry_strings = NULL, *last_strings = NULL;
+
+    int owner = -1;
+
+    for (;;) {
+        int next = -1;
+
+        // 순서가 같다면, 먼저 주어진 파일의 뜻풀이를 먼저 꺼낸다.
+        for (int i = 0; i < count; i++) {
+            if (heads[i] >= sources[i].record_count) continue;
+
+            if (next < 0 || sr_dict_compare_records(
+                sources[i].strings,
+                &sources[i].records[heads[i]],
+                sources[next].strings,
+                &sources[next].records[heads[next]]
+            ) < 0) next = i;
+        }
+
+        if (next < 0) break;
+
+        const struct sr_dict_record *record = &sources[next].records[heads[next]];
+
+        const char *strings = sources[next].strings;
+
+        const bool same_entry = (entry != NULL)
+            && strcmp(entry_strings + entry->word, strings + record->word) == 0
+            && strcmp(entry_strings + entry->link, strings + record->link) == 0;
+
+        if (!same_entry) {
+            // 같은 항목이 여러 파일에 있다면, 나중에 주어진 파일의 항목만 사용한다.
+            for (int i = 0; i < count; i++) {
+                if (heads[i] >= sources[i].record_count) continue;
+
+                const struct sr_dict_record *head = &sources[i].records[heads[i]];
+
+                if (strcmp(sources[i].strings + head->word, strings + record->word) == 0
+                    && strcmp(sources[i].strings + head->link, strings + record->link) == 0)
+                    owner = i;
+            }
+
+            importer->entry_count++;
+
+            entry = record, entry_strings = strings;
+            last = NULL, last_strings = NULL;
+        }
+
+        heads[next]++;
+
+        if (next != owner) continue;
+
+        const bool duplicate = (last != NULL)
+            && sr_dict_compare_records(last_strings, last, strings, record) == 0;
+
+        struct sr_dict_record merged = {
+            .word = sr_dict_intern(importer, strings + record->word),
+            .origin = sr_dict_intern(importer, strings + record->origin),
+            .pos = sr_dict_intern(importer, strings + record->pos),
+            .link = sr_dict_intern(importer, strings + record->link),
+            .definition = sr_dict_intern(importer, strings + record->definition),
+            .trans_word = sr_dict_intern(importer, strings + record->trans_word),
+            .trans_dfn = sr_dict_intern(importer, strings + record->trans_dfn),
+            .entry = importer->entry_count,
+            .order = record->order,
+            .level = record->level
+        };
+
+        // 같은 파일에 같은 뜻풀이가 여러 번 나오면, 마지막 뜻풀이를 사용한다.
+        if (duplicate) importer->records[importer->record_count - 1] = merged;
+        else importer->records[importer->record_count++] = merged;
+
+        last = record;
+        last_strings = strings;
+    }
+
+    free(heads);
+}
+
+/* 사전 데이터 파일을 주어진 경로에 기록한다. */
+static bool sr_dict_import_write(
+    struct sr_dict_importer *importer,
+    const char *path
+) {
+    struct sr_dict_word *words = malloc(
+        (importer->record_count + 1) * sizeof(*words)
+    );
+
+    uint32_t word_count = 0;
+
+    for (size_t i = 0; i < importer->record_count; i++) {
+        const struct sr_dict_record *record = &importer->records[i];
+
+        struct sr_dict_word *word = (word_count > 0) ? &words[word_count - 1] : NULL;
+
+        if (word == NULL || word->word != record->word) {
+            words[word_count++] = (struct sr_dict_word) {
+                .word = record->word,
+                .first_record = i,
+                .record_count = 1,
+                .entry_count = 1
+            };
+
+            continue;
+        }
+
+        if (record->entry != importer->records[i - 1].entry) word->entry_count++;
+
+        word->record_count++;
+    }
+
+    struct sr_dict_trie_builder builder = {
+        .words = words,
+        .strings = importer->strings,
+        .nodes = malloc(INITIAL_TRIE_COUNT * sizeof(*builder.nodes)),
+        .count = 1,
+        .capacity = INITIAL_TRIE_COUNT,
+        .first_free = 1
+    };
+
+    for (size_t i = 0; i < builder.capacity; i++)
+        builder.nodes[i] = (struct sr_dict_trie_node) { 0, TRIE_FREE };
+
+    // 0번째 노드는 트라이의 루트 노드이다.
+    builder.nodes[0].check = 0;
+
+    if (word_count > 0) sr_dict_trie_build(&builder, 0, 0, word_count, 0);
+
+    struct sr_dict_header header = {
+        .magic = DICT_MAGIC,
+        .timestamp = (importer->timestamp > 0) ? importer->timestamp : cog_timestamp_ms(),
+        .sequence = importer->sequence,
+        .word_count = word_count,
+        .record_count = importer->record_count
+    };
+
+    header.words_offset = sizeof(header);
+    header.records_offset = header.words_offset + word_count * sizeof(*words);
+    header.trie_offset = header.records_offset
+        + importer->record_count * sizeof(*importer->records);
+    header.trie_size = builder.count;
+    header.strings_offset = header.trie_offset + builder.count * sizeof(*builder.nodes);
+    header.strings_size = importer->strings_len;
+
+    char temp_path[MAX_STRING_SIZE + 32] = "";
+
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE *fp = fopen(temp_path, "wb");
+
+    bool result = (fp != NULL);
+
+    if (result) {
+        result = fwrite(&header, sizeof(header), 1, fp) == 1
+            && fwrite(words, sizeof(*words), word_count, fp) == word_count
+            && fwrite(
+                importer->records,
+                sizeof(*importer->records),
+                importer->record_count,
+                fp
+            ) == importer->record_count
+            && fwrite(builder.nodes, sizeof(*builder.nodes), builder.count, fp)
+                == builder.count
+            && fwrite(importer->strings, 1, importer->strings_len, fp)
+                == importer->strings_len;
+
+        result = (fclose(fp) == 0) && result;
+    }
+
+    // 기존의 사전 데이터 파일은 변환이 끝난 뒤에 한 번에 교체한다.
+    if (result) result = (rename(temp_path, path) == 0);
+    else remove(temp_path);
+
+    if (result) {
+        log_info(
+            "[SAEROM] Wrote %u headwords (%zu senses, %zu bytes of text, "
+            "%zu bytes of index) to \"%s\"",
+            word_count,
+            importer->record_count,
+            importer->strings_len,
+            builder.count * sizeof(*builder.nodes),
+            path
+        );
+    } else {
+        log_error("[SAEROM] Failed to write \"%s\"", path);
+    }
+
+    free(builder.nodes);
+    free(words);
+
+    return result;
+}
+
+/* 주어진 XML 파일들을 변환하여, 주어진 번호의 사전 데이터 파일을 만든다. */
+static bool sr_dict_build(
+    const char *inputs[],
+    int count,
+    const char *output,
+    int threads,
+    uint64_t sequence
+) {
+    if (inputs == NULL || count <= 0 || output == NULL) return false;
+
+    struct sr_dict_import_job *jobs = calloc(count, sizeof(*jobs));
+
+    progress = (struct sr_dict_import_progress) { .count = count };
+
+    for (int i = 0; i < count; i++) {
+        struct stat st;
+
+        if (stat(inputs[i], &st) == 0) progress.total_bytes += st.st_size;
+
+        jobs[i].path = inputs[i];
+    }
+
+    const uint64_t begin_time = cog_timestamp_ms();
+
+    // 각 파일을 작업 스레드에서 따로 읽고, 정렬된 뜻풀이 목록을 만든다.
+    sr_worker_init(threads);
+
+    for (int i = 0; i < count; i++)
+        sr_worker_push(on_import_work, NULL, &jobs[i]);
+
+    // 모든 작업이 끝날 때까지 기다린다.
+    sr_worker_cleanup();
+
+    bool result = true;
+
+    for (int i = 0; i < count; i++)
+        if (!jobs[i].result) result = false;
+
+    struct sr_dict_importer importer = { .sequence = sequence };
+
+    // 빈 문자열은 항상 0번째 위치에 저장한다.
+    sr_dict_intern(&importer, "");
+
+    if (result) {
+        const uint64_t merge_time = cog_timestamp_ms();
+
+        struct sr_dict_importer *sources = malloc(count * sizeof(*sources));
+
+        for (int i = 0; i < count; i++)
+            sources[i] = jobs[i].importer;
+
+        sr_dict_import_merge(sources, count, &importer);
+
+        free(sources);
+
+        log_info(
+            "[SAEROM] Merged %zu senses from %d file(s) in %" PRIu64 "ms",
+            importer.record_count,
+            count,
+            cog_timestamp_ms() - merge_time
+        );
+
+        result = sr_dict_import_write(&importer, output);
+    }
+
+    if (result) {
+        log_info(
+            "[SAEROM] Imported %d file(s) (%" PRIu64 " bytes) in %" PRIu64 "ms "
+            "using %d thread(s)",
+            count,
+            progress.total_bytes,
+            cog_timestamp_ms() - begin_time,
+            (threads > 0) ? threads : 1
+        );
+    }
+
+    for (int i = 0; i < count; i++) {
+        free(jobs[i].importer.strings);
+        free(jobs[i].importer.interned);
+        free(jobs[i].importer.records);
+    }
+
+    free(jobs);
+
+    free(importer.strings);
+    free(importer.interned);
+    free(importer.records);
+
+    return result;
+}
+
+/* 주어진 번호의 변경분 파일의 경로를 만든다. */
+static void sr_dict_get_segment_path(
+    const char *path,
+    uint64_t sequence,
+    char *buffer,
+    size_t size
+) {
+    snprintf(buffer, size, "%s.%" PRIu64, path, sequence);
+}
+
+/* 사전 데이터 파일의 번호를 읽는다. */
+static bool sr_dict_read_sequence(const char *path, uint64_t *sequence) {
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) return false;
+
+    struct sr_dict_header header;
+
+    const bool result = pread(fd, &header, sizeof(header), 0) == sizeof(header)
+        && memcmp(header.magic, DICT_MAGIC, sizeof(header.magic)) == 0;
+
+    if (result) *sequence = header.sequence;
+
+    close(fd);
+
+    return result;
+}
+
+/* 사전 데이터 파일 하나를 메모리에 매핑한다. */
+static struct sr_dict_segment *sr_dict_segment_open(const char *path) {
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) return NULL;
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(struct sr_dict_header)) {
+        close(fd);
+
+        return NULL;
+    }
+
+    char *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    if (map == MAP_FAILED) {
+        close(fd);
+
+        return NULL;
+    }
+
+    const struct sr_dict_header *header = (const struct sr_dict_header *) map;
+
+    const size_t size = st.st_size;
+
+    // 파일의 형식이 올바르지 않다면, 사용하지 않는다.
+    if (memcmp(header->magic, DICT_MAGIC, sizeof(header->magic)) != 0
+        || header->words_offset > size
+        || header->word_count > (size - header->words_offset) / sizeof(struct sr_dict_word)
+        || header->records_offset > size
+        || header->record_count > (size - header->records_offset) / sizeof(struct sr_dict_record)
+        || header->trie_offset > size
+        || header->trie_size == 0
+        || header->trie_size > (size - header->trie_offset) / sizeof(struct sr_dict_trie_node)
+        || header->trie_size > INT32_MAX
+        || header->strings_offset > size
+        || header->strings_size == 0
+        || header->strings_size > size - header->strings_offset
+        || map[header->strings_offset + header->strings_size - 1] != '\0') {
+        log_warn("[SAEROM] Invalid dictionary file \"%s\"", path);
+
+        munmap(map, size);
+        close(fd);
+
+        return NULL;
+    }
+
+    struct sr_dict_segment *result = calloc(1, sizeof(*result));
+
+    strncpy(result->path, path, sizeof(result->path) - 1);
+
+    result->fd = fd;
+    result->map = map;
+    result->size = size;
+    result->header = header;
+    result->words = (const struct sr_dict_word *) (map + header->words_offset);
+    result->records = (const struct sr_dict_record *) (map + header->records_offset);
+    result->nodes = (const struct sr_dict_trie_node *) (map + header->trie_offset);
+    result->strings = map + header->strings_offset;
+    result->references = 1;
+
+    log_info(
+        "[SAEROM] Loaded %u headwords (%u senses) from \"%s\"",
+        header->word_count,
+        header->record_count,
+        path
+    );
+
+    return result;
+}
+
+/* 사전 데이터 파일 하나의 참조 횟수를 줄이고, 필요하다면 메모리를 해제한다. */
+static void sr_dict_segment_release(struct sr_dict_segment *segment) {
+    if (segment == NULL) return;
+
+    if (__atomic_sub_fetch(&segment->references, 1, __ATOMIC_ACQ_REL) > 0) return;
+
+    munmap(segment->map, segment->size);
+    close(segment->fd);
+
+    free(segment);
+}
+
+/* 사전 데이터 파일 하나에서 주어진 표제어를 찾는다. */
+static const struct sr_dict_word *sr_dict_segment_find(
+    const struct sr_dict_segment *segment,
+    const char *word
+) {
+    int32_t node = 0;
+
+    // 표제어의 마지막 글자 다음에는 빈 글자 (`'\0'`)로 이어지는 노드가 있다.
+    for (const char *c = word; node >= 0; c++) {
+        node = sr_dict_trie_get_child(segment, node, (unsigned char) *c);
+
+        if (*c == '\0') break;
+    }
+
+    if (node < 0 || segment->nodes[node].base >= 0) return NULL;
+
+    const uint32_t index = -(segment->nodes[node].base + 1);
+
+    if (index >= segment->header->word_count) return NULL;
+
+    const struct sr_dict_word *entry = &segment->words[index];
+
+    if (entry->first_record > segment->header->record_count
+        || entry->record_count > segment->header->record_count - entry->first_record)
+        return NULL;
+
+    return entry;
+}
+
+/* 이중 배열 트라이에서 주어진 노드의 자식 노드를 찾는다. */
+static int32_t sr_dict_trie_get_child(
+    const struct sr_dict_segment *segment,
+    int32_t node,
+    int label
+) {
+    const int32_t base = segment->nodes[node].base;
+
+    // 표제어의 끝을 나타내는 노드는 자식 노드를 가지지 않는다.
+    if (base <= 0) return -1;
+
+    const uint64_t child = (uint64_t) base + label;
+
+    if (child >= segment->header->trie_size || segment->nodes[child].check != node)
+        return -1;
+
+    return child;
+}
+
+/* 이중 배열 트라이에서 주어진 범위의 글자로 이어지는 첫 번째 자식 노드를 찾는다. */
+static int32_t sr_dict_trie_next_child(
+    const struct sr_dict_segment *segment,
+    int32_t node,
+    int first,
+    int last
+) {
+    const int step = (first <= last) ? 1 : -1;
+
+    for (int label = first; label != last + step; label += step) {
+        int32_t child = sr_dict_trie_get_child(segment, node, label);
+
+        if (child >= 0) return child;
+    }
+
+    return -1;
+}
+
+/* 이중 배열 트라이에서 주어진 노드 아래의 첫 번째 (또는 마지막) 표제어를 찾는다. */
+static uint32_t sr_dict_trie_get_edge(
+    const struct sr_dict_segment *segment,
+    int32_t node,
+    bool last
+) {
+    while (node >= 0 && segment->nodes[node].base > 0)
+        node = last
+            ? sr_dict_trie_next_child(segment, node, UCHAR_MAX, 0)
+            : sr_dict_trie_next_child(segment, node, 0, UCHAR_MAX);
+
+    if (node < 0) return segment->header->word_count;
+
+    const uint32_t result = -(segment->nodes[node].base + 1);
+
+    return (result < segment->header->word_count) ? result : segment->header->word_count;
+}
+
+/* 이중 배열 트라이에서 주어진 문자열보다 작지 않은 첫 번째 표제어를 찾는다. */
+static uint32_t sr_dict_trie_lower_bound(
+    const struct sr_dict_segment *segment,
+    const char *key
+) {
+    uint32_t result = segment->header->word_count;
+
+    int32_t node = 0;
+
+    for (const char *c = key;; c++) {
+        const unsigned char label = *c;
+
+        // 더 깊은 노드에서 찾은 표제어일수록 주어진 문자열에 더 가깝다.
+        if (label < UCHAR_MAX) {
+            int32_t sibling = sr_dict_trie_next_child(segment, node, label + 1, UCHAR_MAX);
+
+            if (sibling >= 0) result = sr_dict_trie_get_edge(segment, sibling, false);
+        }
+
+        node = sr_dict_trie_get_child(segment, node, label);
+
+        if (node < 0) return result;
+
+        if (label == '\0') return sr_dict_trie_get_edge(segment, node, false);
+    }
+}
+
+/* 여러 사전 데이터 파일에서 찾은 표제어 범위를 하나로 합친다. */
+static int sr_dict_collect_words(
+    const struct sr_dict_snapshot *snapshot,
+    uint32_t *first,
+    const uint32_t *last,
+    const char **words,
+    int count
+) {
+    int len = 0;
+
+    while (len < count) {
+        const char *next = NULL;
+
+        for (int i = 0; i < snapshot->count; i++) {
+            if (first[i] >= last[i]) continue;
+
+            const struct sr_dict_segment *segment = snapshot->segments[i];
+
+            const char *word = sr_dict_get_string(segment, segment->words[first[i]].word);
+
+            if (next == NULL || strcmp(word, next) < 0) next = word;
+        }
+
+        if (next == NULL) break;
+
+        // 여러 파일에 있는 같은 표제어는 한 번만 반환한다.
+        for (int i = 0; i < snapshot->count; i++) {
+            if (first[i] >= last[i]) continue;
+
+            const struct sr_dict_segment *segment = snapshot->segments[i];
+
+            if (streq(sr_dict_get_string(segment, segment->words[first[i]].word), next))
+                first[i]++;
+        }
+
+        words[len++] = next;
+    }
+
+    return len;
+}
+
+/* 정렬된 표제어 목록으로 이중 배열 트라이를 만든다. */
+static void sr_dict_trie_build(
+    struct sr_dict_trie_builder *builder,
+    int32_t node,
+    uint32_t first,
+    uint32_t last,
+    size_t depth
+) {
+    unsigned char labels[UCHAR_MAX + 1];
+
+    uint32_t starts[UCHAR_MAX + 2];
+
+    int count = 0;
+
+    // 표제어 목록이 정렬되어 있으므로, 같은 글자로 이어지는 표제어들은 연속된 위치에 있다.
+    for (uint32_t i = first; i < last; i++) {
+        const unsigned char label = builder->strings[builder->words[i].word + depth];
+
+        if (count > 0 && labels[count - 1] == label) continue;
+
+        labels[count] = label;
+        starts[count++] = i;
+    }
+
+    starts[count] = last;
+
+    const int32_t base = sr_dict_trie_find_base(builder, node, labels, count);
+
+    builder->nodes[node].base = base;
+
+    for (int i = 0; i < count; i++) {
+        const int32_t child = base + labels[i];
+
+        // 표제어의 끝을 나타내는 노드에는 표제어 목록에서의 위치를 저장한다.
+        if (labels[i] == '\0') builder->nodes[child].base = -((int32_t) starts[i] + 1);
+        else sr_dict_trie_build(builder, child, starts[i], starts[i + 1], depth + 1);
+    }
+}
+
+/* 이중 배열 트라이에 주어진 자식 노드들을 모두 넣을 수 있는 위치를 찾는다. */
+static int32_t sr_dict_trie_find_base(
+    struct sr_dict_trie_builder *builder,
+    int32_t node,
+    const unsigned char *labels,
+    int count
+) {
+    if (count <= 0) return 0;
+
+    for (size_t position = builder->first_free;; position++) {
+        if (position + UCHAR_MAX + 1 >= builder->capacity) {
+            const size_t new_capacity = builder->capacity << 1;
+
+            builder->nodes = realloc(
+                builder->nodes, 
+                new_capacity * sizeof(*builder->nodes)
+            );
+
+            for (size_t i = builder->capacity; i < new_capacity; i++)
+                builder->nodes[i] = (struct sr_dict_trie_node) { 0, TRIE_FREE };
+
+            builder->capacity = new_capacity;
+        }
+
+        if (builder->nodes[position].check != TRIE_FREE || position <= labels[0]) 
+            continue;
+
+        const int32_t base = position - labels[0];
+
+        bool available = true;
+
+        for (int i = 1; i < count && available; i++)
+            available = (builder->nodes[base + labels[i]].check == TRIE_FREE);
+
+        if (!available) continue;
+
+        for (int i = 0; i < count; i++)
+            builder->nodes[base + labels[i]].check = node;
+
+        if (builder->count < (size_t) base + labels[count - 1] + 1)
+            builder->count = base + labels[count - 1] + 1;
+
+        // 이미 채워진 앞부분은 다시 확인하지 않는다.
+        while (builder->nodes[builder->first_free].check != TRIE_FREE)
+            builder->first_free++;
+
+        return base;
+    }
+}
+
+/* 검색에 사용되는 사전 데이터 파일의 목록을 교체한다. */
+static void sr_dict_swap(struct sr_dict *dict, struct sr_dict_snapshot *snapshot) {
+    struct sr_dict_snapshot *old_snapshot = NULL;
+
+    {
+        pthread_mutex_lock(&dict->lock);
+
+        old_snapshot = dict->snapshot;
+
+        dict->snapshot = snapshot;
+
+        pthread_mutex_unlock(&dict->lock);
+    }
+
+    // 이전 목록을 사용 중인 검색이 끝나면, 이전 목록의 메모리가 해제된다.
+    sr_dict_release(old_snapshot);
+}
+
+/* 변경분 파일들을 기본 파일에 병합하는 작업을 시작한다. */
+static void sr_dict_merge(struct sr_dict *dict) {
+    if (dict->merging || dict->closed) return;
+
+    struct sr_dict_snapshot *snapshot = sr_dict_acquire(dict);
+
+    if (snapshot == NULL) return;
+
+    if (snapshot->count < 2) {
+        sr_dict_release(snapshot);
+
+        return;
+    }
+
+    struct sr_dict_merge_job *job = calloc(1, sizeof(*job));
+
+    job->dict = dict;
+    job->snapshot = snapshot;
+
+    dict->merging = true;
+
+    log_info(
+        "[SAEROM] Merging %d dictionary update(s) into \"%s\"",
+        snapshot->count - 1,
+        dict->path
+    );
+
+    sr_worker_push(on_merge_work, on_merge_done, job);
+}
+
+/* 작업 스레드에서 변경분 파일들을 병합할 때 호출되는 함수. */
+static void on_merge_work(void *data) {
+    struct sr_dict_merge_job *job = data;
+
+    const struct sr_dict_snapshot *snapshot = job->snapshot;
+
+    struct sr_dict_importer sources[MAX_SEGMENT_COUNT];
+
+    struct sr_dict_importer importer = {
+        .sequence = snapshot->segments[snapshot->count - 1]->header->sequence
+    };
+
+    // 기본 파일과 변경분 파일의 뜻풀이 목록은 이미 정렬되어 있다.
+    for (int i = 0; i < snapshot->count; i++) {
+        const struct sr_dict_segment *segment = snapshot->segments[i];
+
+        sources[i] = (struct sr_dict_importer) {
+            .strings = (char *) segment->strings,
+            .strings_len = segment->header->strings_size,
+            .records = (struct sr_dict_record *) segment->records,
+            .record_count = segment->header->record_count
+        };
+
+        if (importer.timestamp < segment->header->timestamp)
+            importer.timestamp = segment->header->timestamp;
+    }
+
+    const uint64_t begin_time = cog_timestamp_ms();
+
+    sr_dict_intern(&importer, "");
+
+    sr_dict_import_merge(sources, snapshot->count, &importer);
+
+    // 기존의 기본 파일은 새로운 기본 파일을 다 만든 뒤에 한 번에 교체된다.
+    if (sr_dict_import_write(&importer, job->dict->path)) {
+        job->result = sr_dict_segment_open(job->dict->path);
+
+        log_info(
+            "[SAEROM] Merged %d dictionary update(s) in %" PRIu64 "ms",
+            snapshot->count - 1,
+            cog_timestamp_ms() - begin_time
+        );
+    }
+
+    free(importer.strings);
+    free(importer.interned);
+    free(importer.records);
+}
+
+/* 변경분 파일들의 병합이 끝났을 때 호출되는 함수. */
+static void on_merge_done(void *data) {
+    struct sr_dict_merge_job *job = data;
+
+    struct sr_dict *dict = job->dict;
+
+    if (job->result != NULL) {
+        struct sr_dict_snapshot *next = calloc(1, sizeof(*next));
+
+        next->segments[next->count++] = job->result;
+        next->references = 1;
+
+        const uint64_t sequence = job->result->header->sequence;
+
+        {
+            pthread_mutex_lock(&dict->lock);
+
+            const struct sr_dict_snapshot *current = dict->snapshot;
+
+            // 병합하는 동안 새로 추가된 변경분 파일은 계속 사용한다.
+            for (int i = 1; current != NULL && i < current->count; i++) {
+                struct sr_dict_segment *segment = current->segments[i];
+
+                if (segment->header->sequence <= sequence) continue;
+
+                __atomic_add_fetch(&segment->references, 1, __ATOMIC_RELAXED);
+
+                next->segments[next->count++] = segment;
+            }
+
+            pthread_mutex_unlock(&dict->lock);
+        }
+
+        if (!dict->closed) sr_dict_swap(dict, next);
+        else sr_dict_release(next);
+
+        // 병합된 변경분 파일은 더 이상 필요하지 않다.
+        for (int i = 1; i < job->snapshot->count; i++)
+            remove(job->snapshot->segments[i]->path);
+    }
+
+    sr_dict_release(job->snapshot);
+
+    free(job);
+
+    dict->merging = false;
+
+    if (dict->closed) {
+        pthread_mutex_destroy(&dict->lock);
+
+        free(dict);
+    }
+}
\ No newline at end of file
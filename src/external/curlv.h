@@ -68,7 +68,10 @@ void curlv_create_request(CURLV *cv, const CURLV_REQ *req);
 /* `CURLV` 인터페이스에서 가장 먼저 추가된 요청을 제거한다. */
 void curlv_remove_request(CURLV *cv);
 
-/* `CURLV` 인터페이스에 추가된 모든 요청들을 처리한다. */
+/* 
+    `CURLV` 인터페이스에 추가된 요청들을 기다리지 않고 진행하고, 처리가 끝난 요청의 콜백 함수를 호출한다.
+    요청들이 모두 끝날 때까지 기다리지 않으므로, 이벤트 루프에서 주기적으로 호출해야 한다.
+*/
 void curlv_read_requests(CURLV *cv);
 
 #ifdef __cplusplus
@@ -223,21 +226,25 @@ void curlv_remove_request(CURLV *cv) {
     pthread_mutex_unlock(&cv->lock);
 }
 
-/* `CURLV` 인터페이스에 추가된 모든 요청들을 처리한다. */
+/* 
+    `CURLV` 인터페이스에 추가된 요청들을 기다리지 않고 진행하고, 처리가 끝난 요청의 콜백 함수를 호출한다.
+    요청들이 모두 끝날 때까지 기다리지 않으므로, 이벤트 루프에서 주기적으로 호출해야 한다.
+*/
 void curlv_read_requests(CURLV *cv) {
     if (cv == NULL) return;
 
     /* https://curl.se/libcurl/c/threadsafe.html */
 
+    QUEUE(CURLV_QE) completed;
+
+    QUEUE_INIT(&completed);
+
     pthread_mutex_lock(&cv->lock);
 
     int still_running;
 
-    do {
-        CURLMcode result = curl_multi_perform(cv->multi, &still_running);
-
-        if (result != CURLM_OK) break;
-    } while (still_running);
+    // 지금 주고받을 수 있는 데이터만 처리하고, 바로 돌아온다.
+    curl_multi_perform(cv->multi, &still_running);
 
     struct CURLMsg *msg;
 
@@ -251,23 +258,31 @@ void curlv_read_requests(CURLV *cv) {
         if (msg->msg == CURLMSG_DONE) {
             CURLV_QE *qe;
 
-            CURLcode result = curl_easy_getinfo(
-                msg->easy_handle,
-                CURLINFO_PRIVATE,
-                &qe
-            );
-
-            if (qe->request.callback != NULL)
-                qe->request.callback(qe->response, qe->request.user_data);
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &qe);
 
             QUEUE_REMOVE(&qe->entry);
 
             curl_multi_remove_handle(cv->multi, qe->request.easy);
-            curlv_qe_cleanup(qe);
+
+            QUEUE_INSERT_TAIL(&completed, &qe->entry);
         }
     }
 
     pthread_mutex_unlock(&cv->lock);
+
+    // 콜백 함수에서 새로운 요청을 추가할 수 있도록, 잠금을 해제한 뒤에 호출한다.
+    while (!QUEUE_EMPTY(&completed)) {
+        QUEUE(CURLV_QE) *head = QUEUE_HEAD(&completed);
+
+        QUEUE_REMOVE(head);
+
+        CURLV_QE *qe = QUEUE_DATA(head, CURLV_QE, entry);
+
+        if (qe->request.callback != NULL)
+            qe->request.callback(qe->response, qe->request.user_data);
+
+        curlv_qe_cleanup(qe);
+    }
 }
 
 /* `CURLV` 인터페이스의 응답 처리 시에 호출되는 함수. */
@@ -95,6 +95,14 @@ typedef struct {
 	 */
 	char data[8];
 
+	/* The characters of the last YXML_CONTENT, YXML_ATTRVAL or YXML_PICONTENT
+	 * token returned by yxml_parse_buf(), which are not zero-terminated. Points
+	 * either into the buffer given to yxml_parse_buf() (for a run of plain
+	 * content or attribute value characters) or to the data field above, and
+	 * is only valid until the next yxml_parse_buf() call. */
+	const char *span;
+	size_t spanlen;
+
 	/* Name of the current attribute. Changed after YXML_ATTRSTART, valid up to
 	 * and including the next YXML_ATTREND. */
 	char *attr;
@@ -121,6 +129,8 @@ typedef struct {
 	int nextstate; /* Used for '@' state remembering and for the "string" consuming state */
 	unsigned ignore;
 	unsigned char *string;
+	size_t (*find)(const char *, size_t, unsigned, unsigned); /* Kernel used by yxml_parse_buf(), selected in yxml_init() */
+	unsigned skip; /* Depth of the subtree being skipped by yxml_skip() */
 } yxml_t;
 
 
@@ -134,6 +144,32 @@ void yxml_init(yxml_t *, void *, size_t);
 yxml_ret_t yxml_parse(yxml_t *, int);
 
 
+/* Parses characters from the given buffer until a token other than YXML_OK is
+ * returned or all len bytes have been consumed. The number of bytes consumed
+ * is stored in *consumed, and the last token (YXML_OK if the buffer ran out)
+ * is returned. Unlike yxml_parse(), a run of plain element content or
+ * attribute value characters is returned as a single YXML_CONTENT or
+ * YXML_ATTRVAL token, with the characters available in x->span. */
+yxml_ret_t yxml_parse_buf(yxml_t *, const char *, size_t, size_t *);
+
+
+/* May be called directly after a YXML_ELEMSTART token has been returned by
+ * yxml_parse_buf(). The following yxml_parse_buf() calls then consume the rest
+ * of that element, including all of its children, without returning any
+ * tokens, and return YXML_ELEMEND for its end tag. Errors are still returned
+ * as usual. Together with yxml_parse_buf(), this allows moving to the next
+ * sibling of an element without looking at its subtree. */
+void yxml_skip(yxml_t *);
+
+
+/* May be called after yxml_init() to make yxml_parse_buf() scan runs with the
+ * named kernel ("scalar", "sse2", "avx2" or "neon") instead of the one that
+ * yxml_init() selected for the running CPU. Meant for benchmarks and tests.
+ * Returns 0 and leaves the parser unchanged if the kernel was not built in or
+ * is not supported by the running CPU. */
+int yxml_set_kernel(yxml_t *, const char *);
+
+
 /* May be called after the last character has been given to yxml_parse().
  * Returns YXML_OK if the XML document is valid, YXML_EEOF otherwise.  Using
  * this function isn't really necessary, but can be used to detect documents
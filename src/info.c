@@ -15,6 +15,7 @@
     along with this program. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <inttypes.h>
 #include <time.h>
 
 #include <saerom.h>
@@ -30,6 +31,12 @@ static struct discord_create_global_application_command params = {
 
 /* | `info` 모듈 함수... | */
 
+/* 캐시의 적중률을 문자열로 변환하여 문자열 버퍼에 추가한다. */
+static void sr_command_info_format_hit_rate(
+    const struct sr_cache_stats *stats,
+    struct sr_strbuf *sb
+);
+
 /* `/info` 명령어를 생성한다. */
 void sr_command_info_init(struct discord *client) {
     discord_create_global_application_command(
@@ -56,6 +63,12 @@ void sr_command_info_run(
     char uptime_str[MAX_STRING_SIZE];
     char ping_str[MAX_STRING_SIZE];
     char flags_str[MAX_STRING_SIZE];
+
+    char krd_cache_str[MAX_STRING_SIZE];
+    char ppg_cache_str[MAX_STRING_SIZE];
+    char ppg_saved_str[MAX_STRING_SIZE];
+
+    struct sr_cache_stats krd_cache_stats, ppg_cache_stats;
     
     const time_t uptime_in_seconds = sr_get_uptime() * 0.001f;
 
@@ -66,6 +79,24 @@ void sr_command_info_run(
     snprintf(ping_str, sizeof(ping_str), "%dms", discord_get_ping(client));
     snprintf(flags_str, sizeof(flags_str), "0x%02lX", sr_config_get_module_flags());
 
+    sr_command_krdict_get_cache_stats(&krd_cache_stats);
+    sr_command_papago_get_cache_stats(&ppg_cache_stats);
+
+    struct sr_strbuf sb;
+
+    sr_strbuf_init(&sb, krd_cache_str, sizeof(krd_cache_str));
+    sr_command_info_format_hit_rate(&krd_cache_stats, &sb);
+
+    sr_strbuf_init(&sb, ppg_cache_str, sizeof(ppg_cache_str));
+    sr_command_info_format_hit_rate(&ppg_cache_stats, &sb);
+
+    snprintf(
+        ppg_saved_str, 
+        sizeof(ppg_saved_str), 
+        "%" PRIu64 " chars", 
+        sr_command_papago_get_saved_characters()
+    );
+
     if (event == NULL) {
         log_info("[SAEROM] %s: %s", APPLICATION_NAME, APPLICATION_DESCRIPTION);
 
@@ -84,6 +115,13 @@ void sr_command_info_run(
             flags_str
         );
 
+        log_info(
+            "[SAEROM] Cache (krd): %s, Cache (ppg): %s, Saved (ppg): %s", 
+            krd_cache_str, 
+            ppg_cache_str, 
+            ppg_saved_str
+        );
+
         return;
     }
 
@@ -118,6 +156,21 @@ void sr_command_info_run(
             .value = flags_str,
             .Inline = true
         },
+        {
+            .name = "Cache (krd)",
+            .value = krd_cache_str,
+            .Inline = true
+        },
+        {
+            .name = "Cache (ppg)",
+            .value = ppg_cache_str,
+            .Inline = true
+        },
+        {
+            .name = "Saved (ppg)",
+            .value = ppg_saved_str,
+            .Inline = true
+        },
     };
 
     char *avatar_url = get_avatar_url(discord_get_self(client));
@@ -160,4 +213,19 @@ void sr_command_info_run(
     );
 
     free(avatar_url);
+}
+
+/* 캐시의 적중률을 문자열로 변환하여 문자열 버퍼에 추가한다. */
+static void sr_command_info_format_hit_rate(
+    const struct sr_cache_stats *stats,
+    struct sr_strbuf *sb
+) {
+    const uint64_t lookups = stats->hits + stats->misses;
+
+    sr_strbuf_printf(
+        sb, 
+        "%.1f%% (%zu)", 
+        (lookups > 0) ? (100.0 * stats->hits) / lookups : 0.0,
+        stats->count
+    );
 }
\ No newline at end of file
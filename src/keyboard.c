@@ -0,0 +1,260 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <saerom.h>
+
+/* | `keyboard` 모듈 매크로 정의... | */
+
+#define SYLLABLE_BEGIN  0xAC00
+
+/* 자모가 아닌 키를 나타내는 값. */
+#define KEY_NONE        0
+
+/* 자음 키를 나타내는 값의 시작 (초성 번호 + 1). */
+#define KEY_CONSONANT   0x100
+
+/* 모음 키를 나타내는 값의 시작 (중성 번호 + 1). */
+#define KEY_VOWEL       0x200
+
+/* | `keyboard` 모듈 자료형 정의... | */
+
+/* 한글 음절을 조합하는 중인 상태를 나타내는 구조체. */
+struct sr_keyboard_state {
+    int initial;
+    int medial;
+    int final;
+    char *buffer;
+    size_t size;
+    size_t len;
+    bool complete;
+};
+
+/* | `keyboard` 모듈 상수 및 변수... | */
+
+/* 두벌식 자판의 로마자 키 (`a` ~ `z`)에 해당하는 자모. */
+static const int lower_keys[26] = {
+    KEY_CONSONANT + 7,  KEY_VOWEL + 18,     KEY_CONSONANT + 15, KEY_CONSONANT + 12,
+    KEY_CONSONANT + 4,  KEY_CONSONANT + 6,  KEY_CONSONANT + 19, KEY_VOWEL + 9,
+    KEY_VOWEL + 3,      KEY_VOWEL + 5,      KEY_VOWEL + 1,      KEY_VOWEL + 21,
+    KEY_VOWEL + 19,     KEY_VOWEL + 14,     KEY_VOWEL + 2,      KEY_VOWEL + 6,
+    KEY_CONSONANT + 8,  KEY_CONSONANT + 1,  KEY_CONSONANT + 3,  KEY_CONSONANT + 10,
+    KEY_VOWEL + 7,      KEY_CONSONANT + 18, KEY_CONSONANT + 13, KEY_CONSONANT + 17,
+    KEY_VOWEL + 13,     KEY_CONSONANT + 16
+};
+
+/* 두벌식 자판의 로마자 키 (`A` ~ `Z`)에 해당하는 자모. */
+static const int upper_keys[26] = {
+    KEY_CONSONANT + 7,  KEY_VOWEL + 18,     KEY_CONSONANT + 15, KEY_CONSONANT + 12,
+    KEY_CONSONANT + 5,  KEY_CONSONANT + 6,  KEY_CONSONANT + 19, KEY_VOWEL + 9,
+    KEY_VOWEL + 3,      KEY_VOWEL + 5,      KEY_VOWEL + 1,      KEY_VOWEL + 21,
+    KEY_VOWEL + 19,     KEY_VOWEL + 14,     KEY_VOWEL + 4,      KEY_VOWEL + 8,
+    KEY_CONSONANT + 9,  KEY_CONSONANT + 2,  KEY_CONSONANT + 3,  KEY_CONSONANT + 11,
+    KEY_VOWEL + 7,      KEY_CONSONANT + 18, KEY_CONSONANT + 14, KEY_CONSONANT + 17,
+    KEY_VOWEL + 13,     KEY_CONSONANT + 16
+};
+
+/* 초성 번호에 해당하는 종성 번호 (종성으로 쓸 수 없다면 0). */
+static const int initial_to_final[19] = {
+    1, 2, 4, 7, 0, 8, 16, 17, 0, 19, 20, 21, 22, 0, 23, 24, 25, 26, 27
+};
+
+/* 종성 번호에 해당하는 초성 번호 (겹받침은 두 번째 자음). */
+static const int final_to_initial[28] = {
+    -1, 0, 1, 9, 2, 12, 18, 3, 5, 0, 6, 7, 9, 16, 17, 18, 6, 7, 9, 9, 10, 11, 12, 14, 15, 16, 17, 18
+};
+
+/* 겹받침의 첫 번째 자음의 종성 번호 (겹받침이 아니라면 0). */
+static const int final_heads[28] = {
+    0, 0, 0, 1, 0, 4, 4, 0, 0, 8, 8, 8, 8, 8, 8, 8, 0, 0, 17, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* | `keyboard` 모듈 함수... | */
+
+/* 두 모음을 합친 겹모음의 중성 번호를 반환한다. */
+static int sr_keyboard_combine_medials(int lhs, int rhs);
+
+/* 받침과 자음을 합친 겹받침의 종성 번호를 반환한다. */
+static int sr_keyboard_combine_finals(int lhs, int rhs);
+
+/* 조합 중인 음절을 완성하여 버퍼에 추가한다. */
+static void sr_keyboard_flush(struct sr_keyboard_state *state);
+
+/* 유니코드 코드 포인트를 UTF-8 문자열로 변환하여 버퍼에 추가한다. */
+static void sr_keyboard_append(struct sr_keyboard_state *state, uint32_t codepoint);
+
+/*
+    두벌식 자판으로 입력한 로마자 문자열을 한글로 바꾼다.
+    모든 글자가 완성된 한글 음절로 바뀌었을 때만 `true`를 반환한다.
+*/
+bool sr_keyboard_to_hangul(const char *str, char *buffer, size_t size) {
+    if (str == NULL || buffer == NULL || size == 0) return false;
+
+    struct sr_keyboard_state state = {
+        .initial = -1,
+        .medial = -1,
+        .buffer = buffer,
+        .size = size,
+        .complete = true
+    };
+
+    *buffer = '\0';
+
+    int key_count = 0;
+
+    for (const char *c = str; *c != '\0'; c++) {
+        int key = KEY_NONE;
+
+        if (*c >= 'a' && *c <= 'z') key = lower_keys[*c - 'a'];
+        else if (*c >= 'A' && *c <= 'Z') key = upper_keys[*c - 'A'];
+
+        if (key == KEY_NONE) {
+            // 공백 외의 문자가 있다면, 로마자 문자열로 입력한 것으로 본다.
+            if (*c != ' ') return false;
+
+            sr_keyboard_flush(&state);
+            sr_keyboard_append(&state, ' ');
+
+            continue;
+        }
+
+        key_count++;
+
+        if (key < KEY_VOWEL) {
+            const int initial = key - KEY_CONSONANT - 1;
+
+            if (state.medial < 0) {
+                // 초성만 있는 상태에서 다시 자음을 입력하면, 초성만 있는 글자가 된다.
+                if (state.initial >= 0) sr_keyboard_flush(&state);
+
+                state.initial = initial;
+            } else if (state.initial < 0) {
+                sr_keyboard_flush(&state);
+
+                state.initial = initial;
+            } else if (state.final == 0 && initial_to_final[initial] != 0) {
+                state.final = initial_to_final[initial];
+            } else {
+                const int final = sr_keyboard_combine_finals(
+                    state.final,
+                    initial_to_final[initial]
+                );
+
+                if (state.final != 0 && final != 0) {
+                    state.final = final;
+                } else {
+                    sr_keyboard_flush(&state);
+
+                    state.initial = initial;
+                }
+            }
+        } else {
+            const int medial = key - KEY_VOWEL - 1;
+
+            if (state.final != 0) {
+                // 받침 뒤에 모음을 입력하면, 받침 (의 두 번째 자음)은 다음 글자의 초성이 된다.
+                const int next_initial = final_to_initial[state.final];
+
+                state.final = final_heads[state.final];
+
+                sr_keyboard_flush(&state);
+
+                state.initial = next_initial;
+                state.medial = medial;
+            } else if (state.medial >= 0) {
+                const int combined = sr_keyboard_combine_medials(state.medial, medial);
+
+                if (combined >= 0) {
+                    state.medial = combined;
+                } else {
+                    sr_keyboard_flush(&state);
+
+                    state.medial = medial;
+                }
+            } else {
+                state.medial = medial;
+            }
+        }
+    }
+
+    sr_keyboard_flush(&state);
+
+    return state.complete && key_count > 0;
+}
+
+/* 두 모음을 합친 겹모음의 중성 번호를 반환한다. */
+static int sr_keyboard_combine_medials(int lhs, int rhs) {
+    // ㅗ + ㅏ/ㅐ/ㅣ, ㅜ + ㅓ/ㅔ/ㅣ, ㅡ + ㅣ
+    if (lhs == 8 && rhs == 0) return 9;
+    if (lhs == 8 && rhs == 1) return 10;
+    if (lhs == 8 && rhs == 20) return 11;
+    if (lhs == 13 && rhs == 4) return 14;
+    if (lhs == 13 && rhs == 5) return 15;
+    if (lhs == 13 && rhs == 20) return 16;
+    if (lhs == 18 && rhs == 20) return 19;
+
+    return -1;
+}
+
+/* 받침과 자음을 합친 겹받침의 종성 번호를 반환한다. */
+static int sr_keyboard_combine_finals(int lhs, int rhs) {
+    for (int i = 1; i < 28; i++)
+        if (final_heads[i] == lhs && initial_to_final[final_to_initial[i]] == rhs)
+            return (lhs != 0) ? i : 0;
+
+    return 0;
+}
+
+/* 조합 중인 음절을 완성하여 버퍼에 추가한다. */
+static void sr_keyboard_flush(struct sr_keyboard_state *state) {
+    if (state->initial >= 0 && state->medial >= 0) {
+        sr_keyboard_append(
+            state,
+            SYLLABLE_BEGIN + (state->initial * 21 + state->medial) * 28 + state->final
+        );
+    } else if (state->initial >= 0 || state->medial >= 0) {
+        // 초성이나 중성만 있는 글자는 한글로 입력한 것이 아닐 가능성이 높다.
+        state->complete = false;
+    }
+
+    state->initial = state->medial = -1;
+    state->final = 0;
+}
+
+/* 유니코드 코드 포인트를 UTF-8 문자열로 변환하여 버퍼에 추가한다. */
+static void sr_keyboard_append(struct sr_keyboard_state *state, uint32_t codepoint) {
+    if (codepoint < 0x80) {
+        if (state->len + 1 >= state->size) {
+            state->complete = false;
+
+            return;
+        }
+
+        state->buffer[state->len++] = codepoint;
+    } else {
+        if (state->len + 3 >= state->size) {
+            state->complete = false;
+
+            return;
+        }
+
+        state->buffer[state->len++] = 0xE0 | (codepoint >> 12);
+        state->buffer[state->len++] = 0x80 | ((codepoint >> 6) & 0x3F);
+        state->buffer[state->len++] = 0x80 | (codepoint & 0x3F);
+    }
+
+    state->buffer[state->len] = '\0';
+}
\ No newline at end of file
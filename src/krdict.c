@@ -24,22 +24,247 @@
 #define MAX_EXAMPLE_COUNT     10
 #define MAX_ORDER_COUNT       7
 
+#define PAGE_ITEM_COUNT       10
+#define MAX_START_INDEX       1000
+#define MAX_PREFETCH_COUNT    4
+
+/* 응답을 받지 못한 요청이 남아 있으면 미뤄 둔 요청을 보낼 수 없으므로, 오래 기다리지 않는다. */
+#define REQUEST_TIMEOUT_MS    10000
+
+/* 일일 허용량 중 이만큼을 사용하면, 검색 결과를 미리 가져오지 않는다. */
+#define PREFETCH_QUOTA_RATIO  0.9
+
+/* 오늘 각 오픈 API에 보낸 요청의 개수는 이 간격 (단위: 밀리초)마다 파일에 기록한다. */
+#define USAGE_SAVE_INTERVAL   60000
+
+#define RECORD_BUFFER_SIZE    (2 * DISCORD_EMBED_DESCRIPTION_LEN)
+
+#define PARSE_STACK_SIZE      512
+#define PARSE_CHUNK_SIZE      4096
+#define PARSE_CONTENT_SIZE    MAX_STRING_SIZE
+#define PARSE_MAX_DEPTH       16
+
+#define ELEMENT_TABLE_SIZE    64
+
+/* 
+    `/krd` 명령어의 응답 데이터 (한국어기초사전, 우리말샘)의 구조를 나타내는 매크로.
+    
+    각 요소마다 해시 테이블에서의 위치와 이름, 번호, 그리고 요소를 다 읽었을 때
+    `channel` 요소 바로 아래, 어휘 검색 결과, 용례 검색 결과에서 각각 할 일을 적는다.
+    출력하지 않는 큰 하위 요소 (`BIND(SKIP)`)는 요소를 읽기 시작할 때 통째로 건너뛴다.
+*/
+#define KRDICT_SCHEMA(X)                                                                                                   \
+    X(31, "channel",                CHANNEL,       BIND_NONE,   BIND_NONE,          BIND_NONE)                             \
+    X(33, "total",                  TOTAL,         BIND(TOTAL), BIND_NONE,          BIND_NONE)                             \
+    X(59, "error",                  ERROR,         BIND_NONE,   BIND_NONE,          BIND_NONE)                             \
+    X(13, "item",                   ITEM,          BIND_NONE,   BIND_NONE,          BIND_NONE)                             \
+    X(36, "word",                   WORD,          BIND_NONE,   BIND_FIELD(word),   BIND_FIELD(word))                      \
+    X( 0, "origin",                 ORIGIN,        BIND_NONE,   BIND_FIELD(origin), BIND_NONE)                             \
+    X(62, "pos",                    POS,           BIND_NONE,   BIND_FIELD(pos),    BIND_NONE)                             \
+    X(39, "link",                   LINK,          BIND_NONE,   BIND_FIELD(link),   BIND_FIELD_THEN(link, ADD_NEXT_ITEM))  \
+    X(46, "sense",                  SENSE,         BIND_NONE,   BIND(ADD_ITEM),     BIND_NONE)                             \
+    X(57, "sense_order",            SENSE_ORDER,   BIND_NONE,   BIND(ORDER),        BIND_NONE)                             \
+    X(43, "sense_no",               SENSE_NO,      BIND_NONE,   BIND(ORDER),        BIND_NONE)                             \
+    X(24, "definition",             DEFINITION,    BIND_NONE,   BIND_FIELD(dfn),    BIND_NONE)                             \
+    X(30, "trans_word",             TRANS_WORD,    BIND_NONE,   BIND_FIELD(dfn),    BIND_NONE)                             \
+    X(23, "trans_dfn",              TRANS_DFN,     BIND_NONE,   BIND_FIELD(exam),   BIND_NONE)                             \
+    X(56, "example",                EXAMPLE,       BIND_NONE,   BIND_NONE,          BIND_FIELD(exam))                      \
+    X(55, "example_info",           EXAMPLE_INFO,  BIND_NONE,   BIND(SKIP),         BIND_NONE)                             \
+    X(26, "multimedia_info",        MEDIA_INFO,    BIND_NONE,   BIND(SKIP),         BIND_NONE)                             \
+    X(44, "relation_info",          RELATION_INFO, BIND_NONE,   BIND(SKIP),         BIND_NONE)                             \
+    X(35, "pattern_info",           PATTERN_INFO,  BIND_NONE,   BIND(SKIP),         BIND_NONE)                             \
+    X(45, "conju_info",             CONJU_INFO,    BIND_NONE,   BIND(SKIP),         BIND_NONE)                             \
+    X(47, "subword_info",           SUBWORD_INFO,  BIND_NONE,   BIND(SKIP),         BIND_NONE)                             \
+    X(48, "category_info",          CATEGORY_INFO, BIND_NONE,   BIND(SKIP),         BIND_NONE)                             \
+    X(41, "original_language_info", LANGUAGE_INFO, BIND_NONE,   BIND(SKIP),         BIND_NONE)
+
+#define BIND_NONE                  { KRD_ACTION_NONE, -1 }
+#define BIND(action)               { KRD_ACTION_##action, -1 }
+#define BIND_FIELD(field)          { KRD_ACTION_NONE, offsetof(struct krdict_item, field) }
+#define BIND_FIELD_THEN(field, action)  \
+    { KRD_ACTION_##action, offsetof(struct krdict_item, field) }
+
+#define MAX_CHOICE_COUNT      25
+#define MAX_CHOICE_LENGTH     100
+
+#define MAX_CORRECTION_COUNT  5
+#define MAX_LEMMA_COUNT       32
+#define MAX_CUSTOM_ID_LENGTH  100
+#define MAX_LABEL_LENGTH      80
+
 /* | `krdict` 모듈 자료형 정의... | */
 
 /* `/krd` 명령어의 조건 플래그를 나타내는 열거형. */
 enum krdict_flag {
     KRD_FLAG_PART_EXAM  = (1 << 0),
-    KRD_FLAG_TRANSLATED = (1 << 1)
+    KRD_FLAG_TRANSLATED = (1 << 1),
+    KRD_FLAG_CONVERTED  = (1 << 2),
+    KRD_FLAG_FANOUT     = (1 << 3)
+};
+
+/* `/krd` 명령어의 검색 결과를 가져오는 오픈 API를 나타내는 열거형. */
+enum krdict_source {
+    KRD_SOURCE_KRDICT,
+    KRD_SOURCE_URMSAEM,
+    KRD_SOURCE_COUNT_
+};
+
+/* `/krd` 명령어의 응답 데이터에서 사용하는 요소를 나타내는 열거형. */
+enum krdict_element {
+    KRD_ELEM_OTHER,
+#define X(slot, name, id, ...) KRD_ELEM_##id,
+    KRDICT_SCHEMA(X)
+#undef X
+    KRD_ELEM_COUNT_
+};
+
+/* `/krd` 명령어의 응답 데이터에서 요소를 다 읽었을 때 할 일을 나타내는 열거형. */
+enum krdict_action {
+    KRD_ACTION_NONE,
+    KRD_ACTION_TOTAL,
+    KRD_ACTION_ORDER,
+    KRD_ACTION_ADD_ITEM,
+    KRD_ACTION_ADD_NEXT_ITEM,
+    KRD_ACTION_SKIP
+};
+
+/* `/krd` 명령어의 응답 데이터를 읽는 위치를 나타내는 열거형. */
+enum krdict_context {
+    KRD_CONTEXT_CHANNEL,
+    KRD_CONTEXT_WORD,
+    KRD_CONTEXT_EXAM,
+    KRD_CONTEXT_COUNT_
+};
+
+/* `/krd` 명령어의 응답 데이터에서 사용하는 요소의 이름과 번호. */
+struct krdict_element_name {
+    const char *name;
+    enum krdict_element element;
+};
+
+/* 
+    `/krd` 명령어의 응답 데이터에서 요소를 다 읽었을 때 할 일을 나타내는 구조체.
+    `field`는 요소의 내용을 저장할 검색 결과 필드의 위치 (저장하지 않는다면 `-1`)이다.
+*/
+struct krdict_binding {
+    enum krdict_action action;
+    ptrdiff_t field;
+};
+
+/* 다른 버퍼에 있는 문자열의 일부를 나타내는 구조체. */
+struct krdict_span {
+    const char *str;
+    size_t len;
 };
 
 /* `/krd` 명령어의 개별 검색 결과를 나타내는 구조체. */
 struct krdict_item {
-    char word[MAX_STRING_SIZE];
-    char origin[MAX_STRING_SIZE];
-    char pos[MAX_STRING_SIZE];
-    char link[MAX_STRING_SIZE];
-    char dfn[2 * MAX_STRING_SIZE];
-    char exam[2 * MAX_STRING_SIZE];
+    struct krdict_span word;
+    struct krdict_span origin;
+    struct krdict_span pos;
+    struct krdict_span link;
+    struct krdict_span dfn;
+    struct krdict_span exam;
+};
+
+/* `/krd` 명령어의 응답 데이터를 나누어 읽는 파서를 나타내는 구조체. */
+struct krdict_parser {
+    yxml_t xml;
+    char stack[PARSE_STACK_SIZE];
+    struct krdict_item item;
+    char text[DISCORD_EMBED_DESCRIPTION_LEN];
+    size_t text_len;
+    size_t content;
+    size_t sense;
+    bool truncated;
+    unsigned char elements[PARSE_MAX_DEPTH];
+    int depth;
+    char *records;
+    size_t size;
+    size_t len;
+    struct sr_strbuf output;
+    u64bitmask flags;
+    int total;
+    int order;
+    int count;
+    size_t entry_len;
+    size_t entry_output;
+    bool done;
+};
+
+/* 
+    `/krd` 명령어의 캐시 항목을 나타내는 구조체.
+    `count`는 이 페이지에서 보여준 항목의 개수로, 다음 페이지의 시작 위치를 정할 때 사용한다.
+*/
+struct krdict_cache_value {
+    int total;
+    int count;
+    char data[RECORD_BUFFER_SIZE];
+};
+
+/* `/krd` 명령어의 응답 데이터 가공 작업을 나타내는 구조체. */
+struct krdict_job {
+    struct sr_command_context *context;
+    CURLV_STR res;
+    char buffer[DISCORD_EMBED_DESCRIPTION_LEN];
+    int total;
+    int count;
+};
+
+/* `/krd` 명령어가 두 오픈 API 중 하나에서 가져온 검색 결과를 나타내는 구조체. */
+struct krdict_fanout_result {
+    char records[RECORD_BUFFER_SIZE];
+    size_t len;
+    int total;
+    int count;
+    bool done;
+};
+
+/* `/krd` 명령어가 두 오픈 API에 동시에 보낸 요청을 나타내는 구조체. */
+struct krdict_fanout {
+    struct sr_command_context *context;
+    struct krdict_fanout_result results[KRD_SOURCE_COUNT_];
+    uint64_t deadline;
+    bool sent;
+    bool shown;
+    struct krdict_fanout *next;
+};
+
+/* `/krd` 명령어가 두 오픈 API에 동시에 보낸 요청 중 하나의 응답 데이터 가공 작업을 나타내는 구조체. */
+struct krdict_fanout_job {
+    struct krdict_fanout *fanout;
+    enum krdict_source source;
+    CURLV_STR res;
+    char buffer[DISCORD_EMBED_DESCRIPTION_LEN];
+};
+
+/* `/krd` 명령어의 표제어 색인을 만드는 작업을 나타내는 구조체. */
+struct krdict_headwords_job {
+    struct sr_dict_snapshot *snapshot;
+    struct sr_bloom *bloom;
+    struct sr_suggest *suggest;
+    uint64_t timestamp;
+};
+
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 나타내는 구조체. */
+struct krdict_usage {
+    uint64_t day;
+    int counts[KRD_SOURCE_COUNT_];
+    bool exhausted[KRD_SOURCE_COUNT_];
+};
+
+/* `/krd` 명령어가 나중에 미리 가져올 검색 결과를 나타내는 구조체. */
+struct krdict_prefetch {
+    char query[2 * MAX_STRING_SIZE];
+    const char *part;
+    const char *translated;
+    int start;
+};
+
+/* `/krd` 명령어의 검색 결과를 미리 가져오는 빈도를 제한하는 토큰 버킷. */
+struct krdict_bucket {
+    double tokens;
+    uint64_t updated_at;
 };
 
 /* | `krdict` 모듈 상수 및 변수... | */
@@ -56,7 +281,8 @@ static struct discord_application_command_option options[] = {
         .type = DISCORD_APPLICATION_OPTION_STRING,
         .name = "query",
         .description = "The text you're looking up",
-        .required = true
+        .required = true,
+        .autocomplete = true
     },
     {
         .type = DISCORD_APPLICATION_OPTION_STRING,
@@ -75,6 +301,86 @@ static struct discord_application_command_option options[] = {
     }
 };
 
+/* 
+    `/krd` 명령어의 응답 데이터에서 사용하는 요소의 이름 목록.
+    요소 이름마다 서로 다른 위치를 갖도록 미리 구한 해시 테이블이다.
+    (`sr_command_krdict_find_element()` 참고)
+*/
+static const struct krdict_element_name element_names[ELEMENT_TABLE_SIZE] = {
+#define X(slot, name, id, ...) [slot] = { name, KRD_ELEM_##id },
+    KRDICT_SCHEMA(X)
+#undef X
+};
+
+/* `/krd` 명령어의 응답 데이터에서 각 요소를 다 읽었을 때 할 일의 목록. */
+static const struct krdict_binding element_bindings[KRD_ELEM_COUNT_][KRD_CONTEXT_COUNT_] = {
+    [KRD_ELEM_OTHER] = { BIND_NONE, BIND_NONE, BIND_NONE },
+#define X(slot, name, id, channel, word, exam) [KRD_ELEM_##id] = { channel, word, exam },
+    KRDICT_SCHEMA(X)
+#undef X
+};
+
+/* 내용이 없는 `/krd` 명령어의 개별 검색 결과. */
+static const struct krdict_item empty_item = {
+    .word   = { "", 0 },
+    .origin = { "", 0 },
+    .pos    = { "", 0 },
+    .link   = { "", 0 },
+    .dfn    = { "", 0 },
+    .exam   = { "", 0 }
+};
+
+/* `/krd` 명령어의 검색 결과 캐시 (1단계: 출력 결과). */
+static struct sr_cache *result_cache;
+
+/* `/krd` 명령어의 검색 결과 캐시 (2단계: 가공된 검색 결과). */
+static struct sr_cache *item_cache;
+
+/* `/krd` 명령어의 검색 결과가 없는 검색어 캐시. */
+static struct sr_cache *miss_cache;
+
+/* `/krd` 명령어의 오프라인 사전 데이터. */
+static struct sr_dict *dictionary;
+
+/* `/krd` 명령어의 검색어 자동 완성 색인. */
+static struct sr_suggest *suggestions;
+
+/* `/krd` 명령어의 표제어 블룸 필터. */
+static struct sr_bloom *headwords;
+
+/* `/krd` 명령어의 표제어 블룸 필터를 만든 사전 데이터가 마지막으로 갱신된 시각. */
+static uint64_t headwords_timestamp;
+
+/* `/krd` 명령어의 표제어 블룸 필터를 만드는 중인지 여부. */
+static bool headwords_building;
+
+/* `/krd` 명령어의 검색 결과를 미리 가져오는 중인 요청의 개수. */
+static int prefetch_count;
+
+/* `/krd` 명령어가 오픈 API에 보낸 사용자의 검색 요청 중 아직 응답을 받지 못한 요청의 개수. */
+static int request_count;
+
+/* `/krd` 명령어가 사용자의 검색 요청을 모두 처리한 뒤에 미리 가져올 검색 결과의 목록. */
+static struct krdict_prefetch deferred_prefetches[MAX_PREFETCH_COUNT];
+
+/* `/krd` 명령어가 나중에 미리 가져올 검색 결과의 개수. */
+static int deferred_count;
+
+/* `/krd` 명령어가 두 오픈 API에 동시에 보낸 요청 중 아직 끝나지 않은 요청의 목록. */
+static struct krdict_fanout *fanouts;
+
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수. */
+static struct krdict_usage usage;
+
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 마지막으로 파일에 기록한 시각. */
+static uint64_t usage_saved_at;
+
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수가 파일에 기록된 뒤로 바뀌었는지 여부. */
+static bool usage_dirty;
+
+/* `/krd` 명령어의 검색 결과를 미리 가져오는 빈도를 제한하는 토큰 버킷. */
+static struct krdict_bucket prefetch_bucket;
+
 /* `/krd` 명령어에 대한 정보. */
 static struct discord_create_global_application_command params = {
     .name = "krd",
@@ -89,6 +395,28 @@ static struct discord_create_global_application_command params = {
 
 /* | `krdict` 모듈 함수... | */
 
+/* `/krd` 명령어 캐시의 통계 정보를 반환한다. */
+void sr_command_krdict_get_cache_stats(struct sr_cache_stats *stats) {
+    if (stats == NULL) return;
+
+    struct sr_cache_stats result_stats = { 0 }, item_stats = { 0 };
+
+    sr_cache_get_stats(result_cache, &result_stats);
+    sr_cache_get_stats(item_cache, &item_stats);
+
+    // 출력 결과 캐시에서 찾지 못한 검색어만 가공된 검색 결과 캐시에서 찾는다.
+    *stats = (struct sr_cache_stats) {
+        .hits = result_stats.hits + item_stats.hits,
+        .misses = item_stats.misses,
+        .evictions = result_stats.evictions + item_stats.evictions,
+        .expirations = result_stats.expirations + item_stats.expirations,
+        .rejections = result_stats.rejections + item_stats.rejections,
+        .count = result_stats.count + item_stats.count,
+        .size = result_stats.size + item_stats.size,
+        .budget = result_stats.budget + item_stats.budget
+    };
+}
+
 /* 개인 메시지 전송에 성공했을 때 호출되는 함수. */
 static void on_message_success(
     struct discord *client, 
@@ -111,524 +439,576 @@ static void on_component_interaction(
     const struct discord_interaction *event
 );
 
+/* 검색어 자동 완성 요청을 받았을 때 호출되는 함수. */
+static void on_autocomplete(
+    struct discord *client,
+    const struct discord_interaction *event
+);
+
 /* 요청 URL에서 응답을 받았을 때 호출되는 함수. */
-static void on_response(CURLV_STR res, void *user_data);
+static void on_response_default(CURLV_STR res, void *user_data);
 
-/* `/krd` 명령어를 생성한다. */
-void sr_command_krdict_init(struct discord *client) {
-    discord_create_global_application_command(
-        client,
-        sr_config_get_application_id(),
-        &params,
-        NULL
-    );
-}
+/* 두벌식 자판 기준으로 바꾼 검색어의 응답을 받았을 때 호출되는 함수. */
+static void on_response_converted(CURLV_STR res, void *user_data);
 
-/* `/krd` 명령어에 할당된 메모리를 해제한다. */
-void sr_command_krdict_cleanup(struct discord *client) {
-    /* no-op */
-}
+/* 미리 가져온 다음 페이지 검색 결과의 응답을 받았을 때 호출되는 함수. */
+static void on_response_prefetch(CURLV_STR res, void *user_data);
 
-/* `/krd` 명령어를 실행한다. */
-void sr_command_krdict_run(
-    struct discord *client,
-    const struct discord_interaction *event
-) {
-    if (event == NULL) {
-        log_error("[SAEROM] This command cannot be run in the console.");
+/* 두 오픈 API에 동시에 보낸 요청 중 하나의 응답을 받았을 때 호출되는 함수. */
+static void on_response_fanout(CURLV_STR res, void *user_data);
 
-        return;
-    } else if (event->type == DISCORD_INTERACTION_MESSAGE_COMPONENT) {
-        on_component_interaction(client, event);
+/* 작업 스레드에서 응답 데이터를 가공할 때 호출되는 함수. */
+static void on_job_work(void *data);
 
-        return;
-    }
+/* 응답 데이터의 가공이 끝났을 때 호출되는 함수. */
+static void on_job_done(void *data);
 
-    char *query = "", *part = "word", *translated = "true";
+/* 미리 가져온 응답 데이터의 가공이 끝났을 때 호출되는 함수. */
+static void on_job_prefetched(void *data);
 
-    for (int i = 0; i < event->data->options->size; i++) {
-        char *name = event->data->options->array[i].name;
-        char *value = event->data->options->array[i].value;
+/* 작업 스레드에서 두 오픈 API 중 하나의 응답 데이터를 가공할 때 호출되는 함수. */
+static void on_fanout_work(void *data);
 
-        if (streq(name, "query")) query = value;
-        else if (streq(name, "part")) part = value;
-        else if (streq(name, "translated")) translated = value;
-    }
+/* 두 오픈 API 중 하나의 응답 데이터의 가공이 끝났을 때 호출되는 함수. */
+static void on_fanout_done(void *data);
 
-    sr_command_krdict_create_request(client, event, on_response, query, part, translated);
+/* 작업 스레드에서 사전 데이터의 표제어 목록으로 색인을 만들 때 호출되는 함수. */
+static void on_headwords_work(void *data);
 
-    discord_create_interaction_response(
-        client, 
-        event->id, 
-        event->token, 
-        &(struct discord_interaction_response) {
-            .type = DISCORD_INTERACTION_DEFERRED_CHANNEL_MESSAGE_WITH_SOURCE
-        },
-        NULL
-    );
-}
+/* 사전 데이터의 표제어 색인을 다 만들었을 때 호출되는 함수. */
+static void on_headwords_done(void *data);
+
+/* 작업 스레드에서 검색어 자동 완성 색인에 새로운 검색어들을 합칠 때 호출되는 함수. */
+static void on_suggest_work(void *data);
+
+/* 검색어 자동 완성 색인에 새로운 검색어들을 다 합쳤을 때 호출되는 함수. */
+static void on_suggest_done(void *data);
 
-/* `/krd` 명령어 명령어의 오픈 API 요청을 생성한다. */
-void sr_command_krdict_create_request(
+/* `/krd` 명령어의 주어진 위치부터 보여주는 검색 요청을 처리한다. */
+static void sr_command_krdict_search_page(
     struct discord *client,
     const struct discord_interaction *event,
-    curlv_read_callback on_response,
     const char *query,
     const char *part,
-    const char *translated
-) {
-    CURLV_REQ request = { .callback = on_response };
-
-    request.easy = curl_easy_init();
+    const char *translated,
+    int start
+);
 
-    char buffer[DISCORD_MAX_MESSAGE_LEN] = "";
+/* 
+    `/krd` 명령어의 첫 페이지 검색 결과를 오픈 API에 요청한다.
+    검색 결과가 없을 것이 확실하여 요청을 보내지 않았다면, 바로 응답하고 `false`를 반환한다.
+*/
+static bool sr_command_krdict_request_first_page(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *query,
+    const char *part,
+    const char *translated,
+    const char *key,
+    bool deferred
+);
 
-    // 우리말샘 오픈 API는 다국어 번역을 지원하지 않는다.
-    if (streq(part, "exam") || streq(translated, "false")) {
-        snprintf(
-            buffer, 
-            sizeof(buffer), 
-            "key=%s&q=%s&part=%s&advanced=%s",
-            sr_config_get_urms_api_key(),
-            query,
-            part,
-            (streq(part, "word")) ? "y" : "n"
-        );
+/* `/krd` 명령어의 검색 결과를 나중에 전송하겠다고 응답한다. */
+static void sr_command_krdict_defer_results(
+    struct discord *client,
+    const struct discord_interaction *event
+);
 
-        curl_easy_setopt(request.easy, CURLOPT_URL, REQUEST_URL_URMSAEM);
-    } else {
-        snprintf(
-            buffer, 
-            sizeof(buffer), 
-            "key=%s&q=%s&part=%s&advanced=%s&translated=y&trans_lang=1",
-            sr_config_get_krd_api_key(),
-            query,
-            part,
-            (streq(part, "word")) ? "y" : "n"
-        );
+/* 검색 결과의 페이지를 넘기는 버튼을 눌러 발생한 상호 작용인지 확인한다. */
+static bool sr_command_krdict_is_paging(const struct discord_interaction *event);
 
-        curl_easy_setopt(request.easy, CURLOPT_URL, REQUEST_URL_KRDICT);
-    }
+/* `/krd` 명령어의 주어진 검색 결과를 미리 가져와서 캐시에 저장한다. */
+static void sr_command_krdict_prefetch(
+    struct discord *client,
+    const char *query,
+    const char *part,
+    const char *translated,
+    int start
+);
 
-    curl_easy_setopt(request.easy, CURLOPT_POSTFIELDSIZE, strlen(buffer));
-    curl_easy_setopt(request.easy, CURLOPT_COPYPOSTFIELDS, buffer);
-    curl_easy_setopt(request.easy, CURLOPT_SSL_VERIFYPEER, false);
-    curl_easy_setopt(request.easy, CURLOPT_POST, 1);
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 반환한다. */
+static struct krdict_usage *sr_command_krdict_get_usage(void);
 
-    struct sr_command_context *context = malloc(sizeof(*context));
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 기록하는 파일의 경로를 구한다. */
+static bool sr_command_krdict_get_usage_path(char *buffer, size_t size);
 
-    context->event = discord_claim(client, event);
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 파일에서 읽는다. */
+static void sr_command_krdict_load_usage(void);
 
-    if (streq(part, "exam")) context->flags |= KRD_FLAG_PART_EXAM;
-    if (streq(translated, "true")) context->flags |= KRD_FLAG_TRANSLATED;
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 파일에 기록한다. */
+static void sr_command_krdict_save_usage(void);
 
-    request.user_data = context;
+/*
+    `/krd` 명령어의 검색 결과를 지금 주어진 오픈 API에서 미리 가져와도 되는지 확인한다.
+    가져와도 된다면, 토큰 버킷에서 토큰 하나를 사용한다.
+*/
+static bool sr_command_krdict_can_prefetch(enum krdict_source source);
 
-    curlv_create_request(sr_get_curlv(), &request);
-}
+/* `/krd` 명령어의 응답 데이터 가공 작업을 생성한다. */
+static struct krdict_job *sr_command_krdict_create_job(
+    struct sr_command_context *context,
+    CURLV_STR res
+);
 
-/* `/krd` 명령어 처리 과정에서 발생한 오류를 처리한다. */
-void sr_command_krdict_handle_error(
-    struct sr_command_context *context, 
-    const char *code
-) {
-     if (context == NULL || code == NULL) return; 
+/* `/krd` 명령어의 검색 대상과 번역 여부에 맞는 오픈 API를 반환한다. */
+static enum krdict_source sr_command_krdict_get_source(
+    const char *part, 
+    const char *translated
+);
 
-    log_warn(
-        "[SAEROM] An error (`%s`) has occured while processing the request",
-        code
-    );
+/* `/krd` 명령어의 주어진 오픈 API에 보낼 요청을 초기화한다. */
+static void sr_command_krdict_init_request(
+    CURLV_REQ *request,
+    enum krdict_source source,
+    const char *query,
+    const char *part,
+    int start
+);
 
-    struct discord *client = sr_get_client();
+/* `/krd` 명령어의 검색 요청을 한국어기초사전과 우리말샘 오픈 API에 동시에 보낸다. */
+static void sr_command_krdict_fan_out(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *query,
+    const char *part,
+    const char *translated
+);
 
-    struct discord_embed embeds[] = {
-        {
-            .title = "Results",
-            .description = "An unknown error has occured while processing "
-                           "your request.",
-            .timestamp = discord_timestamp(client),
-            .footer = &(struct discord_embed_footer) {
-                .text = "🗒️"
-            }
-        }
-    };
+/* 
+    `/krd` 명령어가 두 오픈 API에서 가져온 검색 결과를 합치고, 문자열로 변환한다.
+    한국어기초사전에 있는 표제어는 우리말샘의 검색 결과에서 빼고 합친다.
+*/
+static int sr_command_krdict_merge_results(
+    const struct krdict_fanout *fanout,
+    char *records,
+    size_t size,
+    size_t *len,
+    int *count,
+    struct sr_strbuf *sb
+);
 
-    discord_edit_original_interaction_response(
-        client,
-        sr_config_get_application_id(),
-        context->event->token,
-        &(struct discord_edit_original_interaction_response) {
-            .embeds = &(struct discord_embeds) {
-                .size = sizeof(embeds) / sizeof(*embeds),
-                .array = embeds
-            }
-        },
-        NULL
-    );
+/* `/krd` 명령어가 두 오픈 API에서 지금까지 가져온 검색 결과를 합쳐서 전송한다. */
+static void sr_command_krdict_show_fanout(
+    struct discord *client,
+    struct krdict_fanout *fanout
+);
 
-    discord_unclaim(client, context->event);
+/* `/krd` 명령어의 직렬화된 검색 결과에 주어진 표제어가 있는지 확인한다. */
+static bool sr_command_krdict_has_word(
+    const char *records,
+    size_t len,
+    const struct krdict_span *word
+);
 
-    free(context);
-}
+/* `/krd` 명령어의 조건 플래그를 반환한다. */
+static u64bitmask sr_command_krdict_get_flags(
+    const char *part, 
+    const char *translated
+);
 
-/* `/krd` 명령어의 응답 데이터를 가공한다. */
-int sr_command_krdict_parse_data(
-    CURLV_STR xml, 
-    char *buffer, 
+/* `/krd` 명령어의 캐시 키를 생성한다. */
+static void sr_command_krdict_get_cache_key(
+    char *buffer,
     size_t size,
-    u64bitmask flags
-) {
-    if (xml.len == 0 || buffer == NULL) return 0;
-
-    yxml_t *parser = malloc(sizeof(*parser) + xml.len);
-
-    yxml_init(parser, parser + 1, xml.len);
+    const char *query,
+    const char *part,
+    const char *translated,
+    int start
+);
 
-    struct krdict_item item = { .word = "" };
+/* `/krd` 명령어의 캐시 키에서 검색 대상과 번역 여부를 추출하고, 검색어를 반환한다. */
+static const char *sr_command_krdict_split_cache_key(
+    const char *key,
+    const char **part,
+    const char **translated
+);
 
-    char content[DISCORD_MAX_MESSAGE_LEN] = "";
+/* `/krd` 명령어의 캐시 키에서 검색 결과의 시작 위치를 추출한다. */
+static int sr_command_krdict_get_start(const char *key);
 
-    char *elem, *temp, *ptr;
+/* `/krd` 명령어의 검색 결과를 오픈 API에 요청을 보내지 않고 찾는다. */
+static bool sr_command_krdict_search_local(
+    const char *query,
+    const char *key,
+    u64bitmask flags,
+    char *buffer,
+    size_t size,
+    int *total,
+    int *count
+);
 
-    int len, num, total, order = 1;
+/* `/krd` 명령어의 검색 결과 앞에 바꾼 검색어로 찾은 결과라는 안내 문구를 추가한다. */
+static void sr_command_krdict_add_note(char *buffer, size_t size, const char *key);
 
-    for (char *doc = xml.str; *doc; doc++) {
-        yxml_ret_t result = yxml_parse(parser, *doc);
+/* `/krd` 명령어의 캐시에서 검색 결과를 읽는다. */
+static bool sr_command_krdict_read_cache(
+    const char *key,
+    u64bitmask flags,
+    char *buffer,
+    size_t size,
+    int *total,
+    int *count
+);
 
-        if (result < 0) {
-            strncpy(buffer, "-1", size);
+/* `/krd` 명령어의 오프라인 사전 데이터에서 검색 결과를 읽는다. */
+static bool sr_command_krdict_read_dict(
+    const char *query,
+    u64bitmask flags,
+    char *buffer,
+    size_t size,
+    int *total,
+    int *count
+);
 
-            free(parser);
+/* `/krd` 명령어의 오프라인 사전 데이터에서 활용형 검색어의 기본형을 찾는다. */
+static bool sr_command_krdict_find_lemma(
+    const char *query,
+    u64bitmask flags,
+    char *buffer,
+    size_t size
+);
 
-            return -1;
-        }
+/* `/krd` 명령어의 캐시에 검색 결과를 저장한다. */
+static void sr_command_krdict_write_cache(
+    const char *key,
+    const char *records,
+    size_t records_len,
+    const char *buffer,
+    int total,
+    int count
+);
 
-        switch (result) {
-            case YXML_ELEMSTART:
-                elem = parser->elem;
-                ptr = content;
+/* 사전 데이터의 표제어 목록으로 검색어 자동 완성 색인과 블룸 필터를 만든다. */
+static void sr_command_krdict_init_headwords(void);
 
-                break;
+/* 
+    주어진 사전 데이터의 표제어 목록으로 작업 스레드에서 색인을 만든다.
+    `suggest`가 `NULL`이라면, 블룸 필터만 다시 만든다.
+*/
+static void sr_command_krdict_build_headwords(
+    struct sr_dict_snapshot *snapshot, 
+    struct sr_suggest *suggest
+);
 
-            case YXML_CONTENT:
-                temp = parser->data;
+/* 표제어를 블룸 필터에서 사용하는 형태로 바꾼다. */
+static void sr_command_krdict_fold_word(const char *word, char *buffer, size_t size);
 
-                while (*temp != 0) {
-                    if (*temp == '\n' || *temp == '\t') {
-                        temp++;
+/* `/krd` 명령어의 검색 결과가 없을 것이 확실한지 확인한다. */
+static bool sr_command_krdict_is_known_miss(const char *key, u64bitmask flags);
 
-                        continue;
-                    }
+/* `/krd` 명령어의 캐시 키에서 표제어 검색의 검색어를 추출한다. */
+static const char *sr_command_krdict_get_query(const char *key);
 
-                    *(ptr++) = *(temp++);
-                }
+/* `/krd` 명령어의 검색 결과가 있는 검색어를 자동 완성 색인에 기록한다. */
+static void sr_command_krdict_record_query(const char *key, int total);
 
-                break;
+/* `/krd` 명령어의 개별 검색 결과를 직렬화하여 추가한다. */
+static size_t sr_command_krdict_pack_item(
+    char *records,
+    size_t size,
+    size_t len,
+    const struct krdict_item *item,
+    int order
+);
 
-            case YXML_ELEMEND:
-                *ptr = 0;
-
-                if (streq(parser->elem, "error")) {
-                    strncpy(buffer, content, size);
-
-                    free(parser);
+/* 
+    `/krd` 명령어의 응답 데이터에서 개별 검색 결과를 추출하고, 문자열로 변환한다.
+    `count`에는 보여준 항목의 개수를 저장한다.
+    오류가 발생했다면, 오류 코드를 문자열 버퍼에 저장하고 `-1`을 반환한다.
+*/
+static int sr_command_krdict_parse_items(
+    CURLV_STR xml, 
+    char *records, 
+    size_t size,
+    size_t *len,
+    int *count,
+    char *buffer,
+    size_t buffer_size,
+    u64bitmask flags
+);
 
-                    return -1;
-                }
+/* `/krd` 명령어의 응답 데이터에서 사용하는 요소의 이름을 번호로 바꾼다. */
+static enum krdict_element sr_command_krdict_find_element(const char *name);
 
-                if (streq(parser->elem, "channel")) {
-                    if (streq(elem, "total")) {
-                        total = atoi(content);
+/* `/krd` 명령어의 응답 데이터의 구조를 나타내는 해시 테이블이 올바른지 확인한다. */
+static void sr_command_krdict_check_schema(void);
 
-                        if (total <= 0) break;
-                    } else if (streq(elem, "num")) {
-                        num = atoi(content);
+/* `/krd` 명령어의 응답 데이터를 나누어 읽는 파서를 초기화한다. */
+static void sr_command_krdict_parser_init(
+    struct krdict_parser *parser,
+    char *records, 
+    size_t size,
+    char *buffer,
+    size_t buffer_size,
+    u64bitmask flags
+);
 
-                        if (total > num) total = num;
-                    }
+/* 
+    `/krd` 명령어의 응답 데이터의 일부를 읽는다. 
+    오류가 발생했다면 `-1`을, 더 읽을 필요가 없다면 `1`을, 그 외에는 `0`을 반환한다.
+*/
+static int sr_command_krdict_parser_feed(
+    struct krdict_parser *parser,
+    const char *data,
+    size_t len
+);
 
-                    break;
-                }
+/* `/krd` 명령어의 응답 데이터에서 현재 읽고 있는 요소의 위치를 반환한다. */
+static enum krdict_context sr_command_krdict_parser_context(
+    const struct krdict_parser *parser
+);
 
-                // 검색 결과로 어휘를 출력할 경우?
-                if (!(flags & KRD_FLAG_PART_EXAM)) {
-                    if (order > MAX_ORDER_COUNT) break;
-
-                    if (streq(elem, "word"))
-                        strncpy(item.word, content, sizeof(item.word));
-                    else if (streq(elem, "pos"))
-                        strncpy(item.pos, content, sizeof(item.pos));
-                    else if (streq(elem, "link"))
-                        strncpy(item.link, content, sizeof(item.link));
-                    else if (streq(elem, "origin"))
-                        strncpy(item.origin, content, sizeof(item.origin));
-                    else if (streq(elem, "sense_order") || streq(elem, "sense_no"))
-                        order = atoi(content);
-                    else if (streq(elem, "definition") || streq(elem, "trans_word"))
-                        strncpy(item.dfn, content, sizeof(item.dfn));
-                    else if (streq(elem, "trans_dfn"))
-                        strncpy(item.exam, content, sizeof(item.exam));
-                    else if (streq(elem, "sense")) {
-                        char *item_pos = strlen(item.pos) > 0 ? item.pos : "?";
-
-                        len = strlen(buffer);
-
-                        if (strlen(item.origin) > 0) {
-                            snprintf(
-                                buffer + len, 
-                                size - len,
-                                "[**%s (%s) 「%s」**](%s)\n\n",
-                                item.word,
-                                item.origin,
-                                item_pos,
-                                item.link
-                            );
-                        } else {
-                            snprintf(
-                                buffer + len, 
-                                size - len,
-                                "[**%s 「%s」**](%s)\n\n",
-                                item.word,
-                                item_pos,
-                                item.link
-                            );
-                        }
-
-                        len = strlen(buffer);
-
-                        if (flags & KRD_FLAG_TRANSLATED) {
-                            snprintf(
-                                buffer + len, 
-                                size - len,
-                                "**%d. %s**\n"
-                                "- %s\n\n",
-                                order,
-                                item.dfn,
-                                item.exam
-                            );
-                        } else {
-                            snprintf(
-                                buffer + len, 
-                                size - len,
-                                "- %s\n\n",
-                                item.dfn
-                            );
-                        }
-                    }
-                } else {
-                    if (order > MAX_EXAMPLE_COUNT) break;
-
-                    if (streq(elem, "word"))
-                        strncpy(item.word, content, sizeof(item.word));
-                    else if (streq(elem, "example"))
-                        strncpy(item.exam, content, sizeof(item.exam));
-                    else if (streq(elem, "link")) {
-                        strncpy(item.link, content, sizeof(item.link));
-
-                        len = strlen(buffer);
-
-                        snprintf(
-                            buffer + len, 
-                            size - len,
-                            "%d. %s\n\n",
-                            order,
-                            item.exam
-                        );
-
-                        order++;
-                    }
-                }
+/* `/krd` 명령어의 응답 데이터에서 요소 하나를 다 읽었을 때 호출되는 함수. */
+static int sr_command_krdict_parser_end_element(struct krdict_parser *parser);
 
-                elem = parser->elem;
+/* `/krd` 명령어의 개별 검색 결과를 직렬화하여 추가하고, 문자열로 변환한다. */
+static void sr_command_krdict_parser_add_item(struct krdict_parser *parser);
 
-                break;
-        }
+/* `/krd` 명령어의 개별 검색 결과 하나를 문자열로 변환하여 추가한다. */
+static void sr_command_krdict_render_item(
+    const struct krdict_item *item,
+    int order,
+    struct sr_strbuf *sb,
+    u64bitmask flags
+);
 
-        if (total <= 0) break;
-    }
+/* `/krd` 명령어의 개별 검색 결과를 문자열로 변환하고, 보여준 항목의 개수를 반환한다. */
+static int sr_command_krdict_render_items(
+    const char *records,
+    size_t len,
+    struct sr_strbuf *sb,
+    u64bitmask flags
+);
 
-    free(parser);
+/* `/krd` 명령어의 직렬화된 검색 결과 하나를 읽고, 다음 검색 결과의 위치를 반환한다. */
+static const char *sr_command_krdict_unpack_item(
+    const char *ptr,
+    const char *end,
+    struct krdict_item *item,
+    int *order
+);
 
-    return total;
-}
+/* `/krd` 명령어를 생성한다. */
+void sr_command_krdict_init(struct discord *client) {
+    sr_command_krdict_check_schema();
+
+    const size_t budget = sr_config_get_krdict_cache_budget();
+    const uint64_t ttl = sr_config_get_krdict_cache_ttl();
+
+    /*
+        출력 결과는 자주 사용되므로 작게, 가공된 검색 결과는 오래 보관한다.
+        출력 결과는 가공된 검색 결과로부터 다시 만들 수 있으므로, 
+        가공된 검색 결과만 파일에 기록하여 다시 시작한 뒤에도 사용한다.
+    */
+    result_cache = sr_cache_create(budget / 4, ttl, SR_CACHE_POLICY_LRU);
+
+    item_cache = sr_cache_open(
+        sr_config_get_krdict_cache_path(),
+        budget - (budget / 4) - (budget / 16), 
+        ttl, 
+        SR_CACHE_POLICY_LRU
+    );
 
-/* 개인 메시지 전송에 성공했을 때 호출되는 함수. */
-static void on_message_success(
-    struct discord *client, 
-    struct discord_response *resp,
-    const struct discord_message *msg
-) {
-    if (resp->data == NULL) return;
+    // 검색 결과가 없는 검색어는 사전에 새로 추가될 수도 있으므로, 짧은 기간 동안만 보관한다.
+    miss_cache = sr_cache_create(
+        budget / 16, 
+        sr_config_get_krdict_cache_negative_ttl(), 
+        SR_CACHE_POLICY_LRU
+    );
 
-    struct discord_interaction *event = resp->data;
+    dictionary = sr_dict_open(sr_config_get_krdict_dict_path());
 
-    struct discord_embed embeds[] = {
-        {
-            .title = "Results",
-            .description = "Sent you a direct message!",
-            .timestamp = discord_timestamp(client),
-            .footer = &(struct discord_embed_footer) {
-                .text = "🗒️"
-            }
-        }
-    };
+    sr_command_krdict_load_usage();
 
-    struct discord_interaction_response params = {
-        .type = DISCORD_INTERACTION_CHANNEL_MESSAGE_WITH_SOURCE,
-        .data = &(struct discord_interaction_callback_data) { 
-            .flags = DISCORD_MESSAGE_EPHEMERAL,
-            .embeds = &(struct discord_embeds) {
-                .size = sizeof(embeds) / sizeof(*embeds),
-                .array = embeds
-            }
-        }
-    };
+    sr_command_krdict_init_headwords();
 
-    discord_create_interaction_response(
-        client, 
-        event->id, 
-        event->token, 
-        &params, 
+    discord_create_global_application_command(
+        client,
+        sr_config_get_application_id(),
+        &params,
         NULL
     );
 }
 
-/* 개인 메시지 전송에 실패했을 때 호출되는 함수. */
-static void on_message_failure(
-    struct discord *client, 
-    struct discord_response *resp
-) {
-    if (resp->data == NULL) return;
-    
-    struct discord_interaction *event = resp->data;
+/* `/krd` 명령어에 할당된 메모리를 해제한다. */
+void sr_command_krdict_cleanup(struct discord *client) {
+    sr_command_krdict_save_usage();
 
-    struct discord_embed embeds[] = {
-        {
-            .title = "Results",
-            .description = "Failed to send you a direct message. "
-                           "Please check your privacy settings!",
-            .timestamp = discord_timestamp(client),
-            .footer = &(struct discord_embed_footer) {
-                .text = "🗒️"
-            }
-        }
-    };
+    sr_cache_release(result_cache);
+    sr_cache_release(item_cache);
+    sr_cache_release(miss_cache);
 
-    struct discord_interaction_response params = {
-        .type = DISCORD_INTERACTION_CHANNEL_MESSAGE_WITH_SOURCE,
-        .data = &(struct discord_interaction_callback_data) { 
-            .flags = DISCORD_MESSAGE_EPHEMERAL,
-            .embeds = &(struct discord_embeds) {
-                .size = sizeof(embeds) / sizeof(*embeds),
-                .array = embeds
-            }
-        }
-    };
+    result_cache = item_cache = miss_cache = NULL;
 
-    discord_create_interaction_response(
-        client, 
-        event->id, 
-        event->token, 
-        &params, 
-        NULL
-    );
+    sr_dict_close(dictionary);
+
+    dictionary = NULL;
+
+    const char *path = sr_config_get_krdict_autocomplete_path();
+
+    if (*path != '\0' && !sr_suggest_save(suggestions, path))
+        log_warn("[SAEROM] Failed to save the query log to \"%s\"", path);
+
+    sr_suggest_release(suggestions);
+    sr_bloom_release(headwords);
+
+    suggestions = NULL;
+    headwords = NULL;
 }
 
-/* 개인 메시지 전송이 끝났을 때 호출되는 함수. */
-static void on_message_complete(struct discord *client, void *data) {
-    discord_unclaim(client, (struct discord_interaction *) data);
+/* Discord 봇이 대기 중일 때 `/krd` 명령어의 기한이 지난 요청과 미뤄 둔 요청을 처리한다. */
+void sr_command_krdict_idle(struct discord *client) {
+    const uint64_t now = cog_timestamp_ms();
+
+    for (struct krdict_fanout *fanout = fanouts; fanout != NULL; fanout = fanout->next) {
+        if (fanout->sent || now <= fanout->deadline) continue;
+
+        bool answered = false;
+
+        for (int i = 0; i < KRD_SOURCE_COUNT_; i++)
+            if (fanout->results[i].done && fanout->results[i].total >= 0) answered = true;
+
+        /*
+            기한이 지날 때까지 검색 결과를 보여주지 못했다면, 지금까지 도착한 검색 결과를 보여준다.
+            나머지 요청은 계속 기다리고, 검색 결과가 도착하면 다시 보여준다.
+        */
+        if (answered) sr_command_krdict_show_fanout(client, fanout);
+    }
+
+    if (usage_dirty && now - usage_saved_at >= USAGE_SAVE_INTERVAL) 
+        sr_command_krdict_save_usage();
+
+    // 자동 완성 색인에 새로운 검색어가 모였다면, 작업 스레드에서 한꺼번에 합친다.
+    if (sr_suggest_begin_merge(suggestions))
+        sr_worker_push_idle(on_suggest_work, on_suggest_done, suggestions);
+
+    if (request_count > 0 || deferred_count == 0) return;
+
+    const int count = deferred_count;
+
+    deferred_count = 0;
+
+    // 사용자의 검색 요청을 모두 처리했다면, 미뤄 둔 검색 결과를 미리 가져온다.
+    for (int i = 0; i < count; i++)
+        sr_command_krdict_prefetch(
+            client, 
+            deferred_prefetches[i].query, 
+            deferred_prefetches[i].part, 
+            deferred_prefetches[i].translated, 
+            deferred_prefetches[i].start
+        );
 }
 
-/* 컴포넌트와의 상호 작용 시에 호출되는 함수. */
-static void on_component_interaction(
+/* `/krd` 명령어를 실행한다. */
+void sr_command_krdict_run(
     struct discord *client,
     const struct discord_interaction *event
 ) {
-    struct discord_channel ret_channel = { .id = 0 };
+    if (event == NULL) {
+        log_error("[SAEROM] This command cannot be run in the console.");
 
-    const struct discord_user *user = (event->member != NULL)
-        ? event->member->user
-        : event->user;
+        return;
+    } else if (event->type == DISCORD_INTERACTION_MESSAGE_COMPONENT) {
+        on_component_interaction(client, event);
 
-    CCORDcode result = discord_create_dm(
-        client,
-        &(struct discord_create_dm) {
-            .recipient_id = user->id
-        },
-        &(struct discord_ret_channel) {
-            .sync = &ret_channel
-        }
-    );
+        return;
+    } else if (event->type == DISCORD_INTERACTION_APPLICATION_COMMAND_AUTOCOMPLETE) {
+        on_autocomplete(client, event);
 
-    if (result != CCORD_OK) return;
+        return;
+    }
 
-    discord_channel_cleanup(&ret_channel);
-    
-    discord_create_message(
-        client, 
-        ret_channel.id,
-        &(struct discord_create_message) {
-            .embeds = event->message->embeds
-        },
-        &(struct discord_ret_message) {
-            .data = (void *) discord_claim(client, event),
-            .cleanup = on_message_complete,
-            .done = on_message_success,
-            .fail = on_message_failure
-        }
-    );
-}
+    char *query = "", *part = "word", *translated = "true";
 
-/* 요청 URL에서 응답을 받았을 때 호출되는 함수. */
-static void on_response(CURLV_STR res, void *user_data) {
-    if (res.str == NULL || user_data == NULL) return;
+    for (int i = 0; i < event->data->options->size; i++) {
+        char *name = event->data->options->array[i].name;
+        char *value = event->data->options->array[i].value;
 
-    struct sr_command_context *context = (struct sr_command_context *) user_data;
+        if (streq(name, "query")) query = value;
+        else if (streq(name, "part")) part = value;
+        else if (streq(name, "translated")) translated = value;
+    }
 
-    bool request_url_check = (context->flags & KRD_FLAG_PART_EXAM)
-        || !(context->flags & KRD_FLAG_TRANSLATED);
+    sr_command_krdict_search(client, event, query, part, translated);
+}
 
-    log_info(
-        "[SAEROM] Received %ld bytes from \"%s\"", 
-        res.len,
-        request_url_check 
-            ? REQUEST_URL_URMSAEM 
-            : REQUEST_URL_KRDICT
+/* `/krd` 명령어의 검색 요청을 처리한다. */
+void sr_command_krdict_search(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *query,
+    const char *part,
+    const char *translated
+) {
+    sr_command_krdict_search_page(client, event, query, part, translated, 1);
+}
+
+/* `/krd` 명령어 명령어의 오픈 API 요청을 생성하고, 응답을 처리할 때 사용할 정보를 반환한다. */
+struct sr_command_context *sr_command_krdict_create_request(
+    struct discord *client,
+    const struct discord_interaction *event,
+    curlv_read_callback on_response,
+    const char *query,
+    const char *part,
+    const char *translated,
+    int start
+) {
+    CURLV_REQ request = { 
+        .callback = (on_response != NULL) ? on_response : on_response_default 
+    };
+
+    sr_command_krdict_init_request(
+        &request, 
+        sr_command_krdict_get_source(part, translated), 
+        query, 
+        part, 
+        start
     );
 
-    char buffer[DISCORD_EMBED_DESCRIPTION_LEN] = "";
+    struct sr_command_context *context = calloc(1, sizeof(*context));
 
-    int total = sr_command_krdict_parse_data(
-        res, 
-        buffer, 
-        sizeof(buffer), 
-        context->flags
+    // 미리 가져오는 요청은 응답할 상호 작용이 없다.
+    context->event = (event != NULL) ? discord_claim(client, event) : NULL;
+
+    if (event != NULL) request_count++;
+    context->flags = sr_command_krdict_get_flags(part, translated);
+    context->data = malloc(2 * MAX_STRING_SIZE);
+
+    sr_command_krdict_get_cache_key(
+        context->data, 
+        2 * MAX_STRING_SIZE, 
+        query, 
+        part, 
+        translated,
+        start
     );
 
-    struct discord_component buttons[] = {
-        {
-            .type = DISCORD_COMPONENT_BUTTON,
-            .style = DISCORD_BUTTON_SECONDARY,
-            .label = "🔖 Bookmark",
-            .custom_id = "krd_btn_uwu"
-        }
-    };
+    request.user_data = context;
 
-    struct discord_component action_rows[] = {
-        {
-            .type = DISCORD_COMPONENT_ACTION_ROW,
-            .components = &(struct discord_components){
-                .size = sizeof(buttons) / sizeof(*buttons),
-                .array = buttons
-            }
-        },
-    };
+    curlv_create_request(sr_get_curlv(), &request);
+
+    return context;
+}
+
+/* `/krd` 명령어 처리 과정에서 발생한 오류를 처리한다. */
+void sr_command_krdict_handle_error(
+    struct sr_command_context *context, 
+    const char *code
+) {
+     if (context == NULL || code == NULL) return; 
+
+    log_warn(
+        "[SAEROM] An error (`%s`) has occured while processing the request",
+        code
+    );
 
     struct discord *client = sr_get_client();
 
     struct discord_embed embeds[] = {
         {
             .title = "Results",
+            .description = "An unknown error has occured while processing "
+                           "your request.",
             .timestamp = discord_timestamp(client),
             .footer = &(struct discord_embed_footer) {
                 .text = "🗒️"
@@ -636,22 +1016,11 @@ static void on_response(CURLV_STR res, void *user_data) {
         }
     };
 
-    if (total < 0) {
-        sr_command_krdict_handle_error(context, buffer);
-
-        return;
-    } else if (total == 0) embeds[0].description = "No results found.";
-    else embeds[0].description = buffer;
-
     discord_edit_original_interaction_response(
         client,
         sr_config_get_application_id(),
         context->event->token,
         &(struct discord_edit_original_interaction_response) {
-            .components = &(struct discord_components){
-                .size = (total > 0) ? sizeof(action_rows) / sizeof(*action_rows) : 0,
-                .array = action_rows
-            },
             .embeds = &(struct discord_embeds) {
                 .size = sizeof(embeds) / sizeof(*embeds),
                 .array = embeds
@@ -662,5 +1031,2732 @@ static void on_response(CURLV_STR res, void *user_data) {
 
     discord_unclaim(client, context->event);
 
+    free(context->data);
     free(context);
+}
+
+/*
+    `/krd` 명령어의 검색 결과를 전송한다. `count`는 이 페이지에서 보여준 항목의 개수이다.
+    검색 결과가 없다면, 캐시 키의 검색어와 비슷한 표제어들을 함께 보여준다.
+*/
+void sr_command_krdict_send_results(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *key,
+    const char *buffer,
+    int total,
+    int count,
+    bool deferred
+) {
+    const int start = sr_command_krdict_get_start(key);
+
+    /*
+        다음 페이지는 이 페이지에서 보여주지 못한 첫 번째 항목부터 보여준다.
+        이전 페이지는 이 페이지의 첫 번째 항목 바로 앞까지의 항목들을 보여준다.
+    */
+    const int starts[2] = {
+        (start > PAGE_ITEM_COUNT) ? start - PAGE_ITEM_COUNT : 1,
+        start + ((count > 0) ? count : 1)
+    };
+
+    const bool paged = (start > 1 || starts[1] <= total);
+
+    char page_ids[2][MAX_CUSTOM_ID_LENGTH + 1];
+
+    struct discord_component buttons[] = {
+        {
+            .type = DISCORD_COMPONENT_BUTTON,
+            .style = DISCORD_BUTTON_SECONDARY,
+            .label = "🔖 Bookmark",
+            .custom_id = "krd_btn_uwu"
+        },
+        {
+            .type = DISCORD_COMPONENT_BUTTON,
+            .style = DISCORD_BUTTON_SECONDARY,
+            .label = "◀️ Previous",
+            .custom_id = page_ids[0]
+        },
+        {
+            .type = DISCORD_COMPONENT_BUTTON,
+            .style = DISCORD_BUTTON_SECONDARY,
+            .label = "Next ▶️",
+            .custom_id = page_ids[1]
+        }
+    };
+
+    struct discord_component action_rows[] = {
+        {
+            .type = DISCORD_COMPONENT_ACTION_ROW,
+            .components = &(struct discord_components){
+                .size = paged ? sizeof(buttons) / sizeof(*buttons) : 1,
+                .array = buttons
+            }
+        },
+    };
+
+    const char *part = NULL, *translated = NULL;
+
+    const char *page_query = sr_command_krdict_split_cache_key(key, &part, &translated);
+
+    // 페이지를 넘기는 버튼의 ID는 이전 페이지와 다음 페이지의 캐시 키로 만든다.
+    for (int i = 0; i < 2; i++) {
+        char target_key[2 * MAX_STRING_SIZE] = "";
+
+        if (page_query != NULL)
+            sr_command_krdict_get_cache_key(
+                target_key, 
+                sizeof(target_key), 
+                page_query, 
+                part, 
+                translated, 
+                starts[i]
+            );
+
+        const int custom_id_len = snprintf(
+            page_ids[i], 
+            sizeof(page_ids[i]), 
+            "krd_pg_%s", 
+            target_key
+        );
+
+        // 버튼의 ID가 너무 길다면, 그 페이지로는 넘길 수 없다.
+        buttons[i + 1].disabled = (page_query == NULL 
+            || ((i == 0) ? start <= 1 : starts[i] > total || starts[i] > MAX_START_INDEX)
+            || custom_id_len >= sizeof(page_ids[i]));
+
+        // 누를 수 없는 버튼도 메시지 안에서 서로 다른 ID를 가져야 한다.
+        if (buttons[i + 1].disabled) snprintf(page_ids[i], sizeof(page_ids[i]), "krd_pg_%d", i);
+    }
+
+    char footer[MAX_STRING_SIZE] = "🗒️";
+
+    // 페이지마다 보여주는 항목의 개수가 다르므로, 페이지 번호 대신 항목의 범위를 보여준다.
+    if (paged) 
+        snprintf(footer, sizeof(footer), "🗒️ %d-%d / %d", start, starts[1] - 1, total);
+
+    struct discord_embed embeds[] = {
+        {
+            .title = "Results",
+            .timestamp = discord_timestamp(client),
+            .footer = &(struct discord_embed_footer) {
+                .text = footer
+            }
+        }
+    };
+
+    const bool empty = (total == 0 && (buffer == NULL || *buffer == '\0'));
+
+    if (empty) embeds[0].description = "No results found.";
+    else embeds[0].description = (char *) buffer;
+
+    struct discord_components components = {
+        .size = (total > 0) ? sizeof(action_rows) / sizeof(*action_rows) : 0,
+        .array = action_rows
+    };
+
+    struct discord_component corrections[MAX_CORRECTION_COUNT];
+
+    char custom_ids[MAX_CORRECTION_COUNT][MAX_CUSTOM_ID_LENGTH + 1];
+
+    const char *query = sr_command_krdict_get_query(key);
+
+    // 검색 결과가 없다면, 오타를 고친 표제어로 다시 검색할 수 있게 한다.
+    if (empty && query != NULL) {
+        const char *words[MAX_CORRECTION_COUNT];
+
+        const int count = sr_suggest_correct(
+            suggestions, 
+            query, 
+            words, 
+            MAX_CORRECTION_COUNT
+        );
+
+        int len = 0;
+
+        for (int i = 0; i < count; i++) {
+            // 번역 여부는 원래 검색어의 캐시 키를 따른다.
+            int custom_id_len = snprintf(
+                custom_ids[len], 
+                sizeof(custom_ids[len]), 
+                "krd_sug_%c_%s", 
+                key[5], 
+                words[i]
+            );
+
+            if (custom_id_len >= sizeof(custom_ids[len])
+                || utf8len(words[i]) > MAX_LABEL_LENGTH) continue;
+
+            corrections[len] = (struct discord_component) {
+                .type = DISCORD_COMPONENT_BUTTON,
+                .style = DISCORD_BUTTON_SECONDARY,
+                .label = (char *) words[i],
+                .custom_id = custom_ids[len]
+            };
+
+            len++;
+        }
+
+        if (len > 0) {
+            embeds[0].description = "No results found. Did you mean...";
+
+            action_rows[0].components->size = len;
+            action_rows[0].components->array = corrections;
+
+            components.size = 1;
+        }
+    }
+
+    if (deferred) {
+        discord_edit_original_interaction_response(
+            client,
+            sr_config_get_application_id(),
+            event->token,
+            &(struct discord_edit_original_interaction_response) {
+                .components = &components,
+                .embeds = &(struct discord_embeds) {
+                    .size = sizeof(embeds) / sizeof(*embeds),
+                    .array = embeds
+                }
+            },
+            NULL
+        );
+    } else {
+        // 페이지를 넘기는 버튼을 눌렀다면, 새로운 메시지 대신 원래 메시지를 바꾼다.
+        struct discord_interaction_response params = {
+            .type = sr_command_krdict_is_paging(event)
+                ? DISCORD_INTERACTION_UPDATE_MESSAGE
+                : DISCORD_INTERACTION_CHANNEL_MESSAGE_WITH_SOURCE,
+            .data = &(struct discord_interaction_callback_data) { 
+                .components = &components,
+                .embeds = &(struct discord_embeds) {
+                    .size = sizeof(embeds) / sizeof(*embeds),
+                    .array = embeds
+                }
+            }
+        };
+
+        discord_create_interaction_response(
+            client, 
+            event->id, 
+            event->token, 
+            &params, 
+            NULL
+        );
+    }
+
+    if (page_query == NULL) return;
+
+    // 사용자가 검색 결과를 읽는 동안, 다음 페이지의 검색 결과를 미리 가져온다.
+    if (!buttons[2].disabled) 
+        sr_command_krdict_prefetch(client, page_query, part, translated, starts[1]);
+
+    // 어휘를 검색한 사용자는 같은 검색어의 용례도 찾아볼 가능성이 높다.
+    if (start == 1 && total > 0 && streq(part, "word") 
+        && sr_config_get_krdict_prefetch_examples())
+        sr_command_krdict_prefetch(client, page_query, "exam", translated, 1);
+}
+
+/* `/krd` 명령어의 응답 데이터를 가공한다. */
+int sr_command_krdict_parse_data(
+    CURLV_STR xml, 
+    char *buffer, 
+    size_t size,
+    u64bitmask flags
+) {
+    if (xml.len == 0 || buffer == NULL) return 0;
+
+    char records[RECORD_BUFFER_SIZE];
+
+    size_t records_len = 0;
+
+    int count = 0;
+
+    return sr_command_krdict_parse_items(
+        xml, 
+        records, 
+        sizeof(records), 
+        &records_len,
+        &count,
+        buffer,
+        size,
+        flags
+    );
+}
+
+/* 개인 메시지 전송에 성공했을 때 호출되는 함수. */
+static void on_message_success(
+    struct discord *client, 
+    struct discord_response *resp,
+    const struct discord_message *msg
+) {
+    if (resp->data == NULL) return;
+
+    struct discord_interaction *event = resp->data;
+
+    struct discord_embed embeds[] = {
+        {
+            .title = "Results",
+            .description = "Sent you a direct message!",
+            .timestamp = discord_timestamp(client),
+            .footer = &(struct discord_embed_footer) {
+                .text = "🗒️"
+            }
+        }
+    };
+
+    struct discord_interaction_response params = {
+        .type = DISCORD_INTERACTION_CHANNEL_MESSAGE_WITH_SOURCE,
+        .data = &(struct discord_interaction_callback_data) { 
+            .flags = DISCORD_MESSAGE_EPHEMERAL,
+            .embeds = &(struct discord_embeds) {
+                .size = sizeof(embeds) / sizeof(*embeds),
+                .array = embeds
+            }
+        }
+    };
+
+    discord_create_interaction_response(
+        client, 
+        event->id, 
+        event->token, 
+        &params, 
+        NULL
+    );
+}
+
+/* 개인 메시지 전송에 실패했을 때 호출되는 함수. */
+static void on_message_failure(
+    struct discord *client, 
+    struct discord_response *resp
+) {
+    if (resp->data == NULL) return;
+    
+    struct discord_interaction *event = resp->data;
+
+    struct discord_embed embeds[] = {
+        {
+            .title = "Results",
+            .description = "Failed to send you a direct message. "
+                           "Please check your privacy settings!",
+            .timestamp = discord_timestamp(client),
+            .footer = &(struct discord_embed_footer) {
+                .text = "🗒️"
+            }
+        }
+    };
+
+    struct discord_interaction_response params = {
+        .type = DISCORD_INTERACTION_CHANNEL_MESSAGE_WITH_SOURCE,
+        .data = &(struct discord_interaction_callback_data) { 
+            .flags = DISCORD_MESSAGE_EPHEMERAL,
+            .embeds = &(struct discord_embeds) {
+                .size = sizeof(embeds) / sizeof(*embeds),
+                .array = embeds
+            }
+        }
+    };
+
+    discord_create_interaction_response(
+        client, 
+        event->id, 
+        event->token, 
+        &params, 
+        NULL
+    );
+}
+
+/* 개인 메시지 전송이 끝났을 때 호출되는 함수. */
+static void on_message_complete(struct discord *client, void *data) {
+    discord_unclaim(client, (struct discord_interaction *) data);
+}
+
+/* 컴포넌트와의 상호 작용 시에 호출되는 함수. */
+static void on_component_interaction(
+    struct discord *client,
+    const struct discord_interaction *event
+) {
+    const char *custom_id = event->data->custom_id;
+
+    // 오타를 고친 표제어의 버튼을 눌렀다면, 그 표제어로 다시 검색한다.
+    if (strncmp(custom_id, "krd_sug_", 8) == 0 && custom_id[8] != '\0') {
+        const char *translated = (custom_id[8] == 'y') ? "true" : "false";
+
+        sr_command_krdict_search(client, event, custom_id + 10, "word", translated);
+
+        return;
+    }
+
+    // 페이지를 넘기는 버튼을 눌렀다면, 버튼의 ID에 있는 캐시 키의 페이지를 검색한다.
+    if (sr_command_krdict_is_paging(event)) {
+        const char *part = NULL, *translated = NULL;
+
+        const char *query = sr_command_krdict_split_cache_key(
+            custom_id + 7, 
+            &part, 
+            &translated
+        );
+
+        if (query != NULL)
+            sr_command_krdict_search_page(
+                client, 
+                event, 
+                query, 
+                part, 
+                translated, 
+                sr_command_krdict_get_start(custom_id + 7)
+            );
+
+        return;
+    }
+
+    struct discord_channel ret_channel = { .id = 0 };
+
+    const struct discord_user *user = (event->member != NULL)
+        ? event->member->user
+        : event->user;
+
+    CCORDcode result = discord_create_dm(
+        client,
+        &(struct discord_create_dm) {
+            .recipient_id = user->id
+        },
+        &(struct discord_ret_channel) {
+            .sync = &ret_channel
+        }
+    );
+
+    if (result != CCORD_OK) return;
+
+    discord_channel_cleanup(&ret_channel);
+    
+    discord_create_message(
+        client, 
+        ret_channel.id,
+        &(struct discord_create_message) {
+            .embeds = event->message->embeds
+        },
+        &(struct discord_ret_message) {
+            .data = (void *) discord_claim(client, event),
+            .cleanup = on_message_complete,
+            .done = on_message_success,
+            .fail = on_message_failure
+        }
+    );
+}
+
+/* 검색어 자동 완성 요청을 받았을 때 호출되는 함수. */
+static void on_autocomplete(
+    struct discord *client,
+    const struct discord_interaction *event
+) {
+    const char *query = "";
+
+    for (int i = 0; i < event->data->options->size; i++) {
+        const struct discord_application_command_interaction_data_option *option =
+            &event->data->options->array[i];
+
+        if (option->focused && streq(option->name, "query") && option->value != NULL)
+            query = option->value;
+    }
+
+    char text[2 * MAX_STRING_SIZE] = "";
+
+    normalize_text(query, text, sizeof(text));
+
+    const char *words[MAX_CHOICE_COUNT];
+
+    // Discord는 3초 안에 응답하지 않은 자동 완성 요청을 무시한다.
+    int count = sr_suggest_find(suggestions, text, words, MAX_CHOICE_COUNT);
+
+    char converted[2 * MAX_STRING_SIZE] = "";
+
+    // 한/영 전환을 하지 않고 입력한 검색어라면, 두벌식 자판 기준으로 바꾼 검색어로 다시 찾는다.
+    if (count == 0 && sr_keyboard_to_hangul(text, converted, sizeof(converted)))
+        count = sr_suggest_find(suggestions, converted, words, MAX_CHOICE_COUNT);
+
+    struct discord_application_command_option_choice choices[MAX_CHOICE_COUNT];
+
+    char names[MAX_CHOICE_COUNT][MAX_CHOICE_LENGTH + 1];
+    char values[MAX_CHOICE_COUNT][2 * MAX_CHOICE_LENGTH + 3];
+
+    int len = 0;
+
+    for (int i = 0; i < count; i++) {
+        // 선택지의 이름과 값은 100자를 넘을 수 없다.
+        if (strlen(words[i]) > MAX_CHOICE_LENGTH) continue;
+
+        strcpy(names[len], words[i]);
+
+        // 선택지의 값은 JSON 문자열로 전달된다.
+        char *value = values[len];
+
+        *(value++) = '"';
+
+        for (const char *c = words[i]; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') *(value++) = '\\';
+
+            *(value++) = *c;
+        }
+
+        *(value++) = '"';
+        *value = '\0';
+
+        choices[len] = (struct discord_application_command_option_choice) {
+            .name = names[len],
+            .value = values[len]
+        };
+
+        len++;
+    }
+
+    discord_create_interaction_response(
+        client,
+        event->id,
+        event->token,
+        &(struct discord_interaction_response) {
+            .type = DISCORD_INTERACTION_APPLICATION_COMMAND_AUTOCOMPLETE_RESULT,
+            .data = &(struct discord_interaction_callback_data) {
+                .choices = &(struct discord_application_command_option_choices) {
+                    .size = len,
+                    .array = choices
+                }
+            }
+        },
+        NULL
+    );
+}
+
+/* 요청 URL에서 응답을 받았을 때 호출되는 함수. */
+static void on_response_default(CURLV_STR res, void *user_data) {
+    if (user_data == NULL) return;
+
+    request_count--;
+
+    struct sr_command_context *context = (struct sr_command_context *) user_data;
+
+    // 연결에 실패했거나 시간이 초과되어 응답 데이터가 없다면, 오류를 대신 보여준다.
+    if (res.str == NULL) {
+        sr_command_krdict_handle_error(context, "-1");
+
+        return;
+    }
+
+    bool request_url_check = (context->flags & KRD_FLAG_PART_EXAM)
+        || !(context->flags & KRD_FLAG_TRANSLATED);
+
+    log_info(
+        "[SAEROM] Received %ld bytes from \"%s\"", 
+        res.len,
+        request_url_check 
+            ? REQUEST_URL_URMSAEM 
+            : REQUEST_URL_KRDICT
+    );
+
+    sr_worker_push(on_job_work, on_job_done, sr_command_krdict_create_job(context, res));
+}
+
+/* 두벌식 자판 기준으로 바꾼 검색어의 응답을 받았을 때 호출되는 함수. */
+static void on_response_converted(CURLV_STR res, void *user_data) {
+    if (user_data == NULL) return;
+
+    struct sr_command_context *context = (struct sr_command_context *) user_data;
+
+    context->flags |= KRD_FLAG_CONVERTED;
+
+    on_response_default(res, user_data);
+}
+
+/* 미리 가져온 다음 페이지 검색 결과의 응답을 받았을 때 호출되는 함수. */
+static void on_response_prefetch(CURLV_STR res, void *user_data) {
+    if (user_data == NULL) return;
+
+    struct sr_command_context *context = (struct sr_command_context *) user_data;
+
+    if (res.str == NULL) {
+        prefetch_count--;
+
+        free(context->data);
+        free(context);
+
+        return;
+    }
+
+    log_info(
+        "[SAEROM] Prefetched %ld bytes for \"%s\"", 
+        res.len,
+        (const char *) context->data
+    );
+
+    // 미리 가져온 검색 결과는 다른 응답 데이터를 모두 가공한 뒤에 가공한다.
+    sr_worker_push_idle(
+        on_job_work, 
+        on_job_prefetched, 
+        sr_command_krdict_create_job(context, res)
+    );
+}
+
+/* 두 오픈 API에 동시에 보낸 요청 중 하나의 응답을 받았을 때 호출되는 함수. */
+static void on_response_fanout(CURLV_STR res, void *user_data) {
+    if (user_data == NULL) return;
+
+    struct krdict_fanout_job *job = (struct krdict_fanout_job *) user_data;
+
+    request_count--;
+
+    // 응답을 받지 못한 요청도 가공이 끝난 것으로 보아야, 나머지 요청의 응답을 보여줄 수 있다.
+    job->res.len = (res.str != NULL) ? res.len : 0;
+    job->res.str = malloc(job->res.len + 1);
+
+    if (res.str != NULL) memcpy(job->res.str, res.str, res.len + 1);
+    else *job->res.str = '\0';
+
+    log_info(
+        "[SAEROM] Received %ld bytes from \"%s\"", 
+        job->res.len,
+        (job->source == KRD_SOURCE_URMSAEM)
+            ? REQUEST_URL_URMSAEM 
+            : REQUEST_URL_KRDICT
+    );
+
+    sr_worker_push(on_fanout_work, on_fanout_done, job);
+}
+
+/* 작업 스레드에서 응답 데이터를 가공할 때 호출되는 함수. */
+static void on_job_work(void *data) {
+    struct krdict_job *job = data;
+
+    struct sr_command_context *context = job->context;
+
+    char records[RECORD_BUFFER_SIZE];
+
+    size_t records_len = 0;
+
+    job->total = sr_command_krdict_parse_items(
+        job->res, 
+        records, 
+        sizeof(records), 
+        &records_len,
+        &job->count,
+        job->buffer, 
+        sizeof(job->buffer), 
+        context->flags
+    );
+
+    if (job->total <= 0) {
+        // 오류가 발생했거나 응답 데이터가 없다면, 검색 결과가 없는 것으로 보지 않는다.
+        if (job->total == 0 && job->res.len > 0) 
+            sr_command_krdict_write_cache(context->data, records, 0, job->buffer, 0, 0);
+
+        return;
+    }
+
+    sr_command_krdict_write_cache(
+        context->data, 
+        records, 
+        records_len, 
+        job->buffer, 
+        job->total,
+        job->count
+    );
+}
+
+/* 응답 데이터의 가공이 끝났을 때 호출되는 함수. */
+static void on_job_done(void *data) {
+    struct krdict_job *job = data;
+
+    struct sr_command_context *context = job->context;
+
+    struct discord *client = sr_get_client();
+
+    if (job->total < 0) {
+        sr_command_krdict_handle_error(context, job->buffer);
+    } else if ((context->flags & KRD_FLAG_CONVERTED) && job->total == 0) {
+        const char *part = NULL, *translated = NULL;
+
+        sr_command_krdict_split_cache_key(context->data, &part, &translated);
+
+        // 바꾼 검색어의 검색 결과가 없다면, 원래의 검색어 (`dog`, `go` 등)를 그대로 찾는다.
+        const char *query = (char *) context->data + 2 * MAX_STRING_SIZE;
+
+        char key[2 * MAX_STRING_SIZE] = "";
+
+        sr_command_krdict_get_cache_key(key, sizeof(key), query, part, translated, 1);
+
+        log_info("[SAEROM] Looking up \"%s\" as it is", query);
+
+        sr_command_krdict_request_first_page(
+            client, 
+            context->event, 
+            query, 
+            part, 
+            translated, 
+            key, 
+            true
+        );
+
+        discord_unclaim(client, context->event);
+
+        free(context->data);
+        free(context);
+    } else {
+        sr_command_krdict_record_query(context->data, job->total);
+
+        // 안내 문구는 캐시에 저장하지 않는다.
+        if ((context->flags & KRD_FLAG_CONVERTED) && job->total > 0)
+            sr_command_krdict_add_note(job->buffer, sizeof(job->buffer), context->data);
+
+        sr_command_krdict_send_results(
+            client, 
+            context->event, 
+            context->data, 
+            job->buffer, 
+            job->total, 
+            job->count,
+            true
+        );
+
+        discord_unclaim(client, context->event);
+
+        free(context->data);
+        free(context);
+    }
+
+    free(job->res.str);
+    free(job);
+}
+
+/* 미리 가져온 응답 데이터의 가공이 끝났을 때 호출되는 함수. */
+static void on_job_prefetched(void *data) {
+    struct krdict_job *job = data;
+
+    prefetch_count--;
+
+    free(job->context->data);
+    free(job->context);
+
+    free(job->res.str);
+    free(job);
+}
+
+/* 작업 스레드에서 두 오픈 API 중 하나의 응답 데이터를 가공할 때 호출되는 함수. */
+static void on_fanout_work(void *data) {
+    struct krdict_fanout_job *job = data;
+
+    // 두 요청의 응답 데이터는 서로 다른 곳에 저장하므로, 동시에 가공해도 된다.
+    struct krdict_fanout_result *result = &job->fanout->results[job->source];
+
+    if (job->res.len == 0) {
+        strncpy(job->buffer, "-1", sizeof(job->buffer));
+
+        result->total = -1;
+
+        return;
+    }
+
+    result->total = sr_command_krdict_parse_items(
+        job->res, 
+        result->records, 
+        sizeof(result->records), 
+        &result->len,
+        &result->count,
+        job->buffer, 
+        sizeof(job->buffer), 
+        job->fanout->context->flags
+    );
+}
+
+/* 두 오픈 API 중 하나의 응답 데이터의 가공이 끝났을 때 호출되는 함수. */
+static void on_fanout_done(void *data) {
+    struct krdict_fanout_job *job = data;
+
+    struct krdict_fanout *fanout = job->fanout;
+
+    struct sr_command_context *context = fanout->context;
+
+    struct discord *client = sr_get_client();
+
+    fanout->results[job->source].done = true;
+
+    bool complete = true, failed = true;
+
+    for (int i = 0; i < KRD_SOURCE_COUNT_; i++) {
+        if (!fanout->results[i].done) complete = false;
+        else if (fanout->results[i].total >= 0) failed = false;
+    }
+
+    /*
+        먼저 도착한 검색 결과는 바로 보여준다. 나중에 도착한 검색 결과는 기한 안에 도착했거나,
+        아직 보여준 검색 결과가 없을 때만 합쳐서 다시 보여준다.
+    */
+    if (fanout->results[job->source].total > 0
+        && (!fanout->shown || cog_timestamp_ms() <= fanout->deadline))
+        sr_command_krdict_show_fanout(client, fanout);
+
+    if (complete) {
+        if (failed) {
+            sr_command_krdict_handle_error(context, job->buffer);
+
+            context = NULL;
+        } else {
+            char records[RECORD_BUFFER_SIZE];
+
+            size_t records_len = 0;
+
+            char buffer[DISCORD_EMBED_DESCRIPTION_LEN] = "";
+
+            int count = 0;
+
+            struct sr_strbuf sb;
+
+            sr_strbuf_init(&sb, buffer, sizeof(buffer));
+
+            const int total = sr_command_krdict_merge_results(
+                fanout, 
+                records, 
+                sizeof(records), 
+                &records_len, 
+                &count,
+                &sb
+            );
+
+            // 오류가 발생한 요청이 있다면, 검색 결과가 없는 것으로 보지 않는다.
+            if (total > 0 || (fanout->results[KRD_SOURCE_KRDICT].total == 0 
+                && fanout->results[KRD_SOURCE_URMSAEM].total == 0))
+                sr_command_krdict_write_cache(
+                    context->data, 
+                    records, 
+                    records_len, 
+                    buffer, 
+                    total, 
+                    count
+                );
+
+            sr_command_krdict_record_query(context->data, total);
+
+            if (!fanout->sent)
+                sr_command_krdict_send_results(client, context->event, context->data, "", 0, 0, true);
+        }
+
+        if (context != NULL) {
+            discord_unclaim(client, context->event);
+
+            free(context->data);
+            free(context);
+        }
+
+        for (struct krdict_fanout **ptr = &fanouts; *ptr != NULL; ptr = &(*ptr)->next) {
+            if (*ptr != fanout) continue;
+
+            *ptr = fanout->next;
+
+            break;
+        }
+
+        free(fanout);
+    }
+
+    free(job->res.str);
+    free(job);
+}
+
+/* 작업 스레드에서 사전 데이터의 표제어 목록으로 색인을 만들 때 호출되는 함수. */
+static void on_headwords_work(void *data) {
+    struct krdict_headwords_job *job = data;
+
+    struct sr_dict_snapshot *snapshot = job->snapshot;
+
+    // 표제어가 하나도 없다면, 블룸 필터로 검색 결과가 없음을 확신할 수 없다.
+    if (sr_dict_get_word_count(snapshot) > 0) {
+        job->bloom = sr_bloom_create(
+            sr_dict_get_word_count(snapshot), 
+            sr_config_get_krdict_dict_false_positive_rate()
+        );
+    }
+
+    if (snapshot != NULL) {
+        const char *words[MAX_CHOICE_COUNT * 16];
+
+        char first[2 * MAX_STRING_SIZE] = "";
+
+        for (;;) {
+            const int count = sr_dict_find_range(
+                snapshot, 
+                first, 
+                NULL, 
+                words, 
+                sizeof(words) / sizeof(*words)
+            );
+
+            for (int i = 0; i < count; i++) {
+                char folded[2 * MAX_STRING_SIZE] = "";
+
+                sr_command_krdict_fold_word(words[i], folded, sizeof(folded));
+
+                sr_bloom_add(job->bloom, folded);
+
+                if (job->suggest == NULL) continue;
+
+                struct sr_dict_sense senses[MAX_ORDER_COUNT];
+
+                int total = 0, level = SR_DICT_LEVEL_NONE;
+
+                const int len = sr_dict_find(
+                    snapshot, 
+                    words[i], 
+                    senses, 
+                    MAX_ORDER_COUNT, 
+                    &total
+                );
+
+                // 표제어의 학습 등급은 뜻풀이의 학습 등급 중 가장 높은 것으로 한다.
+                for (int j = 0; j < len; j++)
+                    if (level < senses[j].level) level = senses[j].level;
+
+                sr_suggest_add(job->suggest, words[i], level);
+            }
+
+            if (count < sizeof(words) / sizeof(*words)) break;
+
+            // 다음 검색은 마지막 표제어 바로 다음부터 시작한다.
+            snprintf(first, sizeof(first), "%s\x01", words[count - 1]);
+        }
+    }
+
+    sr_dict_release(snapshot);
+
+    job->snapshot = NULL;
+
+    if (job->suggest == NULL) return;
+
+    const char *path = sr_config_get_krdict_autocomplete_path();
+
+    if (*path != '\0') sr_suggest_load(job->suggest, path);
+
+    sr_suggest_build(job->suggest);
+}
+
+/* 사전 데이터의 표제어 색인을 다 만들었을 때 호출되는 함수. */
+static void on_headwords_done(void *data) {
+    struct krdict_headwords_job *job = data;
+
+    sr_bloom_release(headwords);
+
+    headwords = job->bloom;
+    headwords_timestamp = job->timestamp;
+    headwords_building = false;
+
+    if (job->suggest != NULL) {
+        sr_suggest_release(suggestions);
+
+        suggestions = job->suggest;
+    }
+
+    if (headwords != NULL) {
+        log_info(
+            "[SAEROM] Built a headword filter of %zu bytes", 
+            sr_bloom_get_size(headwords)
+        );
+    }
+
+    free(job);
+}
+
+/* 작업 스레드에서 검색어 자동 완성 색인에 새로운 검색어들을 합칠 때 호출되는 함수. */
+static void on_suggest_work(void *data) {
+    sr_suggest_merge(data);
+}
+
+/* 검색어 자동 완성 색인에 새로운 검색어들을 다 합쳤을 때 호출되는 함수. */
+static void on_suggest_done(void *data) {
+    sr_suggest_end_merge(data);
+}
+
+/* `/krd` 명령어의 주어진 위치부터 보여주는 검색 요청을 처리한다. */
+static void sr_command_krdict_search_page(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *query,
+    const char *part,
+    const char *translated,
+    int start
+) {
+    char buffer[DISCORD_EMBED_DESCRIPTION_LEN] = "";
+
+    size_t query_length = utf8len(query);
+
+    // 오픈 API에 요청을 보내지 않고도 응답할 수 있다면, 바로 응답한다.
+    if (query_length > MAX_TEXT_LENGTH) {
+        snprintf(
+            buffer, 
+            sizeof(buffer), 
+            "The length of the `query` option (`%zu` characters) must be less than "
+            "or equal to `%d` characters.",
+            query_length,
+            MAX_TEXT_LENGTH
+        );
+
+        sr_command_krdict_send_results(client, event, NULL, buffer, 0, 0, false);
+
+        return;
+    }
+
+    const u64bitmask flags = sr_command_krdict_get_flags(part, translated);
+
+    char key[2 * MAX_STRING_SIZE] = "";
+
+    sr_command_krdict_get_cache_key(key, sizeof(key), query, part, translated, start);
+
+    int total = 0, count = 0;
+
+    // 첫 페이지가 아닌 검색 결과는 캐시에 없다면 오픈 API에서만 찾는다.
+    if (start > 1) {
+        if (sr_command_krdict_read_cache(key, flags, buffer, sizeof(buffer), &total, &count)) {
+            sr_command_krdict_send_results(client, event, key, buffer, total, count, false);
+
+            return;
+        }
+
+        sr_command_krdict_create_request(client, event, NULL, query, part, translated, start);
+        sr_command_krdict_defer_results(client, event);
+
+        return;
+    }
+
+    if (sr_command_krdict_search_local(query, key, flags, buffer, sizeof(buffer), &total, &count)) {
+        sr_command_krdict_send_results(client, event, key, buffer, total, count, false);
+
+        return;
+    }
+
+    char lemma[2 * MAX_STRING_SIZE] = "";
+
+    // 활용형 검색어는 오픈 API에서도 찾을 수 없으므로, 사전 데이터에 있는 기본형을 대신 찾는다.
+    if (sr_command_krdict_find_lemma(query, flags, lemma, sizeof(lemma))) {
+        char lemma_key[2 * MAX_STRING_SIZE] = "";
+
+        sr_command_krdict_get_cache_key(
+            lemma_key, 
+            sizeof(lemma_key), 
+            lemma, 
+            part, 
+            translated,
+            1
+        );
+
+        // 다음 페이지와 미리 가져오는 검색 결과도 기본형으로 찾는다.
+        if (sr_command_krdict_search_local(
+            lemma, 
+            lemma_key, 
+            flags, 
+            buffer, 
+            sizeof(buffer), 
+            &total,
+            &count
+        )) {
+            log_info("[SAEROM] Looking up \"%s\" as \"%s\"", query, lemma);
+
+            if (total > 0) sr_command_krdict_add_note(buffer, sizeof(buffer), lemma_key);
+
+            sr_command_krdict_send_results(
+                client, 
+                event, 
+                lemma_key, 
+                buffer, 
+                total, 
+                count, 
+                false
+            );
+
+            return;
+        }
+    }
+
+    char converted[2 * MAX_STRING_SIZE] = "";
+
+    // 한/영 전환을 하지 않고 입력한 검색어라면, 두벌식 자판 기준으로 바꾼 검색어를 대신 찾는다.
+    if (sr_keyboard_to_hangul(query, converted, sizeof(converted))) {
+        char converted_key[2 * MAX_STRING_SIZE] = "";
+
+        sr_command_krdict_get_cache_key(
+            converted_key, 
+            sizeof(converted_key), 
+            converted, 
+            part, 
+            translated,
+            1
+        );
+
+        if (sr_command_krdict_search_local(
+            converted, 
+            converted_key, 
+            flags, 
+            buffer, 
+            sizeof(buffer), 
+            &total,
+            &count
+        )) {
+            if (total > 0) sr_command_krdict_add_note(buffer, sizeof(buffer), converted_key);
+
+            sr_command_krdict_send_results(
+                client, 
+                event, 
+                converted_key, 
+                buffer, 
+                total, 
+                count, 
+                false
+            );
+
+            return;
+        }
+
+        // 바꾼 검색어도 검색 결과가 없을 것이 확실하다면, 원래의 검색어를 그대로 찾는다.
+        if (!sr_command_krdict_is_known_miss(converted_key, flags)) {
+            log_info("[SAEROM] Looking up \"%s\" as \"%s\"", query, converted);
+
+            struct sr_command_context *context = sr_command_krdict_create_request(
+                client, 
+                event, 
+                on_response_converted, 
+                converted, 
+                part, 
+                translated,
+                1
+            );
+
+            // 바꾼 검색어의 검색 결과가 없다면 원래의 검색어로 다시 찾도록, 캐시 키 뒤에 기록한다.
+            context->data = realloc(context->data, 4 * MAX_STRING_SIZE);
+
+            snprintf(
+                (char *) context->data + 2 * MAX_STRING_SIZE, 
+                2 * MAX_STRING_SIZE, 
+                "%s", 
+                query
+            );
+
+            sr_command_krdict_defer_results(client, event);
+
+            return;
+        }
+    }
+
+    if (sr_command_krdict_request_first_page(client, event, query, part, translated, key, false))
+        sr_command_krdict_defer_results(client, event);
+}
+
+/* 
+    `/krd` 명령어의 첫 페이지 검색 결과를 오픈 API에 요청한다.
+    검색 결과가 없을 것이 확실하여 요청을 보내지 않았다면, 바로 응답하고 `false`를 반환한다.
+*/
+static bool sr_command_krdict_request_first_page(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *query,
+    const char *part,
+    const char *translated,
+    const char *key,
+    bool deferred
+) {
+    const u64bitmask flags = sr_command_krdict_get_flags(part, translated);
+
+    // 한국어기초사전에 없는 표제어는 우리말샘에서도 함께 찾는다.
+    const bool fanout = sr_config_get_krdict_fanout_enabled()
+        && sr_command_krdict_get_source(part, translated) == KRD_SOURCE_KRDICT;
+
+    // 검색 결과가 없을 것이 확실하다면, 오픈 API에 요청을 보내지 않는다.
+    // 우리말샘도 함께 찾을 때는 블룸 필터 대신 최근에 검색 결과가 없었는지만 확인한다.
+    if (sr_command_krdict_is_known_miss(key, fanout ? flags | KRD_FLAG_FANOUT : flags)) {
+        sr_command_krdict_send_results(client, event, key, "", 0, 0, deferred);
+
+        return false;
+    }
+
+    if (fanout)
+        sr_command_krdict_fan_out(client, event, query, part, translated);
+    else
+        sr_command_krdict_create_request(client, event, NULL, query, part, translated, 1);
+
+    return true;
+}
+
+/* `/krd` 명령어의 검색 결과를 나중에 전송하겠다고 응답한다. */
+static void sr_command_krdict_defer_results(
+    struct discord *client,
+    const struct discord_interaction *event
+) {
+    // 페이지를 넘기는 버튼을 눌렀다면, 새로운 메시지 대신 원래 메시지를 바꾼다.
+    discord_create_interaction_response(
+        client, 
+        event->id, 
+        event->token, 
+        &(struct discord_interaction_response) {
+            .type = sr_command_krdict_is_paging(event)
+                ? DISCORD_INTERACTION_DEFERRED_UPDATE_MESSAGE
+                : DISCORD_INTERACTION_DEFERRED_CHANNEL_MESSAGE_WITH_SOURCE
+        },
+        NULL
+    );
+}
+
+/* 검색 결과의 페이지를 넘기는 버튼을 눌러 발생한 상호 작용인지 확인한다. */
+static bool sr_command_krdict_is_paging(const struct discord_interaction *event) {
+    return event->type == DISCORD_INTERACTION_MESSAGE_COMPONENT
+        && event->data != NULL
+        && event->data->custom_id != NULL
+        && strncmp(event->data->custom_id, "krd_pg_", 7) == 0;
+}
+
+/* `/krd` 명령어의 주어진 검색 결과를 미리 가져와서 캐시에 저장한다. */
+static void sr_command_krdict_prefetch(
+    struct discord *client,
+    const char *query,
+    const char *part,
+    const char *translated,
+    int start
+) {
+    // 사용자의 검색 요청을 기다리는 중이라면, 요청을 모두 처리할 때까지 미뤄 둔다.
+    if (request_count > 0) {
+        if (deferred_count >= MAX_PREFETCH_COUNT) return;
+
+        struct krdict_prefetch *prefetch = &deferred_prefetches[deferred_count++];
+
+        snprintf(prefetch->query, sizeof(prefetch->query), "%s", query);
+
+        prefetch->part = part;
+        prefetch->translated = translated;
+        prefetch->start = start;
+
+        return;
+    }
+
+    // 미리 가져오는 요청은 다른 요청을 방해하지 않도록 몇 개까지만 동시에 보낸다.
+    if (prefetch_count >= MAX_PREFETCH_COUNT) return;
+
+    char key[2 * MAX_STRING_SIZE] = "";
+
+    sr_command_krdict_get_cache_key(
+        key, 
+        sizeof(key), 
+        query, 
+        part, 
+        translated, 
+        start
+    );
+
+    struct krdict_cache_value value;
+
+    // 이미 캐시에 있거나, 검색 결과가 없는 것이 확실한 검색어는 다시 요청하지 않는다.
+    if (sr_cache_get(item_cache, key, &value, sizeof(value)) > 0) return;
+
+    if (sr_command_krdict_is_known_miss(key, sr_command_krdict_get_flags(part, translated))) 
+        return;
+
+    if (!sr_command_krdict_can_prefetch(sr_command_krdict_get_source(part, translated))) 
+        return;
+
+    prefetch_count++;
+
+    sr_command_krdict_create_request(
+        client, 
+        NULL, 
+        on_response_prefetch, 
+        query, 
+        part, 
+        translated, 
+        start
+    );
+}
+
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 반환한다. */
+static struct krdict_usage *sr_command_krdict_get_usage(void) {
+    // 오픈 API의 일일 허용량은 한국 표준시로 자정마다 초기화된다.
+    const uint64_t day = (cog_timestamp_ms() + 9 * 3600000ULL) / 86400000ULL;
+
+    if (usage.day != day) {
+        const bool rollover = (usage.day != 0);
+
+        usage = (struct krdict_usage) { .day = day };
+
+        // 날짜가 바뀌었다면, 어제 보낸 요청의 개수가 다시 읽히지 않도록 바로 기록한다.
+        if (rollover) {
+            usage_dirty = true;
+
+            sr_command_krdict_save_usage();
+        }
+    }
+
+    return &usage;
+}
+
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 기록하는 파일의 경로를 구한다. */
+static bool sr_command_krdict_get_usage_path(char *buffer, size_t size) {
+    const char *path = sr_config_get_krdict_cache_path();
+
+    // 캐시 파일을 사용하지 않는다면, 요청의 개수도 기록하지 않는다.
+    if (*path == '\0') return false;
+
+    snprintf(buffer, size, "%s.usage", path);
+
+    return true;
+}
+
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 파일에서 읽는다. */
+static void sr_command_krdict_load_usage(void) {
+    char path[MAX_STRING_SIZE + 8] = "";
+
+    if (!sr_command_krdict_get_usage_path(path, sizeof(path))) return;
+
+    const uint64_t today = sr_command_krdict_get_usage()->day;
+
+    FILE *fp = fopen(path, "r");
+
+    if (fp == NULL) return;
+
+    struct krdict_usage saved = { .day = 0 };
+
+    unsigned long long day = 0;
+
+    if (fscanf(fp, "%llu", &day) == 1) {
+        saved.day = day;
+
+        for (int i = 0; i < KRD_SOURCE_COUNT_; i++)
+            if (fscanf(fp, "%d", &saved.counts[i]) != 1) saved.day = 0;
+    }
+
+    fclose(fp);
+
+    // 다시 시작하기 전에 오늘 보낸 요청의 개수만 이어서 센다.
+    if (saved.day == today) memcpy(usage.counts, saved.counts, sizeof(usage.counts));
+
+    usage_saved_at = cog_timestamp_ms();
+}
+
+/* `/krd` 명령어가 오늘 각 오픈 API에 보낸 요청의 개수를 파일에 기록한다. */
+static void sr_command_krdict_save_usage(void) {
+    char path[MAX_STRING_SIZE + 8] = "", temp_path[MAX_STRING_SIZE + 12] = "";
+
+    if (!usage_dirty || !sr_command_krdict_get_usage_path(path, sizeof(path))) return;
+
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE *fp = fopen(temp_path, "w");
+
+    if (fp == NULL) return;
+
+    bool result = fprintf(fp, "%llu", (unsigned long long) usage.day) > 0;
+
+    for (int i = 0; i < KRD_SOURCE_COUNT_ && result; i++)
+        result = fprintf(fp, "\t%d", usage.counts[i]) > 0;
+
+    result = (fprintf(fp, "\n") > 0) && result;
+    result = (fclose(fp) == 0) && result;
+
+    if (result) result = (rename(temp_path, path) == 0);
+    else remove(temp_path);
+
+    if (!result) {
+        log_warn("[SAEROM] Failed to save the API usage to \"%s\"", path);
+
+        return;
+    }
+
+    usage_dirty = false;
+    usage_saved_at = cog_timestamp_ms();
+}
+
+/*
+    `/krd` 명령어의 검색 결과를 지금 주어진 오픈 API에서 미리 가져와도 되는지 확인한다.
+    가져와도 된다면, 토큰 버킷에서 토큰 하나를 사용한다.
+*/
+static bool sr_command_krdict_can_prefetch(enum krdict_source source) {
+    const int rate = sr_config_get_krdict_prefetch_rate();
+
+    if (rate <= 0) return false;
+
+    struct krdict_usage *today = sr_command_krdict_get_usage();
+
+    const int quota = sr_config_get_krdict_prefetch_quota();
+
+    // 일일 허용량이 얼마 남지 않았다면, 남은 허용량은 사용자의 검색 요청에만 사용한다.
+    if (quota > 0 && today->counts[source] >= quota * PREFETCH_QUOTA_RATIO) {
+        if (!today->exhausted[source]) {
+            log_warn(
+                "[SAEROM] Stopped prefetching from \"%s\" for today (%d/%d requests)",
+                (source == KRD_SOURCE_URMSAEM) ? REQUEST_URL_URMSAEM : REQUEST_URL_KRDICT,
+                today->counts[source],
+                quota
+            );
+
+            today->exhausted[source] = true;
+        }
+
+        return false;
+    }
+
+    const uint64_t now = cog_timestamp_ms();
+
+    // 토큰은 1분에 `rate`개씩 채워지며, 최대 `rate`개까지 모아둘 수 있다.
+    prefetch_bucket.tokens += (now - prefetch_bucket.updated_at) * rate / 60000.0;
+
+    if (prefetch_bucket.tokens > rate) prefetch_bucket.tokens = rate;
+
+    prefetch_bucket.updated_at = now;
+
+    if (prefetch_bucket.tokens < 1.0) return false;
+
+    prefetch_bucket.tokens -= 1.0;
+
+    return true;
+}
+
+/* `/krd` 명령어의 응답 데이터 가공 작업을 생성한다. */
+static struct krdict_job *sr_command_krdict_create_job(
+    struct sr_command_context *context,
+    CURLV_STR res
+) {
+    // 응답 데이터는 응답 함수가 반환된 직후에 해제되므로, 복사해두어야 한다.
+    struct krdict_job *job = malloc(sizeof(*job));
+
+    job->context = context;
+    job->res.len = res.len;
+    job->res.str = malloc(res.len + 1);
+    job->total = 0;
+
+    memcpy(job->res.str, res.str, res.len + 1);
+
+    *job->buffer = '\0';
+
+    return job;
+}
+
+/* `/krd` 명령어의 검색 대상과 번역 여부에 맞는 오픈 API를 반환한다. */
+static enum krdict_source sr_command_krdict_get_source(
+    const char *part, 
+    const char *translated
+) {
+    // 우리말샘 오픈 API는 다국어 번역을 지원하지 않는다.
+    return (streq(part, "exam") || streq(translated, "false"))
+        ? KRD_SOURCE_URMSAEM
+        : KRD_SOURCE_KRDICT;
+}
+
+/* `/krd` 명령어의 주어진 오픈 API에 보낼 요청을 초기화한다. */
+static void sr_command_krdict_init_request(
+    CURLV_REQ *request,
+    enum krdict_source source,
+    const char *query,
+    const char *part,
+    int start
+) {
+    struct krdict_usage *today = sr_command_krdict_get_usage();
+
+    // 미리 가져오는 요청을 포함한 모든 요청이 일일 허용량을 사용한다.
+    today->counts[source]++;
+
+    // 다시 시작한 뒤에도 오늘 보낸 요청의 개수를 알 수 있도록, 대기 중일 때 파일에 기록한다.
+    usage_dirty = true;
+
+    request->easy = curl_easy_init();
+
+    char buffer[DISCORD_MAX_MESSAGE_LEN] = "";
+
+    // 주어진 위치부터 한 페이지에 출력할 수 있는 만큼의 검색 결과만 요청한다.
+    if (start < 1) start = 1;
+    else if (start > MAX_START_INDEX) start = MAX_START_INDEX;
+
+    if (source == KRD_SOURCE_URMSAEM) {
+        snprintf(
+            buffer, 
+            sizeof(buffer), 
+            "key=%s&q=%s&part=%s&advanced=%s&start=%d&num=%d",
+            sr_config_get_urms_api_key(),
+            query,
+            part,
+            (streq(part, "word")) ? "y" : "n",
+            start,
+            PAGE_ITEM_COUNT
+        );
+
+        curl_easy_setopt(request->easy, CURLOPT_URL, REQUEST_URL_URMSAEM);
+    } else {
+        snprintf(
+            buffer, 
+            sizeof(buffer), 
+            "key=%s&q=%s&part=%s&advanced=%s&start=%d&num=%d&translated=y&trans_lang=1",
+            sr_config_get_krd_api_key(),
+            query,
+            part,
+            (streq(part, "word")) ? "y" : "n",
+            start,
+            PAGE_ITEM_COUNT
+        );
+
+        curl_easy_setopt(request->easy, CURLOPT_URL, REQUEST_URL_KRDICT);
+    }
+
+    curl_easy_setopt(request->easy, CURLOPT_POSTFIELDSIZE, strlen(buffer));
+    curl_easy_setopt(request->easy, CURLOPT_COPYPOSTFIELDS, buffer);
+    curl_easy_setopt(request->easy, CURLOPT_SSL_VERIFYPEER, false);
+    curl_easy_setopt(request->easy, CURLOPT_POST, 1);
+    curl_easy_setopt(request->easy, CURLOPT_TIMEOUT_MS, (long) REQUEST_TIMEOUT_MS);
+}
+
+/* `/krd` 명령어의 검색 요청을 한국어기초사전과 우리말샘 오픈 API에 동시에 보낸다. */
+static void sr_command_krdict_fan_out(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *query,
+    const char *part,
+    const char *translated
+) {
+    struct krdict_fanout *fanout = calloc(1, sizeof(*fanout));
+
+    fanout->context = calloc(1, sizeof(*fanout->context));
+
+    fanout->context->event = discord_claim(client, event);
+    fanout->context->flags = sr_command_krdict_get_flags(part, translated);
+    fanout->context->data = malloc(2 * MAX_STRING_SIZE);
+
+    sr_command_krdict_get_cache_key(
+        fanout->context->data, 
+        2 * MAX_STRING_SIZE, 
+        query, 
+        part, 
+        translated,
+        1
+    );
+
+    // 기한은 나중에 도착한 검색 결과를 다시 보여줄지 정할 때만 사용하고, 요청은 끝까지 기다린다.
+    fanout->deadline = cog_timestamp_ms() + sr_config_get_krdict_fanout_deadline();
+
+    fanout->next = fanouts;
+
+    fanouts = fanout;
+
+    for (int i = 0; i < KRD_SOURCE_COUNT_; i++) {
+        struct krdict_fanout_job *job = calloc(1, sizeof(*job));
+
+        job->fanout = fanout;
+        job->source = i;
+
+        CURLV_REQ request = { .callback = on_response_fanout, .user_data = job };
+
+        sr_command_krdict_init_request(&request, i, query, part, 1);
+
+        request_count++;
+
+        curlv_create_request(sr_get_curlv(), &request);
+    }
+}
+
+/* 
+    `/krd` 명령어가 두 오픈 API에서 가져온 검색 결과를 합치고, 문자열로 변환한다.
+    한국어기초사전에 있는 표제어는 우리말샘의 검색 결과에서 빼고 합친다.
+*/
+static int sr_command_krdict_merge_results(
+    const struct krdict_fanout *fanout,
+    char *records,
+    size_t size,
+    size_t *len,
+    int *count,
+    struct sr_strbuf *sb
+) {
+    const struct krdict_fanout_result *primary = &fanout->results[KRD_SOURCE_KRDICT];
+    const struct krdict_fanout_result *secondary = &fanout->results[KRD_SOURCE_URMSAEM];
+
+    int total = 0, entry_count = 0;
+
+    *len = 0;
+
+    if (primary->done && primary->total > 0) {
+        memcpy(records, primary->records, primary->len);
+
+        *len = primary->len;
+
+        total = primary->total;
+    }
+
+    if (secondary->done && secondary->total > 0) {
+        const char *ptr = secondary->records, *end = secondary->records + secondary->len;
+
+        const char *link = NULL;
+
+        struct krdict_item item;
+
+        int order;
+
+        while ((ptr = sr_command_krdict_unpack_item(ptr, end, &item, &order)) != NULL) {
+            if (primary->done && primary->total > 0 
+                && sr_command_krdict_has_word(primary->records, primary->len, &item.word))
+                continue;
+
+            const size_t new_len = sr_command_krdict_pack_item(records, size, *len, &item, order);
+
+            if (new_len == *len) break;
+
+            *len = new_len;
+
+            if (link == NULL || !streq(link, item.link.str)) entry_count++;
+
+            link = item.link.str;
+        }
+
+        /*
+            한국어기초사전의 검색 결과가 있다면 다음 페이지는 한국어기초사전에서 가져오므로,
+            우리말샘의 검색 결과만 있을 때는 한 페이지만 보여준다.
+        */
+        if (total == 0) total = entry_count;
+    }
+
+    // 다음 페이지의 시작 위치는 한국어기초사전에서 보여준 항목의 개수로 정한다.
+    *count = (primary->done && primary->total > 0) ? primary->count : total;
+
+    sr_command_krdict_render_items(records, *len, sb, fanout->context->flags);
+
+    return total;
+}
+
+/* `/krd` 명령어가 두 오픈 API에서 지금까지 가져온 검색 결과를 합쳐서 전송한다. */
+static void sr_command_krdict_show_fanout(
+    struct discord *client,
+    struct krdict_fanout *fanout
+) {
+    char records[RECORD_BUFFER_SIZE];
+
+    size_t records_len = 0;
+
+    char buffer[DISCORD_EMBED_DESCRIPTION_LEN] = "";
+
+    int count = 0;
+
+    struct sr_strbuf sb;
+
+    sr_strbuf_init(&sb, buffer, sizeof(buffer));
+
+    const int total = sr_command_krdict_merge_results(
+        fanout, 
+        records, 
+        sizeof(records), 
+        &records_len, 
+        &count,
+        &sb
+    );
+
+    sr_command_krdict_send_results(
+        client, 
+        fanout->context->event, 
+        fanout->context->data, 
+        buffer, 
+        total, 
+        count,
+        true
+    );
+
+    fanout->sent = true;
+
+    if (total > 0) fanout->shown = true;
+}
+
+/* `/krd` 명령어의 직렬화된 검색 결과에 주어진 표제어가 있는지 확인한다. */
+static bool sr_command_krdict_has_word(
+    const char *records,
+    size_t len,
+    const struct krdict_span *word
+) {
+    const char *ptr = records, *end = records + len;
+
+    struct krdict_item item;
+
+    int order;
+
+    while ((ptr = sr_command_krdict_unpack_item(ptr, end, &item, &order)) != NULL)
+        if (item.word.len == word->len && memcmp(item.word.str, word->str, word->len) == 0)
+            return true;
+
+    return false;
+}
+
+/* `/krd` 명령어의 조건 플래그를 반환한다. */
+static u64bitmask sr_command_krdict_get_flags(
+    const char *part, 
+    const char *translated
+) {
+    u64bitmask result = 0;
+
+    if (streq(part, "exam")) result |= KRD_FLAG_PART_EXAM;
+    if (streq(translated, "true")) result |= KRD_FLAG_TRANSLATED;
+
+    return result;
+}
+
+/* `/krd` 명령어의 캐시 키를 생성한다. */
+static void sr_command_krdict_get_cache_key(
+    char *buffer,
+    size_t size,
+    const char *query,
+    const char *part,
+    const char *translated,
+    int start
+) {
+    char text[2 * MAX_STRING_SIZE] = "";
+
+    normalize_text(query, text, sizeof(text));
+
+    // 검색어의 영문자는 대소문자를 구분하지 않는다.
+    for (char *c = text; *c != '\0'; c++)
+        if (*c >= 'A' && *c <= 'Z') *c += 'a' - 'A';
+
+    // 첫 페이지의 캐시 키에는 시작 위치를 붙이지 않는다.
+    if (start > 1) {
+        snprintf(
+            buffer, 
+            size, 
+            "%s:%s/%d:%s", 
+            part, 
+            streq(translated, "true") ? "y" : "n", 
+            start,
+            text
+        );
+    } else {
+        snprintf(
+            buffer, 
+            size, 
+            "%s:%s:%s", 
+            part, 
+            streq(translated, "true") ? "y" : "n", 
+            text
+        );
+    }
+}
+
+/* `/krd` 명령어의 캐시 키에서 검색 대상과 번역 여부를 추출하고, 검색어를 반환한다. */
+static const char *sr_command_krdict_split_cache_key(
+    const char *key,
+    const char **part,
+    const char **translated
+) {
+    // 캐시 키는 `검색 대상:번역 여부[/시작 위치]:검색어`의 형태이다.
+    const char *flag = (key != NULL) ? strchr(key, ':') : NULL;
+    const char *query = (flag != NULL) ? strchr(flag + 1, ':') : NULL;
+
+    if (query == NULL) return NULL;
+
+    *part = (strncmp(key, "exam:", 5) == 0) ? "exam" : "word";
+    *translated = (flag[1] == 'y') ? "true" : "false";
+
+    return query + 1;
+}
+
+/* `/krd` 명령어의 캐시 키에서 검색 결과의 시작 위치를 추출한다. */
+static int sr_command_krdict_get_start(const char *key) {
+    const char *flag = (key != NULL) ? strchr(key, ':') : NULL;
+
+    if (flag == NULL || flag[1] == '\0' || flag[2] != '/') return 1;
+
+    const int start = atoi(flag + 3);
+
+    return (start > 1) ? start : 1;
+}
+
+/* `/krd` 명령어의 검색 결과를 오픈 API에 요청을 보내지 않고 찾는다. */
+static bool sr_command_krdict_search_local(
+    const char *query,
+    const char *key,
+    u64bitmask flags,
+    char *buffer,
+    size_t size,
+    int *total,
+    int *count
+) {
+    if (sr_command_krdict_read_cache(key, flags, buffer, size, total, count)) {
+        sr_command_krdict_record_query(key, *total);
+
+        return true;
+    }
+
+    // 오프라인 사전 데이터에 검색어가 없을 때만 오픈 API에 요청을 보낸다.
+    if (sr_command_krdict_read_dict(query, flags, buffer, size, total, count)) {
+        sr_command_krdict_record_query(key, *total);
+
+        return true;
+    }
+
+    return false;
+}
+
+/* `/krd` 명령어의 검색 결과 앞에 바꾼 검색어로 찾은 결과라는 안내 문구를 추가한다. */
+static void sr_command_krdict_add_note(char *buffer, size_t size, const char *key) {
+    // 캐시 키는 `검색 대상:번역 여부:검색어`의 형태이다.
+    const char *query = strchr(key, ':');
+
+    if (query != NULL) query = strchr(query + 1, ':');
+
+    if (query == NULL) return;
+
+    char *results = strdup(buffer);
+
+    struct sr_strbuf sb;
+
+    sr_strbuf_init(&sb, buffer, size);
+
+    // 공간이 부족하다면, 검색 결과의 끝부분을 줄 단위로 잘라낸다.
+    sr_strbuf_printf(&sb, "Showing results for **%s**.\n\n", query + 1);
+    sr_strbuf_append(&sb, results, strlen(results));
+
+    free(results);
+}
+
+/* `/krd` 명령어의 캐시에서 검색 결과를 읽는다. */
+static bool sr_command_krdict_read_cache(
+    const char *key,
+    u64bitmask flags,
+    char *buffer,
+    size_t size,
+    int *total,
+    int *count
+) {
+    struct krdict_cache_value value;
+
+    size_t len = sr_cache_get(result_cache, key, &value, sizeof(value));
+
+    if (len > offsetof(struct krdict_cache_value, data)) {
+        len -= offsetof(struct krdict_cache_value, data);
+
+        if (len > size) len = size;
+
+        memcpy(buffer, value.data, len);
+
+        buffer[len - 1] = '\0';
+
+        *total = value.total;
+        *count = value.count;
+
+        return true;
+    }
+
+    // 출력 결과가 없다면, 가공된 검색 결과로부터 출력 결과를 다시 만든다.
+    len = sr_cache_get(item_cache, key, &value, sizeof(value));
+
+    if (len > offsetof(struct krdict_cache_value, data)) {
+        len -= offsetof(struct krdict_cache_value, data);
+
+        struct sr_strbuf sb;
+
+        sr_strbuf_init(&sb, buffer, size);
+
+        sr_command_krdict_render_items(value.data, len, &sb, flags);
+
+        *total = value.total;
+        *count = value.count;
+
+        len = sb.len + 1;
+
+        memcpy(value.data, buffer, len);
+
+        sr_cache_put(
+            result_cache, 
+            key, 
+            &value, 
+            offsetof(struct krdict_cache_value, data) + len
+        );
+
+        return true;
+    }
+
+    return false;
+}
+
+/* `/krd` 명령어의 오프라인 사전 데이터에서 검색 결과를 읽는다. */
+static bool sr_command_krdict_read_dict(
+    const char *query,
+    u64bitmask flags,
+    char *buffer,
+    size_t size,
+    int *total,
+    int *count
+) {
+    // 오프라인 사전 데이터에는 용례 검색을 위한 색인이 없다.
+    if (dictionary == NULL || (flags & KRD_FLAG_PART_EXAM)) return false;
+
+    // 번역하지 않는 검색은 우리말샘에서 찾으므로, 한국어기초사전의 사전 데이터로 대신할 수 없다.
+    if (!(flags & KRD_FLAG_TRANSLATED)) return false;
+
+    sr_dict_refresh(dictionary);
+
+    // 검색하는 동안 변경분이 병합되더라도, 가져온 목록은 계속 사용할 수 있다.
+    struct sr_dict_snapshot *snapshot = sr_dict_acquire(dictionary);
+
+    const uint64_t max_age = sr_config_get_krdict_dict_max_age();
+
+    // 오래된 사전 데이터는 사용하지 않는다.
+    if (snapshot == NULL || (max_age > 0 
+        && cog_timestamp_ms() - sr_dict_get_timestamp(snapshot) > max_age)) {
+        sr_dict_release(snapshot);
+
+        return false;
+    }
+
+    char text[2 * MAX_STRING_SIZE] = "";
+
+    normalize_text(query, text, sizeof(text));
+
+    struct sr_dict_sense senses[MAX_ORDER_COUNT * MAX_EXAMPLE_COUNT];
+
+    const int sense_count = sr_dict_find(
+        snapshot, 
+        text, 
+        senses, 
+        sizeof(senses) / sizeof(*senses), 
+        total
+    );
+
+    if (sense_count <= 0) {
+        sr_dict_release(snapshot);
+
+        return false;
+    }
+
+    char records[RECORD_BUFFER_SIZE];
+
+    size_t records_len = 0, entry_len = 0;
+
+    int entry_count = 0;
+
+    for (int i = 0; i < sense_count; i++) {
+        if (i == 0 || !streq(senses[i - 1].link, senses[i].link)) {
+            entry_count++;
+
+            entry_len = records_len;
+        }
+
+        // 오픈 API의 검색 결과와 같이, 첫 페이지의 항목만 보여준다.
+        if (entry_count > PAGE_ITEM_COUNT) break;
+
+        // 오픈 API의 검색 결과와 같이, 각 항목의 앞부분 뜻풀이만 보여준다.
+        if (senses[i].order > MAX_ORDER_COUNT) continue;
+
+        const bool translated = (flags & KRD_FLAG_TRANSLATED) 
+            && *senses[i].trans_word != '\0';
+
+        const char *dfn = translated ? senses[i].trans_word : senses[i].definition;
+        const char *exam = translated ? senses[i].trans_dfn : "";
+
+        // 사전 데이터 파일의 문자열을 복사하지 않고 그대로 사용한다.
+        const struct krdict_item item = {
+            .word   = { senses[i].word, strlen(senses[i].word) },
+            .origin = { senses[i].origin, strlen(senses[i].origin) },
+            .pos    = { senses[i].pos, strlen(senses[i].pos) },
+            .link   = { senses[i].link, strlen(senses[i].link) },
+            .dfn    = { dfn, strlen(dfn) },
+            .exam   = { exam, strlen(exam) }
+        };
+
+        const size_t new_len = sr_command_krdict_pack_item(
+            records, 
+            sizeof(records), 
+            records_len, 
+            &item, 
+            senses[i].order
+        );
+
+        // 공간이 부족하다면, 일부만 담은 항목은 빼고 다음 페이지에서 보여준다.
+        if (new_len == records_len) {
+            if (entry_len > 0) records_len = entry_len;
+
+            break;
+        }
+
+        records_len = new_len;
+    }
+
+    sr_dict_release(snapshot);
+
+    struct sr_strbuf sb;
+
+    sr_strbuf_init(&sb, buffer, size);
+
+    *count = sr_command_krdict_render_items(records, records_len, &sb, flags);
+
+    return true;
+}
+
+/* `/krd` 명령어의 오프라인 사전 데이터에서 활용형 검색어의 기본형을 찾는다. */
+static bool sr_command_krdict_find_lemma(
+    const char *query,
+    u64bitmask flags,
+    char *buffer,
+    size_t size
+) {
+    if (dictionary == NULL || (flags & KRD_FLAG_PART_EXAM)
+        || !(flags & KRD_FLAG_TRANSLATED)) return false;
+
+    char text[2 * MAX_STRING_SIZE] = "";
+
+    normalize_text(query, text, sizeof(text));
+
+    char candidates[2 * MAX_STRING_SIZE];
+
+    const char *lemmas[MAX_LEMMA_COUNT];
+
+    const int lemma_count = sr_lemma_find(
+        text, 
+        candidates, 
+        sizeof(candidates), 
+        lemmas, 
+        MAX_LEMMA_COUNT
+    );
+
+    if (lemma_count <= 0) return false;
+
+    const char *lemma = NULL;
+
+    struct sr_dict_snapshot *snapshot = sr_dict_acquire(dictionary);
+
+    // 모든 후보를 같은 목록에서 확인하고, 사전에 있는 첫 번째 후보를 사용한다.
+    for (int i = 0; i < lemma_count && lemma == NULL; i++) {
+        const char *word = NULL;
+
+        if (sr_dict_find_range(snapshot, lemmas[i], NULL, &word, 1) > 0
+            && streq(word, lemmas[i])) lemma = lemmas[i];
+    }
+
+    sr_dict_release(snapshot);
+
+    if (lemma == NULL) return false;
+
+    snprintf(buffer, size, "%s", lemma);
+
+    return true;
+}
+
+/* `/krd` 명령어의 캐시에 검색 결과를 저장한다. */
+static void sr_command_krdict_write_cache(
+    const char *key,
+    const char *records,
+    size_t records_len,
+    const char *buffer,
+    int total,
+    int count
+) {
+    if (key == NULL || total < 0) return;
+
+    if (total == 0) {
+        sr_cache_put(miss_cache, key, "", 1);
+
+        return;
+    }
+
+    struct krdict_cache_value value = { .total = total, .count = count };
+
+    memcpy(value.data, records, records_len);
+
+    sr_cache_put(
+        item_cache, 
+        key, 
+        &value, 
+        offsetof(struct krdict_cache_value, data) + records_len
+    );
+
+    size_t len = strlen(buffer) + 1;
+
+    memcpy(value.data, buffer, len);
+
+    sr_cache_put(
+        result_cache, 
+        key, 
+        &value, 
+        offsetof(struct krdict_cache_value, data) + len
+    );
+}
+
+/* 사전 데이터의 표제어 목록으로 검색어 자동 완성 색인과 블룸 필터를 만든다. */
+static void sr_command_krdict_init_headwords(void) {
+    // 색인을 다 만들기 전까지는 자동 완성과 블룸 필터 없이 응답한다.
+    sr_command_krdict_build_headwords(sr_dict_acquire(dictionary), sr_suggest_create());
+}
+
+/* 
+    주어진 사전 데이터의 표제어 목록으로 작업 스레드에서 색인을 만든다.
+    `suggest`가 `NULL`이라면, 블룸 필터만 다시 만든다.
+*/
+static void sr_command_krdict_build_headwords(
+    struct sr_dict_snapshot *snapshot, 
+    struct sr_suggest *suggest
+) {
+    struct krdict_headwords_job *job = calloc(1, sizeof(*job));
+
+    job->snapshot = snapshot;
+    job->suggest = suggest;
+    job->timestamp = sr_dict_get_timestamp(snapshot);
+
+    headwords_building = true;
+
+    // 처음 만드는 색인이 아니라면, 사용자의 검색 요청을 모두 처리한 뒤에 만든다.
+    if (suggest != NULL) sr_worker_push(on_headwords_work, on_headwords_done, job);
+    else sr_worker_push_idle(on_headwords_work, on_headwords_done, job);
+}
+
+/* 표제어를 블룸 필터에서 사용하는 형태로 바꾼다. */
+static void sr_command_krdict_fold_word(const char *word, char *buffer, size_t size) {
+    size_t len = 0;
+
+    // 표제어의 붙임표, 띄어쓰기 표시와 공백은 검색어에 없을 수도 있다.
+    for (const char *c = word; *c != '\0' && len + 1 < size; c++) {
+        if (*c == '-' || *c == '^' || *c == ' ') continue;
+
+        buffer[len++] = (*c >= 'A' && *c <= 'Z') ? *c + ('a' - 'A') : *c;
+    }
+
+    buffer[len] = '\0';
+}
+
+/* `/krd` 명령어의 검색 결과가 없을 것이 확실한지 확인한다. */
+static bool sr_command_krdict_is_known_miss(const char *key, u64bitmask flags) {
+    char value = 0;
+
+    // 최근에 검색 결과가 없었던 검색어는 다시 요청하지 않는다.
+    if (sr_cache_get(miss_cache, key, &value, sizeof(value)) > 0) return true;
+
+    const char *query = sr_command_krdict_get_query(key);
+
+    // 한국어기초사전의 표제어 목록으로는 우리말샘의 검색 결과를 알 수 없다.
+    if (query == NULL || !(flags & KRD_FLAG_TRANSLATED) || (flags & KRD_FLAG_FANOUT)) 
+        return false;
+
+    struct sr_dict_snapshot *snapshot = sr_dict_acquire(dictionary);
+
+    const uint64_t max_age = sr_config_get_krdict_dict_max_age();
+
+    const uint64_t timestamp = sr_dict_get_timestamp(snapshot);
+
+    // 오래된 사전 데이터로 만든 블룸 필터는 사용하지 않는다.
+    bool stale = (snapshot == NULL) || (max_age > 0 
+        && cog_timestamp_ms() - timestamp > max_age);
+
+    // 변경분이 추가되었다면, 새로운 표제어가 들어간 블룸 필터를 다 만들 때까지 사용하지 않는다.
+    if (snapshot != NULL && timestamp != headwords_timestamp) {
+        stale = true;
+
+        if (!headwords_building) {
+            sr_command_krdict_build_headwords(snapshot, NULL);
+
+            snapshot = NULL;
+        }
+    }
+
+    sr_dict_release(snapshot);
+
+    if (stale || headwords == NULL) return false;
+
+    char folded[2 * MAX_STRING_SIZE] = "";
+
+    sr_command_krdict_fold_word(query, folded, sizeof(folded));
+
+    return !sr_bloom_test(headwords, folded);
+}
+
+/* `/krd` 명령어의 캐시 키에서 표제어 검색의 검색어를 추출한다. */
+static const char *sr_command_krdict_get_query(const char *key) {
+    // 자동 완성과 오타 교정은 `/krd` 명령어의 첫 번째 선택지인 표제어 검색에만 사용된다.
+    if (key == NULL || strncmp(key, "word:", 5) != 0) return NULL;
+
+    const char *result = strchr(key + 5, ':');
+
+    return (result != NULL) ? result + 1 : NULL;
+}
+
+/* `/krd` 명령어의 검색 결과가 있는 검색어를 자동 완성 색인에 기록한다. */
+static void sr_command_krdict_record_query(const char *key, int total) {
+    const char *query = sr_command_krdict_get_query(key);
+
+    if (query != NULL && total > 0) sr_suggest_hit(suggestions, query);
+}
+
+/* `/krd` 명령어의 개별 검색 결과를 직렬화하여 추가한다. */
+static size_t sr_command_krdict_pack_item(
+    char *records,
+    size_t size,
+    size_t len,
+    const struct krdict_item *item,
+    int order
+) {
+    const struct krdict_span *fields[] = {
+        &item->word, 
+        &item->origin, 
+        &item->pos, 
+        &item->link, 
+        &item->dfn, 
+        &item->exam
+    };
+
+    size_t new_len = len + sizeof(order);
+
+    for (int i = 0; i < sizeof(fields) / sizeof(*fields); i++)
+        new_len += fields[i]->len + 1;
+
+    // 공간이 부족하면 더 이상 추가하지 않는다.
+    if (new_len > size) return len;
+
+    memcpy(records + len, &order, sizeof(order));
+
+    len += sizeof(order);
+
+    for (int i = 0; i < sizeof(fields) / sizeof(*fields); i++) {
+        memcpy(records + len, fields[i]->str, fields[i]->len);
+
+        len += fields[i]->len;
+
+        records[len++] = '\0';
+    }
+
+    return len;
+}
+
+/* 
+    `/krd` 명령어의 응답 데이터에서 개별 검색 결과를 추출하고, 문자열로 변환한다.
+    `count`에는 보여준 항목의 개수를 저장한다.
+    오류가 발생했다면, 오류 코드를 문자열 버퍼에 저장하고 `-1`을 반환한다.
+*/
+static int sr_command_krdict_parse_items(
+    CURLV_STR xml, 
+    char *records, 
+    size_t size,
+    size_t *len,
+    int *count,
+    char *buffer,
+    size_t buffer_size,
+    u64bitmask flags
+) {
+    *len = 0;
+    *count = 0;
+
+    if (xml.len == 0 || records == NULL) return 0;
+
+    // 파서의 크기는 응답 데이터의 크기와 관계없이 일정하다.
+    struct krdict_parser *parser = malloc(sizeof(*parser));
+
+    sr_command_krdict_parser_init(parser, records, size, buffer, buffer_size, flags);
+
+    int result = 0;
+
+    // 출력할 검색 결과를 다 읽었다면, 응답 데이터의 나머지 부분은 읽지 않는다.
+    for (size_t offset = 0; offset < xml.len && result == 0; offset += PARSE_CHUNK_SIZE) {
+        size_t chunk_len = xml.len - offset;
+
+        if (chunk_len > PARSE_CHUNK_SIZE) chunk_len = PARSE_CHUNK_SIZE;
+
+        result = sr_command_krdict_parser_feed(parser, xml.str + offset, chunk_len);
+    }
+
+    const int total = parser->total;
+
+    *len = parser->len;
+    *count = parser->count;
+
+    free(parser);
+
+    if (result < 0) return -1;
+
+    return (total > 0) ? total : 0;
+}
+
+/* `/krd` 명령어의 응답 데이터에서 사용하는 요소의 이름을 번호로 바꾼다. */
+static enum krdict_element sr_command_krdict_find_element(const char *name) {
+    const size_t len = strlen(name);
+
+    if (len == 0) return KRD_ELEM_OTHER;
+
+    // 요소 이름의 길이와 첫 글자, 마지막 글자만으로 테이블에서의 위치를 구한다.
+    const unsigned char first = name[0], last = name[len - 1];
+
+    const struct krdict_element_name *entry = &element_names[
+        (len + 4 * first + 25 * last) & (ELEMENT_TABLE_SIZE - 1)
+    ];
+
+    return (entry->name != NULL && streq(entry->name, name))
+        ? entry->element
+        : KRD_ELEM_OTHER;
+}
+
+/* `/krd` 명령어의 응답 데이터의 구조를 나타내는 해시 테이블이 올바른지 확인한다. */
+static void sr_command_krdict_check_schema(void) {
+    // 두 요소가 해시 테이블의 같은 위치를 사용한다면, `case` 값이 겹쳐서 컴파일되지 않는다.
+    switch (0) {
+#define X(slot, ...) case slot:
+        KRDICT_SCHEMA(X)
+#undef X
+        default:
+            break;
+    }
+
+    // 해시 테이블에서의 위치는 직접 구한 값이므로, 요소 이름의 해시 값과 같은지 확인한다.
+#define X(slot, name, id, ...)                                                         \
+    if (sr_command_krdict_find_element(name) != KRD_ELEM_##id)                          \
+        log_warn("[SAEROM] Element \"%s\" is not in slot %d of the /krd schema", name, slot);
+    KRDICT_SCHEMA(X)
+#undef X
+}
+
+/* `/krd` 명령어의 응답 데이터를 나누어 읽는 파서를 초기화한다. */
+static void sr_command_krdict_parser_init(
+    struct krdict_parser *parser,
+    char *records,
+    size_t size,
+    char *buffer,
+    size_t buffer_size,
+    u64bitmask flags
+) {
+    yxml_init(&parser->xml, parser->stack, sizeof(parser->stack));
+
+    parser->item = empty_item;
+
+    parser->text_len = parser->content = parser->sense = 0;
+
+    parser->truncated = false;
+    parser->depth = 0;
+    parser->records = records;
+    parser->size = size;
+    parser->len = 0;
+
+    sr_strbuf_init(&parser->output, buffer, buffer_size);
+
+    parser->flags = flags;
+
+    // 검색 결과의 개수를 아직 모르는 상태는 음수로 나타낸다.
+    parser->total = -1;
+    parser->order = 1;
+    parser->count = 0;
+    parser->entry_len = parser->entry_output = 0;
+    parser->done = false;
+}
+
+/*
+    `/krd` 명령어의 응답 데이터의 일부를 읽는다.
+    오류가 발생했다면 `-1`을, 더 읽을 필요가 없다면 `1`을, 그 외에는 `0`을 반환한다.
+*/
+static int sr_command_krdict_parser_feed(
+    struct krdict_parser *parser,
+    const char *data,
+    size_t len
+) {
+    if (parser->done) return 1;
+
+    // 응답 데이터의 끝을 나타내는 널 문자 이후는 읽지 않는다.
+    const char *end = memchr(data, '\0', len);
+
+    if (end != NULL) len = end - data;
+
+    for (size_t i = 0; i < len;) {
+        size_t consumed = 0;
+
+        yxml_ret_t result = yxml_parse_buf(&parser->xml, data + i, len - i, &consumed);
+
+        i += consumed;
+
+        if (result < 0) {
+            sr_strbuf_init(&parser->output, parser->output.str, parser->output.size);
+            sr_strbuf_printf(&parser->output, "-1");
+
+            return -1;
+        }
+
+        switch (result) {
+            case YXML_ELEMSTART: {
+                const enum krdict_element element = sr_command_krdict_find_element(
+                    parser->xml.elem
+                );
+
+                const enum krdict_context context = sr_command_krdict_parser_context(parser);
+
+                // 출력하지 않는 하위 요소는 내용을 읽지 않고 건너뛴다.
+                if (element_bindings[element][context].action == KRD_ACTION_SKIP)
+                    yxml_skip(&parser->xml);
+
+                // 너무 깊은 곳에 있는 요소는 검색 결과에 사용되지 않는다.
+                if (parser->depth < PARSE_MAX_DEPTH) parser->elements[parser->depth] = element;
+
+                parser->depth++;
+
+                // 각 항목과 뜻풀이의 내용은 다음 항목과 뜻풀이를 읽기 전에 버린다.
+                if (element == KRD_ELEM_ITEM) {
+                    parser->item = empty_item;
+
+                    parser->text_len = parser->sense = 0;
+
+                    parser->entry_len = parser->len;
+                    parser->entry_output = parser->output.len;
+                } else if (element == KRD_ELEM_SENSE) {
+                    parser->sense = parser->text_len;
+                }
+
+                parser->content = parser->text_len;
+                parser->truncated = false;
+
+                break;
+            }
+
+            case YXML_CONTENT:
+                // 내용을 한 글자씩이 아니라, 특수 문자가 없는 부분을 한 번에 읽는다.
+                for (size_t j = 0; j < parser->xml.spanlen; j++) {
+                    const char c = parser->xml.span[j];
+
+                    if (c == '\n' || c == '\t') continue;
+
+                    // 너무 긴 내용은 잘라낸다.
+                    if (parser->text_len + 1 >= sizeof(parser->text)
+                        || parser->text_len - parser->content + 1 >= PARSE_CONTENT_SIZE) {
+                        parser->truncated = true;
+
+                        continue;
+                    }
+
+                    parser->text[parser->text_len++] = c;
+                }
+
+                break;
+
+            case YXML_ELEMEND:
+                if (sr_command_krdict_parser_end_element(parser) < 0) return -1;
+
+                break;
+
+            default:
+                break;
+        }
+
+        if (parser->done) return 1;
+    }
+
+    return (end != NULL) ? 1 : 0;
+}
+
+/* `/krd` 명령어의 응답 데이터에서 현재 읽고 있는 요소의 위치를 반환한다. */
+static enum krdict_context sr_command_krdict_parser_context(
+    const struct krdict_parser *parser
+) {
+    const enum krdict_element parent = (parser->depth > 0 && parser->depth <= PARSE_MAX_DEPTH)
+        ? parser->elements[parser->depth - 1]
+        : KRD_ELEM_OTHER;
+
+    if (parent == KRD_ELEM_CHANNEL) return KRD_CONTEXT_CHANNEL;
+
+    return (parser->flags & KRD_FLAG_PART_EXAM) ? KRD_CONTEXT_EXAM : KRD_CONTEXT_WORD;
+}
+
+/* `/krd` 명령어의 응답 데이터에서 요소 하나를 다 읽었을 때 호출되는 함수. */
+static int sr_command_krdict_parser_end_element(struct krdict_parser *parser) {
+    char *content = parser->text + parser->content;
+
+    // 잘린 내용의 끝에 남은 UTF-8 문자의 일부는 버린다.
+    if (parser->truncated) {
+        size_t len = parser->text_len;
+
+        while (len > parser->content && (parser->text[len - 1] & 0xC0) == 0x80) len--;
+
+        if (len > parser->content) {
+            const unsigned char lead = parser->text[len - 1];
+
+            const size_t width = (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : (lead >= 0xC0) ? 2 : 1;
+
+            if (len - 1 + width <= parser->text_len) len = parser->text_len;
+            else len--;
+        }
+
+        parser->text_len = len;
+    }
+
+    parser->text[parser->text_len] = '\0';
+
+    struct krdict_span span = {
+        .str = content,
+        .len = parser->text_len - parser->content
+    };
+
+    // 요소를 닫은 뒤에는, 상위 요소를 닫는 것으로 본다.
+    parser->depth--;
+
+    const enum krdict_element element = (parser->depth >= 0 && parser->depth < PARSE_MAX_DEPTH)
+        ? parser->elements[parser->depth]
+        : KRD_ELEM_OTHER;
+
+    const enum krdict_element parent = (parser->depth > 0 && parser->depth <= PARSE_MAX_DEPTH)
+        ? parser->elements[parser->depth - 1]
+        : KRD_ELEM_OTHER;
+
+    if (parent == KRD_ELEM_ERROR) {
+        sr_strbuf_init(&parser->output, parser->output.str, parser->output.size);
+        sr_strbuf_printf(&parser->output, "%s", content);
+
+        return -1;
+    }
+
+    const enum krdict_context context = sr_command_krdict_parser_context(parser);
+
+    const struct krdict_binding *binding = &element_bindings[element][context];
+
+    struct krdict_span *field = (binding->field >= 0)
+        ? (struct krdict_span *) ((char *) &parser->item + binding->field)
+        : NULL;
+
+    // 검색 결과에 사용되는 내용만 남겨두고, 나머지 내용은 버린다.
+    if (field != NULL) {
+        // 같은 필드의 이전 내용이 바로 앞에 있다면, 그 자리를 다시 사용한다.
+        if (field->len > 0 && field->str + field->len + 1 == span.str) {
+            const size_t offset = field->str - parser->text;
+
+            memmove(parser->text + offset, span.str, span.len + 1);
+
+            span.str = parser->text + offset;
+
+            parser->text_len = offset + span.len;
+        }
+
+        *field = span;
+
+        if (parser->text_len + 1 < sizeof(parser->text)) parser->text_len++;
+    } else if (parser->text_len > parser->content) {
+        parser->text_len = parser->content;
+    }
+
+    switch (binding->action) {
+        case KRD_ACTION_TOTAL:
+            parser->total = atoi(content);
+
+            // 검색 결과가 없다면, 더 읽을 필요가 없다.
+            if (parser->total == 0) parser->done = true;
+
+            break;
+
+        case KRD_ACTION_ORDER:
+            parser->order = atoi(content);
+
+            break;
+
+        case KRD_ACTION_ADD_ITEM:
+            sr_command_krdict_parser_add_item(parser);
+
+            break;
+
+        case KRD_ACTION_ADD_NEXT_ITEM:
+            sr_command_krdict_parser_add_item(parser);
+
+            parser->order++;
+
+            break;
+
+        default:
+            break;
+    }
+
+    // 최대 개수를 넘는 검색 결과는 출력하지 않으므로, 나머지 부분은 읽지 않는다.
+    if (context == KRD_CONTEXT_WORD && parser->order > MAX_ORDER_COUNT)
+        parser->done = true;
+    else if (context == KRD_CONTEXT_EXAM && parser->order > MAX_EXAMPLE_COUNT)
+        parser->done = true;
+
+    parser->content = parser->text_len;
+    parser->truncated = false;
+
+    return 0;
+}
+
+/* `/krd` 명령어의 개별 검색 결과를 직렬화하여 추가하고, 문자열로 변환한다. */
+static void sr_command_krdict_parser_add_item(struct krdict_parser *parser) {
+    // 지금 읽고 있는 항목의 뜻풀이를 이미 보여주었는지 확인한다.
+    const bool shown = (parser->len > parser->entry_len);
+
+    const size_t len = sr_command_krdict_pack_item(
+        parser->records,
+        parser->size,
+        parser->len,
+        &parser->item,
+        parser->order
+    );
+
+    if (len > parser->len)
+        sr_command_krdict_render_item(&parser->item, parser->order, &parser->output, parser->flags);
+
+    // 직렬화하거나 출력 결과를 저장할 공간이 부족하다면, 나머지 검색 결과는 읽지 않는다.
+    if (len == parser->len || parser->output.truncated) {
+        /*
+            일부만 보여준 항목은 빼고, 다음 페이지에서 처음부터 보여준다.
+            페이지의 첫 번째 항목은 그대로 두어야 다음 페이지로 넘어갈 수 있다.
+        */
+        if (!shown || parser->count > 1) {
+            if (shown) parser->count--;
+
+            parser->len = parser->entry_len;
+
+            sr_strbuf_rewind(&parser->output, parser->entry_output);
+        }
+
+        parser->done = true;
+
+        return;
+    }
+
+    if (!shown) parser->count++;
+
+    parser->len = len;
+
+    struct krdict_span *fields[] = {
+        &parser->item.word,
+        &parser->item.origin,
+        &parser->item.pos,
+        &parser->item.link,
+        &parser->item.dfn,
+        &parser->item.exam
+    };
+
+    // 뜻풀이마다 다른 내용은 다음 뜻풀이를 읽기 전에 버린다.
+    for (int i = 0; i < sizeof(fields) / sizeof(*fields); i++)
+        if (fields[i]->len > 0 && fields[i]->str >= parser->text + parser->sense)
+            *fields[i] = empty_item.word;
+
+    parser->text_len = parser->sense;
+}
+
+/* `/krd` 명령어의 개별 검색 결과를 문자열로 변환하고, 보여준 항목의 개수를 반환한다. */
+static int sr_command_krdict_render_items(
+    const char *records,
+    size_t len,
+    struct sr_strbuf *sb,
+    u64bitmask flags
+) {
+    const char *ptr = records, *end = records + len;
+
+    const char *link = NULL;
+
+    size_t entry_output = sb->len;
+
+    struct krdict_item item;
+
+    int order, count = 0;
+
+    while ((ptr = sr_command_krdict_unpack_item(ptr, end, &item, &order)) != NULL) {
+        // 용례는 하나가 한 항목이고, 뜻풀이는 같은 표제어의 것끼리 한 항목이다.
+        const bool shown = !(flags & KRD_FLAG_PART_EXAM) 
+            && link != NULL && streq(link, item.link.str);
+
+        if (!shown) entry_output = sb->len;
+
+        link = item.link.str;
+
+        sr_command_krdict_render_item(&item, order, sb, flags);
+
+        // 일부만 보여준 항목은 빼고, 다음 페이지에서 처음부터 보여준다.
+        if (sb->truncated) {
+            if (!shown || count > 1) {
+                if (shown) count--;
+
+                sr_strbuf_rewind(sb, entry_output);
+            }
+
+            break;
+        }
+
+        if (!shown) count++;
+    }
+
+    return count;
+}
+
+/* `/krd` 명령어의 직렬화된 검색 결과 하나를 읽고, 다음 검색 결과의 위치를 반환한다. */
+static const char *sr_command_krdict_unpack_item(
+    const char *ptr,
+    const char *end,
+    struct krdict_item *item,
+    int *order
+) {
+    if (ptr + sizeof(*order) >= end) return NULL;
+
+    memcpy(order, ptr, sizeof(*order));
+
+    ptr += sizeof(*order);
+
+    struct krdict_span *fields[] = {
+        &item->word,
+        &item->origin,
+        &item->pos,
+        &item->link,
+        &item->dfn,
+        &item->exam
+    };
+
+    // 직렬화된 검색 결과의 각 필드를 복사하지 않고 그대로 사용한다.
+    for (int i = 0; i < sizeof(fields) / sizeof(*fields); i++) {
+        fields[i]->str = ptr;
+        fields[i]->len = strlen(ptr);
+
+        ptr += fields[i]->len + 1;
+    }
+
+    return ptr;
+}
+
+/* `/krd` 명령어의 개별 검색 결과 하나를 문자열로 변환하여 추가한다. */
+static void sr_command_krdict_render_item(
+    const struct krdict_item *item,
+    int order,
+    struct sr_strbuf *sb,
+    u64bitmask flags
+) {
+    if (flags & KRD_FLAG_PART_EXAM) {
+        sr_strbuf_printf(sb, "%d. %.*s\n\n", order, (int) item->exam.len, item->exam.str);
+
+        return;
+    }
+
+    const size_t len = sb->len;
+
+    const struct krdict_span item_pos = (item->pos.len > 0)
+        ? item->pos
+        : (struct krdict_span) { .str = "?", .len = 1 };
+
+    if (item->origin.len > 0) {
+        sr_strbuf_printf(
+            sb,
+            "[**%.*s (%.*s) 「%.*s」**](%.*s)\n\n",
+            (int) item->word.len,
+            item->word.str,
+            (int) item->origin.len,
+            item->origin.str,
+            (int) item_pos.len,
+            item_pos.str,
+            (int) item->link.len,
+            item->link.str
+        );
+    } else {
+        sr_strbuf_printf(
+            sb,
+            "[**%.*s 「%.*s」**](%.*s)\n\n",
+            (int) item->word.len,
+            item->word.str,
+            (int) item_pos.len,
+            item_pos.str,
+            (int) item->link.len,
+            item->link.str
+        );
+    }
+
+    // 번역이 없는 뜻풀이 (우리말샘의 검색 결과 등)는 번역 대신 뜻풀이만 보여준다.
+    if ((flags & KRD_FLAG_TRANSLATED) && item->exam.len == 0) {
+        sr_strbuf_printf(sb, "**%d. %.*s**\n\n", order, (int) item->dfn.len, item->dfn.str);
+    } else if (flags & KRD_FLAG_TRANSLATED) {
+        sr_strbuf_printf(
+            sb,
+            "**%d. %.*s**\n"
+            "- %.*s\n\n",
+            order,
+            (int) item->dfn.len,
+            item->dfn.str,
+            (int) item->exam.len,
+            item->exam.str
+        );
+    } else {
+        sr_strbuf_printf(sb, "- %.*s\n\n", (int) item->dfn.len, item->dfn.str);
+    }
+
+    // 뜻풀이가 잘린 표제어는 보여주지 않는다.
+    if (sb->truncated) sr_strbuf_rewind(sb, len);
 }
\ No newline at end of file
@@ -0,0 +1,464 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <saerom.h>
+
+/* | `lemma` 모듈 매크로 정의... | */
+
+#define MAX_SYLLABLE_COUNT  32
+
+#define SYLLABLE_BEGIN      0xAC00
+#define SYLLABLE_END        0xD7A3
+
+/* 한글 음절의 초성, 중성, 종성 번호. */
+#define INITIAL_NIEUN       2
+#define INITIAL_RIEUL       5
+#define INITIAL_BIEUP       7
+#define INITIAL_SIOS        9
+#define INITIAL_IEUNG       11
+#define INITIAL_HIEUH       18
+
+#define MEDIAL_A            0
+#define MEDIAL_AE           1
+#define MEDIAL_EO           4
+#define MEDIAL_E            5
+#define MEDIAL_YEO          6
+#define MEDIAL_O            8
+#define MEDIAL_WA           9
+#define MEDIAL_WAE          10
+#define MEDIAL_OE           11
+#define MEDIAL_U            13
+#define MEDIAL_WO           14
+#define MEDIAL_EU           18
+#define MEDIAL_I            20
+
+#define FINAL_NONE          0
+#define FINAL_NIEUN         4
+#define FINAL_DIGEUT        7
+#define FINAL_RIEUL         8
+#define FINAL_MIEUM         16
+#define FINAL_BIEUP         17
+#define FINAL_SIOS          19
+#define FINAL_SSANGSIOS     20
+#define FINAL_HIEUH         27
+
+/* | `lemma` 모듈 자료형 정의... | */
+
+/* 어간의 모음과 어미 `-아/어`가 줄어드는 규칙을 나타내는 구조체. */
+struct sr_lemma_contraction {
+    int medial;
+    int stem_medial;
+    int ending_medial;
+};
+
+/* 기본형 후보를 만드는 중인 상태를 나타내는 구조체. */
+struct sr_lemma_context {
+    const uint32_t *syllables;
+    int len;
+    char *buffer;
+    size_t size;
+    size_t buffer_len;
+    const char **lemmas;
+    int count;
+    int max_count;
+};
+
+/* | `lemma` 모듈 상수 및 변수... | */
+
+/* 선어말 어미 목록 (높임, 시제 순). */
+static const char *prefinal_endings[] = {
+    "으셨", "셨", "으시", "시", "었", "았", "였", "겠"
+};
+
+/* 어말 어미 목록. 받침으로만 된 어미는 호환용 자모로 나타낸다. */
+static const char *final_endings[] = {
+    "다", "ㄴ다", "는다", "어", "아", "여", "어요", "아요", "여요", "요",
+    "습니다", "ㅂ니다", "습니까", "ㅂ니까", "네", "네요", "지", "지요", "죠",
+    "고", "고요", "게", "기", "음", "ㅁ", "는", "은", "ㄴ", "을", "ㄹ",
+    "면", "으면", "니", "으니", "니까", "으니까", "서", "어서", "아서", "여서",
+    "도", "어도", "아도", "여도", "야", "어야", "아야", "여야", "세요", "셔요",
+    "십시오", "자", "자요", "는데", "은데", "ㄴ데", "던", "거나", "지만", "려고",
+    "으려고", "ㄹ게", "을게", "ㄹ게요", "을게요", "ㄹ까", "을까", "ㄹ까요", "을까요",
+    "라", "어라", "아라", "는지", "은지", "ㄴ지", "어서요", "아서요", "여서요"
+};
+
+/* 어간의 모음과 어미 `-아/어`가 줄어드는 규칙 목록. */
+static const struct sr_lemma_contraction contractions[] = {
+    { MEDIAL_A, MEDIAL_A, MEDIAL_A },       // 가- + -아 → 가
+    { MEDIAL_A, MEDIAL_EU, MEDIAL_A },      // 바쁘- + -아 → 바빠
+    { MEDIAL_EO, MEDIAL_EO, MEDIAL_EO },    // 서- + -어 → 서
+    { MEDIAL_EO, MEDIAL_EU, MEDIAL_EO },    // 예쁘- + -어 → 예뻐
+    { MEDIAL_EO, MEDIAL_U, MEDIAL_EO },     // 푸- + -어 → 퍼
+    { MEDIAL_AE, MEDIAL_AE, MEDIAL_EO },    // 보내- + -어 → 보내
+    { MEDIAL_AE, MEDIAL_A, MEDIAL_YEO },    // 하- + -여 → 해
+    { MEDIAL_E, MEDIAL_E, MEDIAL_EO },      // 세- + -어 → 세
+    { MEDIAL_YEO, MEDIAL_I, MEDIAL_EO },    // 마시- + -어 → 마셔
+    { MEDIAL_WA, MEDIAL_O, MEDIAL_A },      // 보- + -아 → 봐
+    { MEDIAL_WO, MEDIAL_U, MEDIAL_EO },     // 주- + -어 → 줘
+    { MEDIAL_WAE, MEDIAL_OE, MEDIAL_EO }    // 되- + -어 → 돼
+};
+
+/* | `lemma` 모듈 함수... | */
+
+/* 주어진 문자열을 유니코드 코드 포인트로 변환한다. */
+static int sr_lemma_decode(const char *word, uint32_t *syllables, int size);
+
+/* 유니코드 코드 포인트를 UTF-8 문자열로 변환하여 추가한다. */
+static size_t sr_lemma_encode(
+    const uint32_t *codepoints,
+    int len,
+    char *buffer,
+    size_t size
+);
+
+/* 초성, 중성, 종성 번호로 한글 음절을 만든다. */
+static uint32_t sr_lemma_compose(int initial, int medial, int final);
+
+/* 종성 번호에 해당하는 호환용 자모를 반환한다. */
+static uint32_t sr_lemma_get_final_jamo(int final);
+
+/* 주어진 어미가 선어말 어미와 어말 어미로 이루어져 있는지 확인한다. */
+static bool sr_lemma_is_ending(const char *ending);
+
+/* 어간과 어미가 올바르다면, 어간의 기본형을 후보 목록에 추가한다. */
+static void sr_lemma_emit(
+    struct sr_lemma_context *context,
+    int prefix_len,
+    const uint32_t *stem,
+    int stem_len,
+    const uint32_t *ending,
+    int ending_len
+);
+
+/*
+    주어진 활용형의 기본형 후보들을 가능성이 높은 순서대로 찾는다.
+    각 후보는 `buffer`에 저장되며, `lemmas`는 `buffer`의 각 후보를 가리킨다.
+*/
+int sr_lemma_find(
+    const char *word,
+    char *buffer,
+    size_t size,
+    const char **lemmas,
+    int count
+) {
+    if (word == NULL || buffer == NULL || lemmas == NULL || count <= 0) return 0;
+
+    uint32_t syllables[MAX_SYLLABLE_COUNT];
+
+    const int len = sr_lemma_decode(word, syllables, MAX_SYLLABLE_COUNT);
+
+    if (len <= 0) return 0;
+
+    struct sr_lemma_context context = {
+        .syllables = syllables,
+        .len = len,
+        .buffer = buffer,
+        .size = size,
+        .lemmas = lemmas,
+        .max_count = count
+    };
+
+    // 어간이 긴 후보부터 확인한다.
+    for (int k = len - 1; k >= 0; k--) {
+        const uint32_t index = syllables[k] - SYLLABLE_BEGIN;
+
+        const int initial = index / 588;
+        const int medial = (index % 588) / 28;
+        const int final = index % 28;
+
+        const uint32_t *rest = syllables + k + 1;
+
+        const int rest_len = len - (k + 1);
+
+        uint32_t stem[2], ending[MAX_SYLLABLE_COUNT + 1];
+
+        const uint32_t next = (rest_len > 0) ? rest[0] - SYLLABLE_BEGIN : 0;
+
+        const int next_initial = next / 588, next_medial = (next % 588) / 28;
+
+        // 모음 `ㅏ/ㅓ`로 끝나는 어간 뒤의 `-아/어`는 반드시 줄어든다.
+        const bool contracted = (final == FINAL_NONE && rest_len > 0
+            && (medial == MEDIAL_A || medial == MEDIAL_EO)
+            && next_initial == INITIAL_IEUNG 
+            && (next_medial == MEDIAL_A || next_medial == MEDIAL_EO));
+
+        // 규칙 활용: 먹- + -었어요
+        if (!contracted) sr_lemma_emit(&context, k, &syllables[k], 1, rest, rest_len);
+
+        if (final == FINAL_NONE && rest_len > 0) {
+            // ㄹ 탈락: 사- + -세요 → 살다
+            if (next_initial == INITIAL_NIEUN || next_initial == INITIAL_BIEUP
+                || next_initial == INITIAL_SIOS) {
+                stem[0] = sr_lemma_compose(initial, medial, FINAL_RIEUL);
+
+                sr_lemma_emit(&context, k, stem, 1, rest, rest_len);
+            }
+
+            // ㅅ 불규칙: 나- + -아요 → 낫다
+            if (next_initial == INITIAL_IEUNG) {
+                stem[0] = sr_lemma_compose(initial, medial, FINAL_SIOS);
+
+                sr_lemma_emit(&context, k, stem, 1, rest, rest_len);
+            }
+
+            // ㅂ 불규칙: 고마- + -운 → 고맙다
+            if (next_initial == INITIAL_IEUNG && next_medial == MEDIAL_U) {
+                stem[0] = sr_lemma_compose(initial, medial, FINAL_BIEUP);
+
+                ending[0] = sr_lemma_compose(INITIAL_IEUNG, MEDIAL_EU, next % 28);
+
+                memcpy(ending + 1, rest + 1, (rest_len - 1) * sizeof(*ending));
+
+                sr_lemma_emit(&context, k, stem, 1, ending, rest_len);
+            }
+        }
+
+        if (final == FINAL_NIEUN || final == FINAL_RIEUL
+            || final == FINAL_MIEUM || final == FINAL_BIEUP) {
+            // 받침으로 된 어미: 가- + -ㅂ니다
+            ending[0] = sr_lemma_get_final_jamo(final);
+
+            memcpy(ending + 1, rest, rest_len * sizeof(*ending));
+
+            stem[0] = sr_lemma_compose(initial, medial, FINAL_NONE);
+
+            sr_lemma_emit(&context, k, stem, 1, ending, rest_len + 1);
+
+            // ㄹ 탈락: 사- + -ㄴ다 → 살다
+            stem[0] = sr_lemma_compose(initial, medial, FINAL_RIEUL);
+
+            sr_lemma_emit(&context, k, stem, 1, ending, rest_len + 1);
+
+            // ㅎ 불규칙: 빨가- + -ㄴ → 빨갛다
+            stem[0] = sr_lemma_compose(initial, medial, FINAL_HIEUH);
+
+            sr_lemma_emit(&context, k, stem, 1, ending, rest_len + 1);
+        }
+
+        if (final == FINAL_RIEUL && rest_len > 0) {
+            // ㄷ 불규칙: 들- + -었어요 → 듣다
+            stem[0] = sr_lemma_compose(initial, medial, FINAL_DIGEUT);
+
+            sr_lemma_emit(&context, k, stem, 1, rest, rest_len);
+
+            // 르 불규칙: 몰- + 라요 → 모르다
+            if (next_initial == INITIAL_RIEUL 
+                && (next_medial == MEDIAL_A || next_medial == MEDIAL_EO)) {
+                stem[0] = sr_lemma_compose(initial, medial, FINAL_NONE);
+                stem[1] = sr_lemma_compose(INITIAL_RIEUL, MEDIAL_EU, FINAL_NONE);
+
+                ending[0] = sr_lemma_compose(INITIAL_IEUNG, next_medial, next % 28);
+
+                memcpy(ending + 1, rest + 1, (rest_len - 1) * sizeof(*ending));
+
+                sr_lemma_emit(&context, k, stem, 2, ending, rest_len);
+            }
+        }
+
+        if (final != FINAL_NONE && final != FINAL_SSANGSIOS) continue;
+
+        // 어간의 모음과 어미 `-아/어`가 줄어든 음절: 봐요 → 보- + -아요
+        for (int i = 0; i < sizeof(contractions) / sizeof(*contractions); i++) {
+            if (contractions[i].medial != medial) continue;
+
+            // 하다: 해요 → 하- + -여요
+            if (contractions[i].ending_medial == MEDIAL_YEO && initial != INITIAL_HIEUH)
+                continue;
+
+            stem[0] = sr_lemma_compose(initial, contractions[i].stem_medial, FINAL_NONE);
+
+            ending[0] = sr_lemma_compose(INITIAL_IEUNG, contractions[i].ending_medial, final);
+
+            memcpy(ending + 1, rest, rest_len * sizeof(*ending));
+
+            sr_lemma_emit(&context, k, stem, 1, ending, rest_len + 1);
+        }
+
+        // ㅎ 불규칙: 그래요 → 그렇- + -어요
+        if (medial == MEDIAL_AE) {
+            const int stem_medials[] = { MEDIAL_EO, MEDIAL_A };
+
+            for (int i = 0; i < 2; i++) {
+                stem[0] = sr_lemma_compose(initial, stem_medials[i], FINAL_HIEUH);
+
+                ending[0] = sr_lemma_compose(INITIAL_IEUNG, stem_medials[i], final);
+
+                memcpy(ending + 1, rest, rest_len * sizeof(*ending));
+
+                sr_lemma_emit(&context, k, stem, 1, ending, rest_len + 1);
+            }
+        }
+
+        // ㅂ 불규칙: 더워요 → 덥- + -어요
+        if (k > 0 && initial == INITIAL_IEUNG && (medial == MEDIAL_WO || medial == MEDIAL_WA)) {
+            const uint32_t prev = syllables[k - 1] - SYLLABLE_BEGIN;
+
+            if (prev % 28 == FINAL_NONE) {
+                stem[0] = syllables[k - 1] + FINAL_BIEUP;
+
+                ending[0] = sr_lemma_compose(
+                    INITIAL_IEUNG,
+                    (medial == MEDIAL_WO) ? MEDIAL_EO : MEDIAL_A,
+                    final
+                );
+
+                memcpy(ending + 1, rest, rest_len * sizeof(*ending));
+
+                sr_lemma_emit(&context, k - 1, stem, 1, ending, rest_len + 1);
+            }
+        }
+    }
+
+    return context.count;
+}
+
+/* 주어진 문자열을 유니코드 코드 포인트로 변환한다. */
+static int sr_lemma_decode(const char *word, uint32_t *syllables, int size) {
+    int len = 0;
+
+    for (const unsigned char *c = (const unsigned char *) word; *c != '\0'; c++) {
+        // 검색어 끝의 문장 부호는 무시한다.
+        if (strchr(" .,!?~", *c) != NULL) {
+            if (strspn((const char *) c, " .,!?~") == strlen((const char *) c)) break;
+
+            return -1;
+        }
+
+        // 한글 음절 (3바이트) 외의 문자가 있다면, 활용형으로 보지 않는다.
+        if ((c[0] & 0xF0) != 0xE0 || (c[1] & 0xC0) != 0x80 || (c[2] & 0xC0) != 0x80)
+            return -1;
+
+        const uint32_t codepoint = ((c[0] & 0x0F) << 12) | ((c[1] & 0x3F) << 6) | (c[2] & 0x3F);
+
+        if (codepoint < SYLLABLE_BEGIN || codepoint > SYLLABLE_END || len >= size)
+            return -1;
+
+        syllables[len++] = codepoint;
+
+        c += 2;
+    }
+
+    return len;
+}
+
+/* 유니코드 코드 포인트를 UTF-8 문자열로 변환하여 추가한다. */
+static size_t sr_lemma_encode(
+    const uint32_t *codepoints,
+    int len,
+    char *buffer,
+    size_t size
+) {
+    size_t result = strlen(buffer);
+
+    // 한글 음절과 호환용 자모는 모두 UTF-8에서 3바이트를 차지한다.
+    for (int i = 0; i < len && result + 3 < size; i++) {
+        buffer[result++] = 0xE0 | (codepoints[i] >> 12);
+        buffer[result++] = 0x80 | ((codepoints[i] >> 6) & 0x3F);
+        buffer[result++] = 0x80 | (codepoints[i] & 0x3F);
+    }
+
+    buffer[result] = '\0';
+
+    return result;
+}
+
+/* 초성, 중성, 종성 번호로 한글 음절을 만든다. */
+static uint32_t sr_lemma_compose(int initial, int medial, int final) {
+    return SYLLABLE_BEGIN + (initial * 21 + medial) * 28 + final;
+}
+
+/* 종성 번호에 해당하는 호환용 자모를 반환한다. */
+static uint32_t sr_lemma_get_final_jamo(int final) {
+    switch (final) {
+        case FINAL_NIEUN:
+            return 0x3134;
+
+        case FINAL_RIEUL:
+            return 0x3139;
+
+        case FINAL_MIEUM:
+            return 0x3141;
+
+        case FINAL_BIEUP:
+            return 0x3142;
+
+        default:
+            return 0;
+    }
+}
+
+/* 주어진 어미가 선어말 어미와 어말 어미로 이루어져 있는지 확인한다. */
+static bool sr_lemma_is_ending(const char *ending) {
+    for (int i = 0; i < sizeof(final_endings) / sizeof(*final_endings); i++)
+        if (streq(ending, final_endings[i])) return true;
+
+    for (int i = 0; i < sizeof(prefinal_endings) / sizeof(*prefinal_endings); i++) {
+        const size_t len = strlen(prefinal_endings[i]);
+
+        if (strncmp(ending, prefinal_endings[i], len) == 0 && ending[len] != '\0'
+            && sr_lemma_is_ending(ending + len)) return true;
+    }
+
+    return false;
+}
+
+/* 어간과 어미가 올바르다면, 어간의 기본형을 후보 목록에 추가한다. */
+static void sr_lemma_emit(
+    struct sr_lemma_context *context,
+    int prefix_len,
+    const uint32_t *stem,
+    int stem_len,
+    const uint32_t *ending,
+    int ending_len
+) {
+    if (context->count >= context->max_count) return;
+
+    char text[(MAX_SYLLABLE_COUNT + 1) * 3 + 1] = "";
+
+    // 조사를 떼어 낸 체언은 더 짧은 다른 체언일 수 있으므로 (사랑 → 사), 후보로 쓰지 않는다.
+    if (ending_len <= 0) return;
+
+    sr_lemma_encode(ending, ending_len, text, sizeof(text));
+
+    if (!sr_lemma_is_ending(text)) return;
+
+    char lemma[(MAX_SYLLABLE_COUNT + 2) * 3 + 1] = "";
+
+    sr_lemma_encode(context->syllables, prefix_len, lemma, sizeof(lemma));
+    sr_lemma_encode(stem, stem_len, lemma, sizeof(lemma));
+
+    // 용언의 기본형은 어간에 `-다`를 붙인 형태이다.
+    strcat(lemma, "다");
+
+    char original[MAX_SYLLABLE_COUNT * 3 + 1] = "";
+
+    sr_lemma_encode(context->syllables, context->len, original, sizeof(original));
+
+    if (*lemma == '\0' || streq(lemma, original)) return;
+
+    for (int i = 0; i < context->count; i++)
+        if (streq(context->lemmas[i], lemma)) return;
+
+    const size_t len = strlen(lemma) + 1;
+
+    if (context->buffer_len + len > context->size) return;
+
+    memcpy(context->buffer + context->buffer_len, lemma, len);
+
+    context->lemmas[context->count++] = context->buffer + context->buffer_len;
+    context->buffer_len += len;
+}
\ No newline at end of file
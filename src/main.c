@@ -15,9 +15,31 @@
     along with this program. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <unistd.h>
+
 #include <saerom.h>
 
 int main(int argc, char *argv[]) {
+    // 사전 데이터 파일을 만드는 경우, Discord 봇을 실행하지 않는다.
+    if (argc > 1 && (streq(argv[1], "--import") || streq(argv[1], "--update"))) {
+        const char *inputs[argc], *output = DEFAULT_DICT_PATH;
+
+        int count = 0, threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+        for (int i = 2; i < argc; i++) {
+            if (streq(argv[i], "-o") && i + 1 < argc) output = argv[++i];
+            else if (streq(argv[i], "-j") && i + 1 < argc) threads = atoi(argv[++i]);
+            else inputs[count++] = argv[i];
+        }
+
+        // 변경분은 실행 중인 Discord 봇이 다시 시작하지 않고 읽어 들인다.
+        const bool result = streq(argv[1], "--update")
+            ? sr_dict_update(inputs, count, output, threads)
+            : sr_dict_import(inputs, count, output, threads);
+
+        return result ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     sr_bot_init(argc, argv);
 
     sr_bot_run();
@@ -153,11 +153,25 @@ void sr_command_msg_run(
         else if (streq(name, "embed")) as_embed = streq(value, "true");
     }
 
+    // 메시지의 길이 제한을 넘는 내용은 줄 단위로 잘라낸다.
+    const size_t size = (as_embed) 
+        ? DISCORD_EMBED_DESCRIPTION_LEN 
+        : DISCORD_MAX_MESSAGE_LEN;
+
+    char *content = malloc(size);
+
+    struct sr_strbuf sb;
+
+    sr_strbuf_init(&sb, content, size);
+
+    if (!sr_strbuf_append(&sb, message, strlen(message)))
+        log_warn("[SAEROM] Truncated the message to %zu bytes", sb.len);
+
     const struct discord_user *self = discord_get_self(client);
 
     struct discord_embed embeds[] = {
         {
-            .description = message,
+            .description = content,
             .timestamp = discord_timestamp(client),
             .footer = &(struct discord_embed_footer) {
                 .text = "⚡"
@@ -184,7 +198,7 @@ void sr_command_msg_run(
         client, 
         channel_id,
         &(struct discord_create_message) {
-            .content = (!as_embed) ? message : NULL,
+            .content = (!as_embed) ? content : NULL,
             .embeds = (as_embed) 
                     ? &(struct discord_embeds) {
                 .size = sizeof(embeds) / sizeof(*embeds),
@@ -198,6 +212,8 @@ void sr_command_msg_run(
             .fail = on_message_failure
         }
     );
+
+    free(content);
 }
 
 /* `/stop` 명령어를 생성한다. */
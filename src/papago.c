@@ -19,8 +19,37 @@
 
 #include <saerom.h>
 
+/* | `papago` 모듈 매크로 정의... | */
+
+#define CACHE_VALUE_SIZE  (4 * MAX_STRING_SIZE)
+
+/* | `papago` 모듈 자료형 정의... | */
+
+/* `/ppg` 명령어의 번역 요청을 나타내는 구조체. */
+struct papago_request {
+    char text[MAX_STRING_SIZE + 1];
+    char key[2 * MAX_STRING_SIZE];
+};
+
+/* `/ppg` 명령어의 응답 데이터 가공 작업을 나타내는 구조체. */
+struct papago_job {
+    struct sr_command_context *context;
+    CURLV_STR res;
+    JsonNode *root;
+    const char *error_code;
+    const char *source_lang;
+    const char *target_lang;
+    const char *translated_text;
+};
+
 /* | `papago` 모듈 상수 및 변수... | */
 
+/* `/ppg` 명령어의 번역 결과 캐시. */
+static struct sr_cache *translation_cache;
+
+/* `/ppg` 명령어 캐시 덕분에 요청하지 않은 글자 수. */
+static uint64_t saved_characters;
+
 /* `/ppg` 명령어의 원본 언어 및 목적 언어 목록.*/
 static struct discord_application_command_option_choice languages[] = {
     { .name = "Chinese (Simplified)",  .value = "\"zh-CN\"" },
@@ -86,14 +115,63 @@ static void on_component_interaction(
     const struct discord_interaction *event
 );
 
-/* 국립국어원 한국어기초사전 API로부터 응답을 받았을 때 호출되는 함수. */
-static void on_response_from_krdict(CURLV_STR res, void *user_data);
+/* `/ppg` 명령어의 번역 결과를 전송한다. */
+static void sr_command_papago_send_results(
+    struct discord *client,
+    const struct discord_interaction *event,
+    const char *source_lang,
+    const char *source_text,
+    const char *target_lang,
+    const char *target_text,
+    bool deferred
+);
+
+/* `/ppg` 명령어의 캐시 키를 만든다. */
+static void sr_command_papago_get_cache_key(
+    const char *source,
+    const char *target,
+    const char *text,
+    char *buffer,
+    size_t size
+);
+
+/* `/ppg` 명령어의 캐시에서 번역 결과를 읽는다. */
+static bool sr_command_papago_read_cache(
+    const char *key,
+    char *buffer,
+    size_t size,
+    const char **source_lang,
+    const char **target_lang,
+    const char **translated_text
+);
+
+/* `/ppg` 명령어의 캐시에 번역 결과를 저장한다. */
+static void sr_command_papago_write_cache(
+    const char *key,
+    const char *source_lang,
+    const char *target_lang,
+    const char *translated_text
+);
 
 /* NAVER™ Papago NMT API로부터 응답을 받았을 때 호출되는 함수. */
 static void on_response_from_papago(CURLV_STR res, void *user_data);
 
+/* 작업 스레드에서 번역 결과를 가공할 때 호출되는 함수. */
+static void on_papago_job_work(void *data);
+
+/* 번역 결과의 가공이 끝났을 때 호출되는 함수. */
+static void on_papago_job_done(void *data);
+
 /* `/ppg` 명령어를 생성한다. */
 void sr_command_papago_init(struct discord *client) {
+    // 한 번만 번역된 긴 문장이 자주 사용되는 번역 결과를 밀어내지 않도록 한다.
+    translation_cache = sr_cache_open(
+        sr_config_get_papago_cache_path(),
+        sr_config_get_papago_cache_budget(),
+        sr_config_get_papago_cache_ttl(),
+        SR_CACHE_POLICY_TINYLFU
+    );
+
     discord_create_global_application_command(
         client,
         sr_config_get_application_id(),
@@ -104,7 +182,9 @@ void sr_command_papago_init(struct discord *client) {
 
 /* `/ppg` 명령어에 할당된 메모리를 해제한다. */
 void sr_command_papago_cleanup(struct discord *client) {
-    /* no-op */
+    sr_cache_release(translation_cache);
+
+    translation_cache = NULL;
 }
 
 /* `/ppg` 명령어를 실행한다. */
@@ -179,6 +259,49 @@ void sr_command_papago_run(
         return;
     }
 
+    struct papago_request *data = calloc(1, sizeof(*data));
+
+    strncpy(data->text, text, sizeof(data->text) - 1);
+
+    sr_command_papago_get_cache_key(
+        source, 
+        target, 
+        text, 
+        data->key, 
+        sizeof(data->key)
+    );
+
+    {
+        char value[CACHE_VALUE_SIZE];
+
+        const char *source_lang, *target_lang, *translated_text;
+
+        if (sr_command_papago_read_cache(
+            data->key,
+            value,
+            sizeof(value),
+            &source_lang,
+            &target_lang,
+            &translated_text
+        )) {
+            saved_characters += text_length;
+
+            sr_command_papago_send_results(
+                client,
+                event,
+                source_lang,
+                text,
+                target_lang,
+                translated_text,
+                false
+            );
+
+            free(data);
+
+            return;
+        }
+    }
+
     CURLV_REQ request = { .callback = on_response_from_papago };
 
     request.easy = curl_easy_init();
@@ -223,9 +346,7 @@ void sr_command_papago_run(
     struct sr_command_context *context = malloc(sizeof(*context));
 
     context->event = discord_claim(client, event);
-    context->data = malloc((strlen(text) + 1) * sizeof(*text));
-
-    strcpy(context->data, text);
+    context->data = data;
 
     request.user_data = context;
 
@@ -292,57 +413,72 @@ void sr_command_papago_handle_error(
     free(context);
 }
 
-/* 컴포넌트와의 상호 작용 시에 호출되는 함수. */
-static void on_component_interaction(
+/* `/ppg` 명령어 캐시의 통계 정보를 반환한다. */
+void sr_command_papago_get_cache_stats(struct sr_cache_stats *stats) {
+    sr_cache_get_stats(translation_cache, stats);
+}
+
+/* `/ppg` 명령어 캐시 덕분에 요청하지 않은 글자 수를 반환한다. */
+uint64_t sr_command_papago_get_saved_characters(void) {
+    return saved_characters;
+}
+
+/* `/ppg` 명령어의 번역 결과를 전송한다. */
+static void sr_command_papago_send_results(
     struct discord *client,
-    const struct discord_interaction *event
+    const struct discord_interaction *event,
+    const char *source_lang,
+    const char *source_text,
+    const char *target_lang,
+    const char *target_text,
+    bool deferred
 ) {
-    struct discord_embed *embeds = event->message->embeds->array;
-    struct discord_embed_field *fields = embeds->fields->array;
-
-    const char *query = fields[1].value;
+    char source_field_name[MAX_STRING_SIZE] = "";
+    char target_field_name[MAX_STRING_SIZE] = "";
 
-    sr_command_krdict_create_request(
-        client, 
-        event, 
-        on_response_from_krdict, 
-        query, 
-        "word", 
-        "true"
+    snprintf(
+        source_field_name, 
+        sizeof(source_field_name), 
+        "Source (%s)", 
+        (source_lang != NULL) ? source_lang : "?"
     );
 
-    discord_create_interaction_response(
-        client, 
-        event->id, 
-        event->token, 
-        &(struct discord_interaction_response) {
-            .type = DISCORD_INTERACTION_DEFERRED_CHANNEL_MESSAGE_WITH_SOURCE
-        },
-        NULL
+    snprintf(
+        target_field_name, 
+        sizeof(target_field_name), 
+        "Target (%s)", 
+        (target_lang != NULL) ? target_lang : "?"
     );
-}
 
-/* 국립국어원 한국어기초사전 API로부터 응답을 받았을 때 호출되는 함수. */
-static void on_response_from_krdict(CURLV_STR res, void *user_data) {
-    struct sr_command_context *context = (struct sr_command_context *) user_data;
+    char source_field_value[DISCORD_EMBED_FIELD_VALUE_LEN] = "";
+    char target_field_value[DISCORD_EMBED_FIELD_VALUE_LEN] = "";
 
-    log_info("[SAEROM] Received %ld bytes from \"%s\"", res.len, REQUEST_URL_KRDICT);
+    struct sr_strbuf sb;
 
-    char buffer[DISCORD_EMBED_DESCRIPTION_LEN] = "";
+    // 필드의 길이 제한을 넘는 번역 결과는 줄 단위로 잘라낸다.
+    sr_strbuf_init(&sb, source_field_value, sizeof(source_field_value));
+    sr_strbuf_printf(&sb, "%s", (source_text != NULL) ? source_text : "");
 
-    int total = sr_command_krdict_parse_data(
-        res, 
-        buffer, 
-        sizeof(buffer), 
-        context->flags
-    );
+    sr_strbuf_init(&sb, target_field_value, sizeof(target_field_value));
+    sr_strbuf_printf(&sb, "%s", (target_text != NULL) ? target_text : "");
+
+    struct discord_embed_field fields[2] = {
+        [0] = { 
+            .name = source_field_name,
+            .value = source_field_value 
+        },
+        [1] = {
+            .name = target_field_name,
+            .value = target_field_value
+        }
+    };
 
     struct discord_component buttons[] = {
         {
             .type = DISCORD_COMPONENT_BUTTON,
             .style = DISCORD_BUTTON_SECONDARY,
-            .label = "🔖 Bookmark",
-            .custom_id = "krd_btn_uwu"
+            .label = "🗒️ Dictionary",
+            .custom_id = "ppg_btn_uwu"
         }
     };
 
@@ -356,46 +492,141 @@ static void on_response_from_krdict(CURLV_STR res, void *user_data) {
         },
     };
 
-    struct discord *client = sr_get_client();
-
     struct discord_embed embeds[] = {
         {
-            .title = "Results",
-            .description = "No results found.",
+            .title = "Translation",
             .timestamp = discord_timestamp(client),
             .footer = &(struct discord_embed_footer) {
-                .text = "🗒️"
+                .text = "🌏"
+            },
+            .fields = &(struct discord_embed_fields) {
+                .size = sizeof(fields) / sizeof(*fields),
+                .array = fields
             }
         }
     };
 
-    if (total < 0) {
-        sr_command_krdict_handle_error(context, buffer);
+    if (deferred) {
+        discord_edit_original_interaction_response(
+            client,
+            sr_config_get_application_id(),
+            event->token,
+            &(struct discord_edit_original_interaction_response) {
+                .components = &(struct discord_components){
+                    .size = sizeof(action_rows) / sizeof(*action_rows),
+                    .array = action_rows
+                },
+                .embeds = &(struct discord_embeds) {
+                    .size = sizeof(embeds) / sizeof(*embeds),
+                    .array = embeds
+                }
+            },
+            NULL
+        );
+    } else {
+        struct discord_interaction_response params = {
+            .type = DISCORD_INTERACTION_CHANNEL_MESSAGE_WITH_SOURCE,
+            .data = &(struct discord_interaction_callback_data) { 
+                .components = &(struct discord_components){
+                    .size = sizeof(action_rows) / sizeof(*action_rows),
+                    .array = action_rows
+                },
+                .embeds = &(struct discord_embeds) {
+                    .size = sizeof(embeds) / sizeof(*embeds),
+                    .array = embeds
+                }
+            }
+        };
+
+        discord_create_interaction_response(
+            client, 
+            event->id, 
+            event->token, 
+            &params, 
+            NULL
+        );
+    }
+}
 
+/* 컴포넌트와의 상호 작용 시에 호출되는 함수. */
+static void on_component_interaction(
+    struct discord *client,
+    const struct discord_interaction *event
+) {
+    struct discord_embed *embeds = event->message->embeds->array;
+    struct discord_embed_field *fields = embeds->fields->array;
+
+    const char *query = fields[1].value;
+
+    sr_command_krdict_search(client, event, query, "word", "true");
+}
+
+/* `/ppg` 명령어의 캐시 키를 만든다. */
+static void sr_command_papago_get_cache_key(
+    const char *source,
+    const char *target,
+    const char *text,
+    char *buffer,
+    size_t size
+) {
+    char normalized[MAX_STRING_SIZE + 1] = "";
+
+    normalize_text(text, normalized, sizeof(normalized));
+
+    snprintf(buffer, size, "%s:%s:%s", source, target, normalized);
+}
+
+/* `/ppg` 명령어의 캐시에서 번역 결과를 읽는다. */
+static bool sr_command_papago_read_cache(
+    const char *key,
+    char *buffer,
+    size_t size,
+    const char **source_lang,
+    const char **target_lang,
+    const char **translated_text
+) {
+    size_t len = sr_cache_get(translation_cache, key, buffer, size);
+
+    if (len == 0 || buffer[len - 1] != '\0') return false;
+
+    // `[원본 언어]\0[목적 언어]\0[번역 결과]\0`
+    *source_lang = buffer;
+    *target_lang = *source_lang + strlen(*source_lang) + 1;
+
+    if (*target_lang >= buffer + len) return false;
+
+    *translated_text = *target_lang + strlen(*target_lang) + 1;
+
+    return (*translated_text < buffer + len);
+}
+
+/* `/ppg` 명령어의 캐시에 번역 결과를 저장한다. */
+static void sr_command_papago_write_cache(
+    const char *key,
+    const char *source_lang,
+    const char *target_lang,
+    const char *translated_text
+) {
+    if (source_lang == NULL || target_lang == NULL || translated_text == NULL)
         return;
-    } else if (total == 0) embeds[0].description = "No results found.";
-    else embeds[0].description = buffer;
 
-    discord_edit_original_interaction_response(
-        client,
-        sr_config_get_application_id(),
-        context->event->token,
-        &(struct discord_edit_original_interaction_response) {
-            .components = &(struct discord_components){
-                .size = (total > 0) ? sizeof(action_rows) / sizeof(*action_rows) : 0,
-                .array = action_rows
-            },
-            .embeds = &(struct discord_embeds) {
-                .size = sizeof(embeds) / sizeof(*embeds),
-                .array = embeds
-            }
-        },
-        NULL
+    char buffer[CACHE_VALUE_SIZE];
+
+    int len = snprintf(
+        buffer, 
+        sizeof(buffer), 
+        "%s%c%s%c%s", 
+        source_lang, 
+        '\0',
+        target_lang, 
+        '\0',
+        translated_text
     );
 
-    discord_unclaim(client, context->event);
+    // 번역 결과가 너무 길면, 저장하지 않는다.
+    if (len < 0 || (size_t) len >= sizeof(buffer)) return;
 
-    free(context);
+    sr_cache_put(translation_cache, key, buffer, len + 1);
 }
 
 /* NAVER™ Papago NMT API로부터 응답을 받았을 때 호출되는 함수. */
@@ -404,102 +635,82 @@ static void on_response_from_papago(CURLV_STR res, void *user_data) {
 
     log_info("[SAEROM] Received %ld bytes from \"%s\"", res.len, REQUEST_URL_PAPAGO);
 
-    JsonNode *root = json_decode(res.str);
+    // 응답 데이터는 이 함수가 반환된 직후에 해제되므로, 복사해두어야 한다.
+    struct papago_job *job = calloc(1, sizeof(*job));
 
-    JsonNode *node = json_find_member(root, "errorCode");
+    job->context = (struct sr_command_context *) user_data;
+    job->res.len = res.len;
+    job->res.str = malloc(res.len + 1);
 
-    struct sr_command_context *context = (struct sr_command_context *) user_data;
-    
-    if (node != NULL) {
-        sr_command_papago_handle_error(context, node->string_);
+    memcpy(job->res.str, res.str, res.len + 1);
+
+    sr_worker_push(on_papago_job_work, on_papago_job_done, job);
+}
+
+/* 작업 스레드에서 번역 결과를 가공할 때 호출되는 함수. */
+static void on_papago_job_work(void *data) {
+    struct papago_job *job = data;
 
-        json_delete(root);
+    job->root = json_decode(job->res.str);
+
+    JsonNode *node = json_find_member(job->root, "errorCode");
+
+    if (node != NULL) {
+        job->error_code = node->string_;
 
         return;
     }
 
-    node = json_find_member(root, "message");
+    node = json_find_member(job->root, "message");
     node = json_find_member(node, "result");
 
-    struct discord_embed_field fields[2] = {
-        [0] = { .value = context->data }
-    };
-
-    char source_field_name[MAX_STRING_SIZE] = "";
-    char target_field_name[MAX_STRING_SIZE] = "";
-
     JsonNode *i = NULL;
 
     json_foreach(i, node) {
-        if (streq(i->key, "srcLangType")) {
-            snprintf(source_field_name, MAX_STRING_SIZE, "Source (%s)", i->string_);
+        if (streq(i->key, "srcLangType")) job->source_lang = i->string_;
+        else if (streq(i->key, "tarLangType")) job->target_lang = i->string_;
+        else if (streq(i->key, "translatedText")) job->translated_text = i->string_;
+    }
 
-            fields[0].name = source_field_name;
-        } else if (streq(i->key, "tarLangType")) {
-            snprintf(target_field_name, MAX_STRING_SIZE, "Target (%s)", i->string_);
+    struct papago_request *request = job->context->data;
 
-            fields[1].name = target_field_name;
-        } else if (streq(i->key, "translatedText")) {
-            fields[1].value = i->string_;
-        }
-    }
+    sr_command_papago_write_cache(
+        request->key,
+        job->source_lang,
+        job->target_lang,
+        job->translated_text
+    );
+}
 
-     struct discord_component buttons[] = {
-        {
-            .type = DISCORD_COMPONENT_BUTTON,
-            .style = DISCORD_BUTTON_SECONDARY,
-            .label = "🗒️ Dictionary",
-            .custom_id = "ppg_btn_uwu"
-        }
-    };
+/* 번역 결과의 가공이 끝났을 때 호출되는 함수. */
+static void on_papago_job_done(void *data) {
+    struct papago_job *job = data;
 
-    struct discord_component action_rows[] = {
-        {
-            .type = DISCORD_COMPONENT_ACTION_ROW,
-            .components = &(struct discord_components){
-                .size = sizeof(buttons) / sizeof(*buttons),
-                .array = buttons
-            }
-        },
-    };
+    struct sr_command_context *context = job->context;
 
     struct discord *client = sr_get_client();
 
-    struct discord_embed embeds[] = {
-        {
-            .title = "Translation",
-            .timestamp = discord_timestamp(client),
-            .footer = &(struct discord_embed_footer) {
-                .text = "🌏"
-            },
-            .fields = &(struct discord_embed_fields) {
-                .size = sizeof(fields) / sizeof(*fields),
-                .array = fields
-            }
-        }
-    };
+    if (job->error_code != NULL) {
+        sr_command_papago_handle_error(context, job->error_code);
+    } else {
+        sr_command_papago_send_results(
+            client,
+            context->event,
+            job->source_lang,
+            ((struct papago_request *) context->data)->text,
+            job->target_lang,
+            job->translated_text,
+            true
+        );
 
-    discord_edit_original_interaction_response(
-        client,
-        sr_config_get_application_id(),
-        context->event->token,
-        &(struct discord_edit_original_interaction_response) {
-            .components = &(struct discord_components){
-                .size = sizeof(action_rows) / sizeof(*action_rows),
-                .array = action_rows
-            },
-            .embeds = &(struct discord_embeds) {
-                .size = sizeof(embeds) / sizeof(*embeds),
-                .array = embeds
-            }
-        },
-        NULL
-    );
+        discord_unclaim(client, context->event);
 
-    discord_unclaim(client, context->event);
+        free(context->data);
+        free(context);
+    }
 
-    free(context->data);
-    free(context);
+    json_delete(job->root);
 
-    json_delete(root);
+    free(job->res.str);
+    free(job);
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdarg.h>
+
+#include <saerom.h>
+
+/* | `strbuf` 모듈 함수... | */
+
+/* 문자열 버퍼에 추가하다가 잘린 부분을 줄이나 UTF-8 문자 단위로 다시 자른다. */
+static void sr_strbuf_cut(struct sr_strbuf *sb, size_t begin, size_t end);
+
+/* 문자열 버퍼를 초기화한다. */
+void sr_strbuf_init(struct sr_strbuf *sb, char *buffer, size_t size) {
+    if (sb == NULL) return;
+
+    sb->str = buffer;
+    sb->size = (buffer != NULL) ? size : 0;
+    sb->len = 0;
+    sb->truncated = (sb->size == 0);
+
+    if (sb->size > 0) *buffer = '\0';
+}
+
+/*
+    문자열 버퍼에 주어진 문자열의 `len` 바이트를 추가한다.
+    공간이 부족하여 문자열의 일부만 추가했다면, `false`를 반환한다.
+*/
+bool sr_strbuf_append(struct sr_strbuf *sb, const char *str, size_t len) {
+    if (sb == NULL || sb->truncated) return false;
+
+    const size_t begin = sb->len;
+
+    if (len < sb->size - begin) {
+        memcpy(sb->str + begin, str, len);
+
+        sb->len += len;
+        sb->str[sb->len] = '\0';
+
+        return true;
+    }
+
+    memcpy(sb->str + begin, str, sb->size - begin - 1);
+
+    sr_strbuf_cut(sb, begin, sb->size - 1);
+
+    return false;
+}
+
+/*
+    문자열 버퍼에 주어진 형식의 문자열을 추가한다.
+    공간이 부족하여 문자열의 일부만 추가했다면, `false`를 반환한다.
+*/
+bool sr_strbuf_printf(struct sr_strbuf *sb, const char *format, ...) {
+    if (sb == NULL || sb->truncated) return false;
+
+    const size_t begin = sb->len;
+
+    va_list args;
+
+    va_start(args, format);
+
+    const int len = vsnprintf(sb->str + begin, sb->size - begin, format, args);
+
+    va_end(args);
+
+    if (len < 0) {
+        sb->str[begin] = '\0';
+
+        return false;
+    }
+
+    if ((size_t) len < sb->size - begin) {
+        sb->len += len;
+
+        return true;
+    }
+
+    sr_strbuf_cut(sb, begin, sb->size - 1);
+
+    return false;
+}
+
+/* 문자열 버퍼의 내용을 앞에서부터 `len` 바이트만 남기고 버린다. */
+void sr_strbuf_rewind(struct sr_strbuf *sb, size_t len) {
+    if (sb == NULL || len >= sb->len) return;
+
+    sb->len = len;
+    sb->str[len] = '\0';
+}
+
+/* 문자열 버퍼에 추가하다가 잘린 부분을 줄이나 UTF-8 문자 단위로 다시 자른다. */
+static void sr_strbuf_cut(struct sr_strbuf *sb, size_t begin, size_t end) {
+    size_t len = end;
+
+    // 새로 추가한 부분에 줄바꿈 문자가 있다면, 마지막 줄바꿈 문자 뒤를 자른다.
+    while (len > begin && sb->str[len - 1] != '\n') len--;
+
+    if (len == begin) {
+        len = end;
+
+        while (len > begin && (sb->str[len - 1] & 0xC0) == 0x80) len--;
+
+        // 마지막 UTF-8 문자가 완전하지 않다면, 그 문자를 버린다.
+        if (len > begin) {
+            const unsigned char lead = sb->str[len - 1];
+
+            const size_t width = (lead >= 0xF0) ? 4
+                : (lead >= 0xE0) ? 3
+                : (lead >= 0xC0) ? 2
+                : 1;
+
+            if (len - 1 + width <= end) len = end;
+            else len--;
+        }
+    }
+
+    sb->len = len;
+    sb->str[len] = '\0';
+
+    sb->truncated = true;
+}
\ No newline at end of file
@@ -0,0 +1,1083 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+
+#include <saerom.h>
+
+/* | `suggest` 모듈 매크로 정의... | */
+
+#define INITIAL_ENTRY_COUNT   4096
+#define INITIAL_POOL_SIZE     65536
+
+#define MAX_SUGGESTION_COUNT  25
+
+#define MAX_PENDING_COUNT     64
+#define MAX_PENDING_LENGTH    256
+#define MAX_LEARNED_COUNT     65536
+
+/* 새로 추가할 표제어가 다 모이지 않았더라도, 이 간격 (단위: 밀리초)이 지나면 합친다. */
+#define MERGE_INTERVAL        60000
+
+#define MAX_JAMO_COUNT        48
+#define MAX_EDIT_DISTANCE     2
+#define MAX_CANDIDATE_COUNT   64
+#define MAX_CANDIDATE_CHECKS  512
+
+/* | `suggest` 모듈 자료형 정의... | */
+
+/* 자동 완성 색인의 표제어를 나타내는 구조체. */
+struct sr_suggest_entry {
+    uint32_t word;
+    uint32_t hits;
+    uint16_t len;
+    uint8_t level;
+};
+
+/* 자동 완성 색인에서 아직 확인하지 않은 범위를 나타내는 구조체. */
+struct sr_suggest_range {
+    uint32_t first;
+    uint32_t last;
+    int32_t best;
+};
+
+/* 오타 교정 색인에서 표제어의 자모 하나를 지운 문자열을 나타내는 구조체. */
+struct sr_suggest_variant {
+    uint32_t hash;
+    uint32_t word;
+};
+
+/* 오타 교정 후보를 나타내는 구조체. */
+struct sr_suggest_candidate {
+    uint32_t word;
+    int32_t index;
+    int distance;
+};
+
+/* 자동 완성 색인에 아직 합치지 않은 검색어를 나타내는 구조체. */
+struct sr_suggest_pending {
+    char word[MAX_PENDING_LENGTH];
+    uint32_t hits;
+};
+
+/* 정렬 중인 표제어를 나타내는 구조체. */
+struct sr_suggest_item {
+    const char *word;
+    struct sr_suggest_entry entry;
+};
+
+/* 자동 완성 색인을 나타내는 구조체. */
+struct sr_suggest {
+    char *pool;
+    size_t pool_len;
+    size_t pool_size;
+    struct sr_suggest_entry *entries;
+    size_t count;
+    size_t capacity;
+    int32_t *tree;
+    size_t tree_size;
+    struct sr_suggest_variant *variants;
+    size_t variant_count;
+    bool sorted;
+    struct sr_suggest_pending *pending;
+    int pending_count;
+    struct sr_suggest_pending *batch;
+    int batch_count;
+    struct sr_suggest *next;
+    size_t learned_count;
+    uint64_t merged_at;
+    bool merging;
+};
+
+/* | `suggest` 모듈 함수... | */
+
+/* 자동 완성 색인의 문자열 목록에 주어진 문자열을 추가한다. */
+static uint32_t sr_suggest_intern(struct sr_suggest *suggest, const char *word, size_t len);
+
+/* 아직 합치지 않은 검색어 목록에 주어진 검색어를 추가한다. */
+static void sr_suggest_add_pending(struct sr_suggest *suggest, const char *word);
+
+/* 아직 합치지 않은 검색어 중 자동 완성 색인에 있는 검색어의 검색 횟수를 반영한다. */
+static void sr_suggest_apply_pending(struct sr_suggest *suggest);
+
+/* 아직 합치지 않은 두 검색어를 바이트 순서로 비교한다. */
+static int sr_suggest_compare_pending(const void *lhs, const void *rhs);
+
+/* 자동 완성 색인의 표제어 목록 끝에 주어진 표제어를 추가한다. */
+static void sr_suggest_append(
+    struct sr_suggest *suggest,
+    const char *word,
+    int level,
+    uint32_t hits
+);
+
+/* 자동 완성 색인에서 주어진 문자열보다 작지 않은 첫 번째 표제어의 위치를 찾는다. */
+static size_t sr_suggest_lower_bound(const struct sr_suggest *suggest, const char *word);
+
+/* 두 표제어의 우선순위를 비교한다. */
+static int sr_suggest_compare(
+    const struct sr_suggest *suggest,
+    int32_t lhs,
+    int32_t rhs
+);
+
+/* 두 표제어를 바이트 순서로 비교한다. */
+static int sr_suggest_compare_words(const void *lhs, const void *rhs);
+
+/* 표제어 목록을 정렬하고, 같은 표제어를 하나로 합친다. */
+static void sr_suggest_sort(struct sr_suggest *suggest);
+
+/* 우선순위가 가장 높은 표제어를 빠르게 찾기 위한 구간 트리를 만든다. */
+static void sr_suggest_build_tree(struct sr_suggest *suggest);
+
+/* 구간 트리에서 주어진 표제어의 우선순위가 바뀌었음을 반영한다. */
+static void sr_suggest_update_tree(struct sr_suggest *suggest, size_t index);
+
+/* 구간 트리에서 주어진 범위의 우선순위가 가장 높은 표제어를 찾는다. */
+static int32_t sr_suggest_query_tree(
+    const struct sr_suggest *suggest,
+    uint32_t first,
+    uint32_t last
+);
+
+/* 주어진 문자열을 자모 단위로 분해한다. */
+static int sr_suggest_decompose(const char *word, uint32_t *jamo, int size);
+
+/* 자모 목록에서 주어진 위치의 자모 하나를 뺀 문자열의 해시 값을 구한다. */
+static uint32_t sr_suggest_hash(const uint32_t *jamo, int len, int skip);
+
+/* 두 자모 목록의 편집 거리를 구한다. */
+static int sr_suggest_distance(
+    const uint32_t *lhs,
+    int lhs_len,
+    const uint32_t *rhs,
+    int rhs_len
+);
+
+/* 두 오타 교정 색인의 항목을 비교한다. */
+static int sr_suggest_compare_variants(const void *lhs, const void *rhs);
+
+/* 표제어 목록의 오타 교정 색인을 만든다. */
+static void sr_suggest_build_variants(struct sr_suggest *suggest);
+
+/* 자동 완성 색인을 생성한다. */
+struct sr_suggest *sr_suggest_create(void) {
+    struct sr_suggest *result = calloc(1, sizeof(*result));
+
+    result->sorted = true;
+
+    return result;
+}
+
+/* 자동 완성 색인에 할당된 메모리를 해제한다. */
+void sr_suggest_release(struct sr_suggest *suggest) {
+    if (suggest == NULL) return;
+
+    free(suggest->pool);
+    free(suggest->entries);
+    free(suggest->tree);
+    free(suggest->variants);
+    free(suggest->pending);
+    free(suggest->batch);
+
+    sr_suggest_release(suggest->next);
+
+    free(suggest);
+}
+
+/*
+    자동 완성 색인에 주어진 표제어를 추가한다.
+    표제어 목록은 `sr_suggest_build()`를 호출한 뒤에 검색할 수 있다.
+*/
+void sr_suggest_add(struct sr_suggest *suggest, const char *word, int level) {
+    if (suggest == NULL || word == NULL || *word == '\0') return;
+
+    sr_suggest_append(suggest, word, level, 0);
+}
+
+/* 자동 완성 색인의 표제어 목록을 검색할 수 있도록 정리한다. */
+void sr_suggest_build(struct sr_suggest *suggest) {
+    if (suggest == NULL) return;
+
+    sr_suggest_sort(suggest);
+    sr_suggest_build_tree(suggest);
+    sr_suggest_build_variants(suggest);
+}
+
+/* 주어진 표제어의 검색 횟수를 늘린다. */
+void sr_suggest_hit(struct sr_suggest *suggest, const char *word) {
+    if (suggest == NULL || word == NULL || *word == '\0' || !suggest->sorted) return;
+
+    size_t index = sr_suggest_lower_bound(suggest, word);
+
+    const bool found = index < suggest->count
+        && streq(suggest->pool + suggest->entries[index].word, word);
+
+    // 작업 스레드에서 표제어 목록을 합치는 동안에는, 검색 횟수를 나중에 반영한다.
+    if (found && !suggest->merging) {
+        suggest->entries[index].hits++;
+
+        sr_suggest_update_tree(suggest, index);
+
+        return;
+    }
+
+    // 사전 데이터에 없는 표제어는 검색 결과가 있을 때만, 정해진 개수까지만 추가된다.
+    if (!found && suggest->learned_count >= MAX_LEARNED_COUNT) return;
+
+    sr_suggest_add_pending(suggest, word);
+}
+
+/*
+    아직 합치지 않은 검색어들을 합칠 준비를 한다.
+    합칠 검색어가 충분히 모였다면, 작업 스레드에서 `sr_suggest_merge()`를 호출해야 한다.
+*/
+bool sr_suggest_begin_merge(struct sr_suggest *suggest) {
+    if (suggest == NULL || suggest->merging || suggest->pending_count == 0) return false;
+
+    const uint64_t now = cog_timestamp_ms();
+
+    if (suggest->pending_count < MAX_PENDING_COUNT 
+        && now - suggest->merged_at < MERGE_INTERVAL) return false;
+
+    // 합치는 동안 새로 들어온 검색어는 비어 있는 다른 목록에 모은다.
+    struct sr_suggest_pending *batch = suggest->batch;
+
+    suggest->batch = suggest->pending;
+    suggest->batch_count = suggest->pending_count;
+
+    suggest->pending = batch;
+    suggest->pending_count = 0;
+
+    suggest->merged_at = now;
+    suggest->merging = true;
+
+    return true;
+}
+
+/* 
+    작업 스레드에서 표제어 목록과 아직 합치지 않은 검색어들을 합친 새로운 색인을 만든다.
+    합치는 동안에는 메인 스레드에서 기존 표제어 목록을 읽기만 하므로, 잠금이 필요 없다.
+*/
+void sr_suggest_merge(struct sr_suggest *suggest) {
+    if (suggest == NULL || !suggest->merging) return;
+
+    struct sr_suggest *next = sr_suggest_create();
+
+    qsort(
+        suggest->batch, 
+        suggest->batch_count, 
+        sizeof(*suggest->batch), 
+        sr_suggest_compare_pending
+    );
+
+    size_t i = 0;
+
+    int j = 0;
+
+    // 두 목록 모두 정렬되어 있으므로, 순서대로 추가하면 다시 정렬할 필요가 없다.
+    while (i < suggest->count || j < suggest->batch_count) {
+        const struct sr_suggest_entry *entry = (i < suggest->count) 
+            ? &suggest->entries[i] 
+            : NULL;
+
+        const struct sr_suggest_pending *pending = (j < suggest->batch_count)
+            ? &suggest->batch[j]
+            : NULL;
+
+        const int result = (entry == NULL) ? 1 : (pending == NULL) ? -1 
+            : strcmp(suggest->pool + entry->word, pending->word);
+
+        if (result < 0) {
+            sr_suggest_append(next, suggest->pool + entry->word, entry->level, entry->hits);
+
+            i++;
+        } else if (result == 0) {
+            const uint32_t hits = (entry->hits > UINT32_MAX - pending->hits)
+                ? UINT32_MAX
+                : entry->hits + pending->hits;
+
+            sr_suggest_append(next, suggest->pool + entry->word, entry->level, hits);
+
+            i++, j++;
+        } else {
+            sr_suggest_append(next, pending->word, 0, pending->hits);
+
+            next->learned_count++;
+
+            j++;
+        }
+    }
+
+    sr_suggest_build(next);
+
+    suggest->next = next;
+}
+
+/* 작업 스레드에서 만든 새로운 색인으로 바꾸고, 합치는 동안 들어온 검색 횟수를 반영한다. */
+void sr_suggest_end_merge(struct sr_suggest *suggest) {
+    if (suggest == NULL || !suggest->merging) return;
+
+    struct sr_suggest *next = suggest->next;
+
+    if (next != NULL) {
+        struct sr_suggest temp = *next;
+
+        temp.pending = suggest->pending;
+        temp.pending_count = suggest->pending_count;
+        temp.batch = suggest->batch;
+        temp.learned_count = suggest->learned_count + next->learned_count;
+        temp.merged_at = suggest->merged_at;
+
+        // 기존 표제어 목록은 새로운 색인이 있던 자리로 옮긴 뒤에 해제한다.
+        *next = *suggest;
+
+        next->pending = next->batch = NULL;
+        next->next = NULL;
+
+        sr_suggest_release(next);
+
+        *suggest = temp;
+    }
+
+    suggest->next = NULL;
+    suggest->batch_count = 0;
+    suggest->merging = false;
+
+    sr_suggest_apply_pending(suggest);
+}
+
+/*
+    주어진 문자열로 시작하는 표제어들을 우선순위 (검색 횟수, 학습 등급 순)대로 찾는다.
+    이 함수는 메모리를 할당하지 않는다.
+*/
+int sr_suggest_find(
+    const struct sr_suggest *suggest,
+    const char *prefix,
+    const char **words,
+    int count
+) {
+    if (suggest == NULL || prefix == NULL || words == NULL || suggest->count == 0)
+        return 0;
+
+    if (count > MAX_SUGGESTION_COUNT) count = MAX_SUGGESTION_COUNT;
+
+    const size_t prefix_len = strlen(prefix);
+
+    const uint32_t first = sr_suggest_lower_bound(suggest, prefix);
+
+    uint32_t low = first, high = suggest->count;
+
+    // 같은 문자열로 시작하는 표제어들은 연속된 위치에 있다.
+    while (low < high) {
+        uint32_t mid = low + ((high - low) >> 1);
+
+        const char *word = suggest->pool + suggest->entries[mid].word;
+
+        if (strncmp(word, prefix, prefix_len) <= 0) low = mid + 1;
+        else high = mid;
+    }
+
+    const uint32_t last = low;
+
+    if (first >= last) return 0;
+
+    // 우선순위가 가장 높은 표제어를 꺼낸 뒤에, 남은 두 범위를 다시 확인한다.
+    struct sr_suggest_range heap[2 * MAX_SUGGESTION_COUNT + 1];
+
+    int heap_len = 0, len = 0;
+
+    heap[heap_len++] = (struct sr_suggest_range) {
+        .first = first,
+        .last = last,
+        .best = sr_suggest_query_tree(suggest, first, last)
+    };
+
+    while (heap_len > 0 && len < count) {
+        const struct sr_suggest_range range = heap[0];
+
+        heap[0] = heap[--heap_len];
+
+        for (int i = 0;;) {
+            int left = 2 * i + 1, right = left + 1, best = i;
+
+            if (left < heap_len
+                && sr_suggest_compare(suggest, heap[left].best, heap[best].best) < 0)
+                best = left;
+
+            if (right < heap_len
+                && sr_suggest_compare(suggest, heap[right].best, heap[best].best) < 0)
+                best = right;
+
+            if (best == i) break;
+
+            struct sr_suggest_range temp = heap[i];
+
+            heap[i] = heap[best], heap[best] = temp;
+
+            i = best;
+        }
+
+        words[len++] = suggest->pool + suggest->entries[range.best].word;
+
+        const struct sr_suggest_range children[] = {
+            { .first = range.first, .last = range.best },
+            { .first = range.best + 1, .last = range.last }
+        };
+
+        for (int i = 0; i < 2; i++) {
+            if (children[i].first >= children[i].last) continue;
+
+            int j = heap_len++;
+
+            heap[j] = children[i];
+            heap[j].best = sr_suggest_query_tree(suggest, heap[j].first, heap[j].last);
+
+            while (j > 0) {
+                int parent = (j - 1) / 2;
+
+                if (sr_suggest_compare(suggest, heap[j].best, heap[parent].best) >= 0)
+                    break;
+
+                struct sr_suggest_range temp = heap[j];
+
+                heap[j] = heap[parent], heap[parent] = temp;
+
+                j = parent;
+            }
+        }
+    }
+
+    return len;
+}
+
+/*
+    주어진 문자열과 자모 단위의 편집 거리가 가까운 표제어들을 찾는다.
+    이 함수는 메모리를 할당하지 않는다.
+*/
+int sr_suggest_correct(
+    const struct sr_suggest *suggest,
+    const char *word,
+    const char **words,
+    int count
+) {
+    if (suggest == NULL || word == NULL || words == NULL || suggest->variant_count == 0)
+        return 0;
+
+    uint32_t jamo[MAX_JAMO_COUNT], other[MAX_JAMO_COUNT];
+
+    const int len = sr_suggest_decompose(word, jamo, MAX_JAMO_COUNT);
+
+    if (len < 2) return 0;
+
+    // 한 글자짜리 검색어는 자모 하나가 틀린 표제어만 찾는다.
+    const int max_distance = (len > 3) ? MAX_EDIT_DISTANCE : 1;
+
+    struct sr_suggest_candidate candidates[MAX_CANDIDATE_COUNT];
+
+    int candidate_count = 0, checks = 0;
+
+    // 검색어에서 자모를 하나 지운 문자열과 표제어에서 자모를 하나 지운 문자열을 맞춰 본다.
+    for (int skip = -1; skip < len; skip++) {
+        // 같은 자모가 연달아 있다면, 어느 쪽을 지워도 같은 문자열이 된다.
+        if (skip > 0 && jamo[skip] == jamo[skip - 1]) continue;
+
+        const uint32_t hash = sr_suggest_hash(jamo, len, skip);
+
+        size_t low = 0, high = suggest->variant_count;
+
+        while (low < high) {
+            size_t mid = low + ((high - low) >> 1);
+
+            if (suggest->variants[mid].hash < hash) low = mid + 1;
+            else high = mid;
+        }
+
+        for (size_t i = low; i < suggest->variant_count
+            && suggest->variants[i].hash == hash; i++) {
+            const uint32_t offset = suggest->variants[i].word;
+
+            bool found = false;
+
+            for (int j = 0; j < candidate_count && !found; j++)
+                found = (candidates[j].word == offset);
+
+            if (found) continue;
+
+            // 짧은 검색어는 후보가 지나치게 많을 수 있으므로, 확인할 후보의 수를 제한한다.
+            if (++checks > MAX_CANDIDATE_CHECKS) break;
+
+            const char *candidate = suggest->pool + offset;
+
+            const int other_len = sr_suggest_decompose(candidate, other, MAX_JAMO_COUNT);
+
+            if (other_len < 0) continue;
+
+            const int distance = sr_suggest_distance(jamo, len, other, other_len);
+
+            if (distance == 0 || distance > max_distance) continue;
+
+            const size_t index = sr_suggest_lower_bound(suggest, candidate);
+
+            if (index >= suggest->count
+                || suggest->entries[index].word != offset) continue;
+
+            struct sr_suggest_candidate entry = {
+                .word = offset,
+                .index = index,
+                .distance = distance
+            };
+
+            // 편집 거리가 가까울수록, 우선순위가 높을수록 앞선다.
+            int j = (candidate_count < MAX_CANDIDATE_COUNT)
+                ? candidate_count++
+                : MAX_CANDIDATE_COUNT;
+
+            for (; j > 0; j--) {
+                const struct sr_suggest_candidate *prev = &candidates[j - 1];
+
+                if (prev->distance < entry.distance
+                    || (prev->distance == entry.distance
+                    && sr_suggest_compare(suggest, prev->index, entry.index) <= 0))
+                    break;
+
+                if (j < MAX_CANDIDATE_COUNT) candidates[j] = *prev;
+            }
+
+            if (j < MAX_CANDIDATE_COUNT) candidates[j] = entry;
+        }
+
+        if (checks > MAX_CANDIDATE_CHECKS) break;
+    }
+
+    int result = 0;
+
+    for (int i = 0; i < candidate_count && result < count; i++)
+        words[result++] = suggest->pool + candidates[i].word;
+
+    return result;
+}
+
+/* 자동 완성 색인의 검색 기록을 주어진 파일에서 읽는다. */
+bool sr_suggest_load(struct sr_suggest *suggest, const char *path) {
+    if (suggest == NULL || path == NULL || *path == '\0') return false;
+
+    FILE *fp = fopen(path, "r");
+
+    if (fp == NULL) return false;
+
+    char line[MAX_STRING_SIZE];
+
+    size_t count = 0;
+
+    // 각 줄은 `<검색 횟수>\t<표제어>` 형식이다.
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char *word = strchr(line, '\t');
+
+        if (word == NULL) continue;
+
+        *(word++) = '\0';
+
+        word[strcspn(word, "\r\n")] = '\0';
+
+        const unsigned long hits = strtoul(line, NULL, 10);
+
+        if (hits == 0 || *word == '\0') continue;
+
+        sr_suggest_append(suggest, word, 0, (hits < UINT32_MAX) ? hits : UINT32_MAX);
+
+        count++;
+    }
+
+    // 사전 데이터에도 있는 표제어가 섞여 있으므로, 새로 추가된 표제어의 개수를 넉넉하게 센다.
+    suggest->learned_count += count;
+
+    fclose(fp);
+
+    log_info("[SAEROM] Loaded %zu query log entries from \"%s\"", count, path);
+
+    return true;
+}
+
+/* 자동 완성 색인의 검색 기록을 주어진 파일에 기록한다. */
+bool sr_suggest_save(const struct sr_suggest *suggest, const char *path) {
+    if (suggest == NULL || path == NULL || *path == '\0') return false;
+
+    char temp_path[MAX_STRING_SIZE + 4] = "";
+
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE *fp = fopen(temp_path, "w");
+
+    if (fp == NULL) return false;
+
+    bool result = true;
+
+    for (size_t i = 0; i < suggest->count && result; i++) {
+        const struct sr_suggest_entry *entry = &suggest->entries[i];
+
+        if (entry->hits == 0) continue;
+
+        result = fprintf(fp, "%u\t%s\n", entry->hits, suggest->pool + entry->word) > 0;
+    }
+
+    // 아직 합치지 않은 검색어도 기록한다. 같은 표제어는 다시 읽을 때 하나로 합쳐진다.
+    for (int i = 0; i < suggest->pending_count && result; i++)
+        result = fprintf(
+            fp, 
+            "%u\t%s\n", 
+            suggest->pending[i].hits, 
+            suggest->pending[i].word
+        ) > 0;
+
+    result = (fclose(fp) == 0) && result;
+
+    if (result) result = (rename(temp_path, path) == 0);
+    else remove(temp_path);
+
+    return result;
+}
+
+/* 자동 완성 색인의 문자열 목록에 주어진 문자열을 추가한다. */
+static uint32_t sr_suggest_intern(struct sr_suggest *suggest, const char *word, size_t len) {
+    if (suggest->pool_len + len + 1 > suggest->pool_size) {
+        size_t new_size = (suggest->pool_size > 0)
+            ? suggest->pool_size << 1
+            : INITIAL_POOL_SIZE;
+
+        while (suggest->pool_len + len + 1 > new_size) new_size <<= 1;
+
+        suggest->pool = realloc(suggest->pool, new_size);
+        suggest->pool_size = new_size;
+    }
+
+    const uint32_t result = suggest->pool_len;
+
+    memcpy(suggest->pool + result, word, len);
+
+    suggest->pool[result + len] = '\0';
+    suggest->pool_len += len + 1;
+
+    return result;
+}
+
+/* 아직 합치지 않은 검색어 목록에 주어진 검색어를 추가한다. */
+static void sr_suggest_add_pending(struct sr_suggest *suggest, const char *word) {
+    if (strlen(word) >= MAX_PENDING_LENGTH) return;
+
+    for (int i = 0; i < suggest->pending_count; i++) {
+        if (streq(suggest->pending[i].word, word)) {
+            if (suggest->pending[i].hits < UINT32_MAX) suggest->pending[i].hits++;
+
+            return;
+        }
+    }
+
+    // 합치기 전에 목록이 가득 찼다면, 새로운 검색어는 기록하지 않는다.
+    if (suggest->pending_count >= MAX_PENDING_COUNT) return;
+
+    if (suggest->pending == NULL)
+        suggest->pending = malloc(MAX_PENDING_COUNT * sizeof(*suggest->pending));
+
+    struct sr_suggest_pending *pending = &suggest->pending[suggest->pending_count++];
+
+    strcpy(pending->word, word);
+
+    pending->hits = 1;
+}
+
+/* 아직 합치지 않은 검색어 중 자동 완성 색인에 있는 검색어의 검색 횟수를 반영한다. */
+static void sr_suggest_apply_pending(struct sr_suggest *suggest) {
+    int len = 0;
+
+    for (int i = 0; i < suggest->pending_count; i++) {
+        const struct sr_suggest_pending *pending = &suggest->pending[i];
+
+        const size_t index = sr_suggest_lower_bound(suggest, pending->word);
+
+        if (index < suggest->count
+            && streq(suggest->pool + suggest->entries[index].word, pending->word)) {
+            struct sr_suggest_entry *entry = &suggest->entries[index];
+
+            entry->hits = (entry->hits > UINT32_MAX - pending->hits)
+                ? UINT32_MAX
+                : entry->hits + pending->hits;
+
+            sr_suggest_update_tree(suggest, index);
+
+            continue;
+        }
+
+        suggest->pending[len++] = *pending;
+    }
+
+    suggest->pending_count = len;
+}
+
+/* 아직 합치지 않은 두 검색어를 바이트 순서로 비교한다. */
+static int sr_suggest_compare_pending(const void *lhs, const void *rhs) {
+    const struct sr_suggest_pending *a = lhs, *b = rhs;
+
+    return strcmp(a->word, b->word);
+}
+
+/* 자동 완성 색인의 표제어 목록 끝에 주어진 표제어를 추가한다. */
+static void sr_suggest_append(
+    struct sr_suggest *suggest,
+    const char *word,
+    int level,
+    uint32_t hits
+) {
+    size_t len = strlen(word);
+
+    if (len > UINT16_MAX) return;
+
+    if (suggest->count >= suggest->capacity) {
+        suggest->capacity = (suggest->capacity > 0)
+            ? suggest->capacity << 1
+            : INITIAL_ENTRY_COUNT;
+
+        suggest->entries = realloc(
+            suggest->entries,
+            suggest->capacity * sizeof(*suggest->entries)
+        );
+    }
+
+    // 정렬된 순서로 추가되는 동안에는 다시 정렬하지 않는다.
+    if (suggest->count > 0 && strcmp(
+        suggest->pool + suggest->entries[suggest->count - 1].word,
+        word
+    ) >= 0) suggest->sorted = false;
+
+    suggest->entries[suggest->count++] = (struct sr_suggest_entry) {
+        .word = sr_suggest_intern(suggest, word, len),
+        .hits = hits,
+        .len = len,
+        .level = (level > 0) ? level : 0
+    };
+}
+
+/* 자동 완성 색인에서 주어진 문자열보다 작지 않은 첫 번째 표제어의 위치를 찾는다. */
+static size_t sr_suggest_lower_bound(const struct sr_suggest *suggest, const char *word) {
+    size_t low = 0, high = suggest->count;
+
+    while (low < high) {
+        size_t mid = low + ((high - low) >> 1);
+
+        if (strcmp(suggest->pool + suggest->entries[mid].word, word) < 0) low = mid + 1;
+        else high = mid;
+    }
+
+    return low;
+}
+
+/* 두 표제어의 우선순위를 비교한다. */
+static int sr_suggest_compare(
+    const struct sr_suggest *suggest,
+    int32_t lhs,
+    int32_t rhs
+) {
+    if (lhs < 0 || rhs < 0) return (lhs < 0) - (rhs < 0);
+
+    const struct sr_suggest_entry *a = &suggest->entries[lhs];
+    const struct sr_suggest_entry *b = &suggest->entries[rhs];
+
+    // 검색 횟수가 많을수록, 기초 어휘일수록, 짧을수록 앞선다.
+    if (a->hits != b->hits) return (a->hits > b->hits) ? -1 : 1;
+    if (a->level != b->level) return (a->level > b->level) ? -1 : 1;
+    if (a->len != b->len) return (a->len < b->len) ? -1 : 1;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/* 두 표제어를 바이트 순서로 비교한다. */
+static int sr_suggest_compare_words(const void *lhs, const void *rhs) {
+    const struct sr_suggest_item *a = lhs, *b = rhs;
+
+    int result = strcmp(a->word, b->word);
+
+    // 같은 표제어는 추가된 순서를 유지한다.
+    if (result == 0) result = (a->entry.word > b->entry.word) - (a->entry.word < b->entry.word);
+
+    return result;
+}
+
+/* 표제어 목록을 정렬하고, 같은 표제어를 하나로 합친다. */
+static void sr_suggest_sort(struct sr_suggest *suggest) {
+    if (suggest->sorted) return;
+
+    struct sr_suggest_item *items = malloc(suggest->count * sizeof(*items));
+
+    for (size_t i = 0; i < suggest->count; i++) {
+        items[i] = (struct sr_suggest_item) {
+            .word = suggest->pool + suggest->entries[i].word,
+            .entry = suggest->entries[i]
+        };
+    }
+
+    qsort(items, suggest->count, sizeof(*items), sr_suggest_compare_words);
+
+    size_t len = 0;
+
+    for (size_t i = 0; i < suggest->count; i++) {
+        const struct sr_suggest_entry *entry = &items[i].entry;
+
+        if (len > 0 && streq(
+            suggest->pool + suggest->entries[len - 1].word,
+            suggest->pool + entry->word
+        )) {
+            struct sr_suggest_entry *last = &suggest->entries[len - 1];
+
+            last->hits = (last->hits > UINT32_MAX - entry->hits)
+                ? UINT32_MAX
+                : last->hits + entry->hits;
+
+            if (last->level < entry->level) last->level = entry->level;
+
+            continue;
+        }
+
+        suggest->entries[len++] = *entry;
+    }
+
+    free(items);
+
+    suggest->count = len;
+    suggest->sorted = true;
+}
+
+/* 우선순위가 가장 높은 표제어를 빠르게 찾기 위한 구간 트리를 만든다. */
+static void sr_suggest_build_tree(struct sr_suggest *suggest) {
+    size_t size = 1;
+
+    while (size < suggest->count) size <<= 1;
+
+    if (size != suggest->tree_size) {
+        suggest->tree = realloc(suggest->tree, 2 * size * sizeof(*suggest->tree));
+        suggest->tree_size = size;
+    }
+
+    for (size_t i = 0; i < size; i++)
+        suggest->tree[size + i] = (i < suggest->count) ? (int32_t) i : -1;
+
+    for (size_t i = size - 1; i > 0; i--) {
+        const int32_t lhs = suggest->tree[2 * i], rhs = suggest->tree[2 * i + 1];
+
+        suggest->tree[i] = (sr_suggest_compare(suggest, lhs, rhs) <= 0) ? lhs : rhs;
+    }
+}
+
+/* 구간 트리에서 주어진 표제어의 우선순위가 바뀌었음을 반영한다. */
+static void sr_suggest_update_tree(struct sr_suggest *suggest, size_t index) {
+    for (size_t i = (suggest->tree_size + index) >> 1; i > 0; i >>= 1) {
+        const int32_t lhs = suggest->tree[2 * i], rhs = suggest->tree[2 * i + 1];
+
+        suggest->tree[i] = (sr_suggest_compare(suggest, lhs, rhs) <= 0) ? lhs : rhs;
+    }
+}
+
+/* 구간 트리에서 주어진 범위의 우선순위가 가장 높은 표제어를 찾는다. */
+static int32_t sr_suggest_query_tree(
+    const struct sr_suggest *suggest,
+    uint32_t first,
+    uint32_t last
+) {
+    int32_t result = -1;
+
+    for (size_t l = suggest->tree_size + first, r = suggest->tree_size + last;
+        l < r; l >>= 1, r >>= 1) {
+        if (l & 1) {
+            if (sr_suggest_compare(suggest, suggest->tree[l], result) < 0)
+                result = suggest->tree[l];
+
+            l++;
+        }
+
+        if (r & 1) {
+            r--;
+
+            if (sr_suggest_compare(suggest, suggest->tree[r], result) < 0)
+                result = suggest->tree[r];
+        }
+    }
+
+    return result;
+}
+
+/* 주어진 문자열을 자모 단위로 분해한다. */
+static int sr_suggest_decompose(const char *word, uint32_t *jamo, int size) {
+    int len = 0;
+
+    for (const unsigned char *c = (const unsigned char *) word; *c != '\0';) {
+        uint32_t codepoint = *c;
+
+        int width = 1;
+
+        if (*c >= 0xF0) codepoint = *c & 0x07, width = 4;
+        else if (*c >= 0xE0) codepoint = *c & 0x0F, width = 3;
+        else if (*c >= 0xC0) codepoint = *c & 0x1F, width = 2;
+
+        for (int i = 1; i < width; i++) {
+            if ((c[i] & 0xC0) != 0x80) return -1;
+
+            codepoint = (codepoint << 6) | (c[i] & 0x3F);
+        }
+
+        c += width;
+
+        // 한글 음절은 초성, 중성, (종성)으로 나눈다.
+        if (codepoint >= 0xAC00 && codepoint <= 0xD7A3) {
+            const uint32_t index = codepoint - 0xAC00;
+
+            if (len + 3 > size) return -1;
+
+            jamo[len++] = 0x1100 + index / 588;
+            jamo[len++] = 0x1161 + (index % 588) / 28;
+
+            if (index % 28 > 0) jamo[len++] = 0x11A7 + index % 28;
+        } else {
+            if (len + 1 > size) return -1;
+
+            jamo[len++] = codepoint;
+        }
+    }
+
+    return len;
+}
+
+/* 자모 목록에서 주어진 위치의 자모 하나를 뺀 문자열의 해시 값을 구한다. */
+static uint32_t sr_suggest_hash(const uint32_t *jamo, int len, int skip) {
+    // FNV-1a 해시 함수를 사용한다.
+    uint32_t result = 2166136261u;
+
+    for (int i = 0; i < len; i++) {
+        if (i == skip) continue;
+
+        uint32_t value = jamo[i];
+
+        // 소리가 비슷하여 자주 틀리는 모음 (ㅐ와 ㅔ, ㅒ와 ㅖ, ㅙ와 ㅚ와 ㅞ)은 같은 모음으로 본다.
+        if (value == 0x1166) value = 0x1162;
+        else if (value == 0x1168) value = 0x1164;
+        else if (value == 0x116B || value == 0x1170) value = 0x116C;
+
+        result = (result ^ value) * 16777619u;
+    }
+
+    return result;
+}
+
+/* 두 자모 목록의 편집 거리를 구한다. */
+static int sr_suggest_distance(
+    const uint32_t *lhs,
+    int lhs_len,
+    const uint32_t *rhs,
+    int rhs_len
+) {
+    if (abs(lhs_len - rhs_len) > MAX_EDIT_DISTANCE) return MAX_EDIT_DISTANCE + 1;
+
+    // 이웃한 두 자모의 순서가 바뀐 것도 한 번의 편집으로 센다.
+    int rows[3][MAX_JAMO_COUNT + 1];
+
+    int *prev_prev = rows[0], *prev = rows[1], *current = rows[2];
+
+    for (int j = 0; j <= rhs_len; j++) prev[j] = j;
+
+    for (int i = 1; i <= lhs_len; i++) {
+        current[0] = i;
+
+        int row_min = current[0];
+
+        for (int j = 1; j <= rhs_len; j++) {
+            const int cost = (lhs[i - 1] != rhs[j - 1]);
+
+            int value = prev[j - 1] + cost;
+
+            if (value > prev[j] + 1) value = prev[j] + 1;
+            if (value > current[j - 1] + 1) value = current[j - 1] + 1;
+
+            if (i > 1 && j > 1 && lhs[i - 1] == rhs[j - 2] && lhs[i - 2] == rhs[j - 1]
+                && value > prev_prev[j - 2] + 1) value = prev_prev[j - 2] + 1;
+
+            current[j] = value;
+
+            if (row_min > value) row_min = value;
+        }
+
+        if (row_min > MAX_EDIT_DISTANCE) return MAX_EDIT_DISTANCE + 1;
+
+        int *temp = prev_prev;
+
+        prev_prev = prev, prev = current, current = temp;
+    }
+
+    return prev[rhs_len];
+}
+
+/* 두 오타 교정 색인의 항목을 비교한다. */
+static int sr_suggest_compare_variants(const void *lhs, const void *rhs) {
+    const struct sr_suggest_variant *a = lhs, *b = rhs;
+
+    if (a->hash != b->hash) return (a->hash > b->hash) - (a->hash < b->hash);
+
+    return (a->word > b->word) - (a->word < b->word);
+}
+
+/* 표제어 목록의 오타 교정 색인을 만든다. */
+static void sr_suggest_build_variants(struct sr_suggest *suggest) {
+    size_t capacity = 0, len = 0;
+
+    uint32_t jamo[MAX_JAMO_COUNT];
+
+    // 각 표제어와 표제어에서 자모를 하나 지운 문자열들을 색인에 추가한다.
+    for (size_t i = 0; i < suggest->count; i++) {
+        const uint32_t offset = suggest->entries[i].word;
+
+        const int jamo_len = sr_suggest_decompose(suggest->pool + offset, jamo, MAX_JAMO_COUNT);
+
+        if (jamo_len < 1) continue;
+
+        if (len + jamo_len + 1 > capacity) {
+            capacity = (capacity > 0) ? capacity << 1 : INITIAL_ENTRY_COUNT;
+
+            while (len + jamo_len + 1 > capacity) capacity <<= 1;
+
+            suggest->variants = realloc(
+                suggest->variants, 
+                capacity * sizeof(*suggest->variants)
+            );
+        }
+
+        for (int skip = -1; skip < jamo_len; skip++) {
+            if (skip > 0 && jamo[skip] == jamo[skip - 1]) continue;
+
+            suggest->variants[len++] = (struct sr_suggest_variant) {
+                .hash = sr_suggest_hash(jamo, jamo_len, skip),
+                .word = offset
+            };
+        }
+    }
+
+    qsort(suggest->variants, len, sizeof(*suggest->variants), sr_suggest_compare_variants);
+
+    suggest->variant_count = len;
+
+    log_info(
+        "[SAEROM] Built a typo correction index of %zu entries for %zu headwords",
+        len,
+        suggest->count
+    );
+}
\ No newline at end of file
@@ -93,6 +93,37 @@ bool streq(const char *s1, const char *s2) {
     return strncmp(s1, s2, MAX_STRING_SIZE) == 0;
 }
 
+/* 주어진 문자열의 앞뒤 공백을 제거하고, 연속된 공백을 하나로 합친다. */
+size_t normalize_text(const char *str, char *buffer, size_t size) {
+    if (buffer == NULL || size == 0) return 0;
+
+    size_t len = 0;
+
+    bool pending_space = false;
+
+    for (const char *c = str; *c != '\0' && len + 1 < size; c++) {
+        if (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n') {
+            pending_space = (len > 0);
+
+            continue;
+        }
+
+        if (pending_space) {
+            if (len + 2 >= size) break;
+
+            buffer[len++] = ' ';
+
+            pending_space = false;
+        }
+
+        buffer[len++] = *c;
+    }
+
+    buffer[len] = '\0';
+
+    return len;
+}
+
 /* UTF-8로 인코딩된 문자열의 길이를 반환한다. */
 size_t utf8len(const char *str) {
     size_t result = 0;
@@ -0,0 +1,262 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+
+#include <saerom.h>
+
+/* | `worker` 모듈 매크로 정의... | */
+
+#define MAX_WORKER_COUNT  16
+
+/* | `worker` 모듈 자료형 정의... | */
+
+/* 작업 스레드 풀의 작업을 나타내는 구조체. */
+struct sr_worker_task {
+    sr_worker_callback on_work;
+    sr_worker_callback on_done;
+    void *data;
+    struct sr_worker_task *next;
+};
+
+/* 작업 스레드 풀의 작업 큐를 나타내는 구조체. */
+struct sr_worker_queue {
+    struct sr_worker_task *head;
+    struct sr_worker_task *tail;
+};
+
+/* 작업 스레드 풀을 나타내는 구조체. */
+struct sr_worker_pool {
+    pthread_t threads[MAX_WORKER_COUNT];
+    int count;
+    struct sr_worker_queue pending;
+    struct sr_worker_queue idle;
+    struct sr_worker_queue completed;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool running;
+};
+
+/* | `worker` 모듈 상수 및 변수... | */
+
+/* 작업 스레드 풀. */
+static struct sr_worker_pool pool;
+
+/* | `worker` 모듈 함수... | */
+
+/* 작업 큐의 맨 뒤에 작업을 추가한다. */
+static void sr_worker_queue_push(
+    struct sr_worker_queue *queue,
+    struct sr_worker_task *task
+);
+
+/* 작업 큐의 맨 앞에 있는 작업을 꺼낸다. */
+static struct sr_worker_task *sr_worker_queue_pop(struct sr_worker_queue *queue);
+
+/* 작업 스레드 풀의 주어진 작업 큐에 새로운 작업을 추가한다. */
+static void sr_worker_submit(
+    struct sr_worker_queue *queue,
+    sr_worker_callback on_work,
+    sr_worker_callback on_done,
+    void *data
+);
+
+/* 작업 스레드에서 실행되는 함수. */
+static void *sr_worker_run(void *arg);
+
+/* 작업 스레드 풀을 초기화한다. */
+void sr_worker_init(int count) {
+    if (count < 0) count = 0;
+    else if (count > MAX_WORKER_COUNT) count = MAX_WORKER_COUNT;
+
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.cond, NULL);
+
+    pool.running = true;
+
+    for (int i = 0; i < count; i++) {
+        if (pthread_create(&pool.threads[i], NULL, sr_worker_run, NULL) != 0) {
+            log_warn("[SAEROM] Failed to create worker thread #%d", i);
+
+            break;
+        }
+
+        pool.count++;
+    }
+
+    log_info("[SAEROM] Created %d worker thread(s)", pool.count);
+}
+
+/* 작업 스레드 풀에 할당된 메모리를 해제한다. */
+void sr_worker_cleanup(void) {
+    {
+        pthread_mutex_lock(&pool.lock);
+
+        pool.running = false;
+
+        pthread_cond_broadcast(&pool.cond);
+
+        pthread_mutex_unlock(&pool.lock);
+    }
+
+    // 작업 스레드는 남아 있는 작업을 모두 처리한 뒤에 종료된다.
+    for (int i = 0; i < pool.count; i++)
+        pthread_join(pool.threads[i], NULL);
+
+    pool.count = 0;
+
+    sr_worker_read_results();
+
+    pthread_cond_destroy(&pool.cond);
+    pthread_mutex_destroy(&pool.lock);
+}
+
+/* 작업 스레드 풀에 새로운 작업을 추가한다. */
+void sr_worker_push(
+    sr_worker_callback on_work,
+    sr_worker_callback on_done,
+    void *data
+) {
+    sr_worker_submit(&pool.pending, on_work, on_done, data);
+}
+
+/* 작업 스레드 풀에 다른 작업이 없을 때만 처리할 새로운 작업을 추가한다. */
+void sr_worker_push_idle(
+    sr_worker_callback on_work,
+    sr_worker_callback on_done,
+    void *data
+) {
+    sr_worker_submit(&pool.idle, on_work, on_done, data);
+}
+
+/* 작업 스레드 풀에서 처리가 끝난 작업들의 후처리 함수를 호출한다. */
+void sr_worker_read_results(void) {
+    struct sr_worker_task *task = NULL;
+
+    {
+        pthread_mutex_lock(&pool.lock);
+
+        task = pool.completed.head;
+
+        pool.completed.head = pool.completed.tail = NULL;
+
+        pthread_mutex_unlock(&pool.lock);
+    }
+
+    while (task != NULL) {
+        struct sr_worker_task *next = task->next;
+
+        if (task->on_done != NULL) task->on_done(task->data);
+
+        free(task);
+
+        task = next;
+    }
+}
+
+/* 작업 큐의 맨 뒤에 작업을 추가한다. */
+static void sr_worker_queue_push(
+    struct sr_worker_queue *queue,
+    struct sr_worker_task *task
+) {
+    task->next = NULL;
+
+    if (queue->tail != NULL) queue->tail->next = task;
+    else queue->head = task;
+
+    queue->tail = task;
+}
+
+/* 작업 큐의 맨 앞에 있는 작업을 꺼낸다. */
+static struct sr_worker_task *sr_worker_queue_pop(struct sr_worker_queue *queue) {
+    struct sr_worker_task *result = queue->head;
+
+    if (result != NULL) {
+        queue->head = result->next;
+
+        if (queue->head == NULL) queue->tail = NULL;
+    }
+
+    return result;
+}
+
+/* 작업 스레드 풀의 주어진 작업 큐에 새로운 작업을 추가한다. */
+static void sr_worker_submit(
+    struct sr_worker_queue *queue,
+    sr_worker_callback on_work,
+    sr_worker_callback on_done,
+    void *data
+) {
+    // 작업 스레드가 없다면, 현재 스레드에서 바로 처리한다.
+    if (pool.count <= 0 || !pool.running) {
+        if (on_work != NULL) on_work(data);
+        if (on_done != NULL) on_done(data);
+
+        return;
+    }
+
+    struct sr_worker_task *task = malloc(sizeof(*task));
+
+    task->on_work = on_work;
+    task->on_done = on_done;
+    task->data = data;
+    task->next = NULL;
+
+    pthread_mutex_lock(&pool.lock);
+
+    sr_worker_queue_push(queue, task);
+
+    pthread_cond_signal(&pool.cond);
+
+    pthread_mutex_unlock(&pool.lock);
+}
+
+/* 작업 스레드에서 실행되는 함수. */
+static void *sr_worker_run(void *arg) {
+    for (;;) {
+        struct sr_worker_task *task = NULL;
+
+        {
+            pthread_mutex_lock(&pool.lock);
+
+            while (pool.running && pool.pending.head == NULL && pool.idle.head == NULL)
+                pthread_cond_wait(&pool.cond, &pool.lock);
+
+            // 다른 작업이 없을 때만 처리할 작업은 대기 중인 작업을 모두 꺼낸 뒤에 꺼낸다.
+            task = sr_worker_queue_pop(&pool.pending);
+
+            if (task == NULL) task = sr_worker_queue_pop(&pool.idle);
+
+            pthread_mutex_unlock(&pool.lock);
+        }
+
+        if (task == NULL) break;
+
+        if (task->on_work != NULL) task->on_work(task->data);
+
+        // 후처리 함수는 Discord 봇의 메인 스레드에서 호출된다.
+        {
+            pthread_mutex_lock(&pool.lock);
+
+            sr_worker_queue_push(&pool.completed, task);
+
+            pthread_mutex_unlock(&pool.lock);
+        }
+    }
+
+    return NULL;
+}
\ No newline at end of file
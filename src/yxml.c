@@ -27,6 +27,14 @@
 #include <yxml.h>
 #include <string.h>
 
+#if !defined(YXML_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define YXML_SIMD_X86
+#include <immintrin.h>
+#elif !defined(YXML_NO_SIMD) && defined(__GNUC__) && defined(__aarch64__)
+#define YXML_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 typedef enum {
 	YXMLS_string,
 	YXMLS_attr0,
@@ -321,6 +329,143 @@ static inline yxml_ret_t yxml_refcontent(yxml_t *x, unsigned ch) { return yxml_r
 static inline yxml_ret_t yxml_refattrval(yxml_t *x, unsigned ch) { return yxml_refend(x, YXML_ATTRVAL); }
 
 
+/* The yxml_find_*() kernels return the offset of the first byte in buf that is
+ * '<', '&', '\r', '\n', '\0', stop1 or stop2, or len if there is none. The
+ * SIMD kernels check 16 or 32 bytes at a time and leave the tail to the scalar
+ * kernel. */
+static size_t yxml_find_scalar(const char *buf, size_t len, unsigned stop1, unsigned stop2) {
+	size_t i = 0;
+	for(; i < len; i++) {
+		unsigned ch = (unsigned char)buf[i];
+		/* All of the fixed bytes come before '>' in ASCII. */
+		if(ch > '>' && ch != stop1 && ch != stop2)
+			continue;
+		if(ch == '<' || ch == '&' || ch == '\r' || ch == '\n' || ch == '\0' || ch == stop1 || ch == stop2)
+			break;
+	}
+	return i;
+}
+
+
+#ifdef YXML_SIMD_X86
+static size_t yxml_find_sse2(const char *buf, size_t len, unsigned stop1, unsigned stop2) {
+	const __m128i lt = _mm_set1_epi8('<'), amp = _mm_set1_epi8('&'), cr = _mm_set1_epi8('\r');
+	const __m128i lf = _mm_set1_epi8('\n'), nul = _mm_setzero_si128();
+	const __m128i s1 = _mm_set1_epi8((char)stop1), s2 = _mm_set1_epi8((char)stop2);
+	size_t i = 0;
+	for(; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(buf + i));
+		__m128i m = _mm_or_si128(
+			_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, lt), _mm_cmpeq_epi8(v, amp)),
+				_mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf))),
+			_mm_or_si128(_mm_cmpeq_epi8(v, nul),
+				_mm_or_si128(_mm_cmpeq_epi8(v, s1), _mm_cmpeq_epi8(v, s2))));
+		unsigned mask = (unsigned)_mm_movemask_epi8(m);
+		if(mask)
+			return i + __builtin_ctz(mask);
+	}
+	return i + yxml_find_scalar(buf + i, len - i, stop1, stop2);
+}
+
+
+#ifndef YXML_NO_AVX2
+__attribute__((target("avx2")))
+static size_t yxml_find_avx2(const char *buf, size_t len, unsigned stop1, unsigned stop2) {
+	const __m256i lt = _mm256_set1_epi8('<'), amp = _mm256_set1_epi8('&'), cr = _mm256_set1_epi8('\r');
+	const __m256i lf = _mm256_set1_epi8('\n'), nul = _mm256_setzero_si256();
+	const __m256i s1 = _mm256_set1_epi8((char)stop1), s2 = _mm256_set1_epi8((char)stop2);
+	size_t i = 0;
+	for(; i + 32 <= len; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(buf + i));
+		__m256i m = _mm256_or_si256(
+			_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, lt), _mm256_cmpeq_epi8(v, amp)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf))),
+			_mm256_or_si256(_mm256_cmpeq_epi8(v, nul),
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, s1), _mm256_cmpeq_epi8(v, s2))));
+		unsigned mask = (unsigned)_mm256_movemask_epi8(m);
+		if(mask)
+			return i + __builtin_ctz(mask);
+	}
+	return i + yxml_find_sse2(buf + i, len - i, stop1, stop2);
+}
+#endif
+#endif
+
+
+#ifdef YXML_SIMD_NEON
+static size_t yxml_find_neon(const char *buf, size_t len, unsigned stop1, unsigned stop2) {
+	const uint8x16_t lt = vdupq_n_u8('<'), amp = vdupq_n_u8('&'), cr = vdupq_n_u8('\r');
+	const uint8x16_t lf = vdupq_n_u8('\n'), nul = vdupq_n_u8(0);
+	const uint8x16_t s1 = vdupq_n_u8((uint8_t)stop1), s2 = vdupq_n_u8((uint8_t)stop2);
+	size_t i = 0;
+	for(; i + 16 <= len; i += 16) {
+		uint8x16_t v = vld1q_u8((const uint8_t *)buf + i);
+		uint8x16_t m = vorrq_u8(
+			vorrq_u8(vorrq_u8(vceqq_u8(v, lt), vceqq_u8(v, amp)),
+				vorrq_u8(vceqq_u8(v, cr), vceqq_u8(v, lf))),
+			vorrq_u8(vceqq_u8(v, nul),
+				vorrq_u8(vceqq_u8(v, s1), vceqq_u8(v, s2))));
+		/* Narrow each byte of the comparison result to 4 bits of a 64-bit mask. */
+		uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+		if(mask)
+			return i + (__builtin_ctzll(mask) >> 2);
+	}
+	return i + yxml_find_scalar(buf + i, len - i, stop1, stop2);
+}
+#endif
+
+
+/* Most runs between tags are only a few bytes long, so the first 16 bytes are
+ * checked in place before handing the rest to the selected kernel. */
+static size_t yxml_find(yxml_t *x, const char *buf, size_t len, unsigned stop1, unsigned stop2) {
+	size_t n = len < 16 ? len : 16, i = yxml_find_scalar(buf, n, stop1, stop2);
+	if(i < n || n == len)
+		return i;
+	return n + x->find(buf + n, len - n, stop1, stop2);
+}
+
+
+/* The yxml_find_*() kernels built into this copy of yxml, in the order of
+ * preference. The first one the running CPU supports is used by default. SSE2
+ * comes before AVX2: most runs in NIKL responses are too short to fill 32
+ * bytes, and AVX2 did not beat SSE2 beyond run-to-run noise in bench-yxml. */
+static const struct {
+	const char *name;
+	size_t (*find)(const char *, size_t, unsigned, unsigned);
+} yxml_kernels[] = {
+#if defined(YXML_SIMD_X86)
+	{ "sse2", yxml_find_sse2 },
+#ifndef YXML_NO_AVX2
+	{ "avx2", yxml_find_avx2 },
+#endif
+#elif defined(YXML_SIMD_NEON)
+	{ "neon", yxml_find_neon },
+#endif
+	{ "scalar", yxml_find_scalar }
+};
+
+
+/* Returns whether the running CPU supports the given yxml_find_*() kernel. */
+static int yxml_find_supported(size_t (*find)(const char *, size_t, unsigned, unsigned)) {
+#if defined(YXML_SIMD_X86) && !defined(YXML_NO_AVX2)
+	if(find == yxml_find_avx2) {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+	}
+#endif
+	return 1;
+}
+
+
+/* Selects the preferred yxml_find_*() kernel supported by the running CPU. */
+static size_t (*yxml_find_select(void))(const char *, size_t, unsigned, unsigned) {
+	size_t i = 0;
+	while(!yxml_find_supported(yxml_kernels[i].find))
+		i++;
+	return yxml_kernels[i].find;
+}
+
+
 void yxml_init(yxml_t *x, void *stack, size_t stacksize) {
 	memset(x, 0, sizeof(*x));
 	x->line = 1;
@@ -329,6 +474,7 @@ void yxml_init(yxml_t *x, void *stack, size_t stacksize) {
 	*x->stack = 0;
 	x->elem = x->pi = x->attr = (char *)x->stack;
 	x->state = YXMLS_init;
+	x->find = yxml_find_select();
 }
 
 
@@ -1050,6 +1196,137 @@ yxml_ret_t yxml_parse(yxml_t *x, int _ch) {
 }
 
 
+/* Returns the length of the longest run of bytes at the start of buf that
+ * yxml_parse() would return one by one as content or attribute value, that is,
+ * without '<', '&', '\r', '\0' or the given stop character, and updates the
+ * position counters as if yxml_parse() had been called for each of them.
+ * Attribute values also stop at whitespace, which yxml_dataattr() normalizes. */
+static size_t yxml_scandata(yxml_t *x, const char *buf, size_t len, unsigned stop, int attr) {
+	const char *ptr = buf, *end = buf + len, *eol = NULL;
+	uint32_t lines = 0;
+	for(;;) {
+		ptr += yxml_find(x, ptr, end - ptr, stop, attr ? '\t' : stop);
+		if(ptr == end || *ptr != '\n' || attr)
+			break;
+		lines++;
+		eol = ptr++;
+	}
+	len = ptr - buf;
+	if(eol) {
+		x->line += lines;
+		x->byte = ptr - eol;
+	} else
+		x->byte += len;
+	x->total += len;
+	return len;
+}
+
+
+/* Returns the length of the longest run of name characters at the start of
+ * buf. If cmp is not NULL, the run also stops at the first byte that differs
+ * from cmp. Name characters never include a newline, so only the byte offset
+ * and total need to be updated. */
+static size_t yxml_scanname(yxml_t *x, const char *buf, size_t len, const char *cmp) {
+	size_t n = 0;
+	for(; n < len; n++) {
+		unsigned ch = (unsigned char)buf[n];
+		if(!yxml_isName(ch) || (cmp && cmp[n] != buf[n]))
+			break;
+	}
+	x->byte += n;
+	x->total += n;
+	return n;
+}
+
+
+/* Consumes a run of bytes from buf without going through the state machine for
+ * each of them, if the current state allows it. Returns the number of bytes
+ * consumed (possibly 0) and stores the resulting token in *r. */
+static size_t yxml_fastpath(yxml_t *x, const char *buf, size_t len, yxml_ret_t *r) {
+	size_t n = 0;
+	/* A pending '\r' still needs yxml_parse() to swallow the following '\n'. */
+	if(x->ignore)
+		return 0;
+	*r = YXML_OK;
+	switch((yxml_state_t)x->state) {
+	case YXMLS_misc2:
+	case YXMLS_attr3:
+	case YXMLS_cd0:
+		n = yxml_scandata(x, buf, len,
+			x->state == YXMLS_misc2 ? '<' : x->state == YXMLS_attr3 ? x->quote : ']',
+			x->state == YXMLS_attr3);
+		if(n > 0) {
+			x->span = buf;
+			x->spanlen = n;
+			*r = x->state == YXMLS_attr3 ? YXML_ATTRVAL : YXML_CONTENT;
+		}
+		break;
+	case YXMLS_elem0:
+	case YXMLS_attr0:
+		/* Leave a full stack to yxml_parse(), which reports the error. */
+		n = len < x->stacksize - x->stacklen - 1 ? len : x->stacksize - x->stacklen - 1;
+		n = yxml_scanname(x, buf, n, NULL);
+		memcpy(x->stack + x->stacklen, buf, n);
+		x->stacklen += n;
+		x->stack[x->stacklen] = 0;
+		break;
+	case YXMLS_etag1:
+		/* x->elem is zero-terminated, so a mismatch stops the run before its end. */
+		n = yxml_scanname(x, buf, len, x->elem);
+		x->elem += n;
+		break;
+	default:
+		break;
+	}
+	return n;
+}
+
+
+yxml_ret_t yxml_parse_buf(yxml_t *x, const char *buf, size_t len, size_t *consumed) {
+	yxml_ret_t r = YXML_OK;
+	size_t i = 0, n;
+	while(i < len) {
+		if((n = yxml_fastpath(x, buf+i, len-i, &r)) > 0)
+			i += n;
+		else if((r = yxml_parse(x, buf[i++])) == YXML_CONTENT || r == YXML_ATTRVAL || r == YXML_PICONTENT) {
+			x->span = x->data;
+			x->spanlen = strlen(x->data);
+		}
+		if(r == YXML_OK)
+			continue;
+		if(x->skip && r > 0) {
+			/* Only the end tag of the skipped element itself is returned. */
+			if(r == YXML_ELEMSTART)
+				x->skip++;
+			else if(r == YXML_ELEMEND && !--x->skip)
+				break;
+			r = YXML_OK;
+			continue;
+		}
+		break;
+	}
+	*consumed = i;
+	return r;
+}
+
+
+void yxml_skip(yxml_t *x) {
+	x->skip = 1;
+}
+
+
+int yxml_set_kernel(yxml_t *x, const char *name) {
+	size_t i;
+	for(i = 0; i < sizeof(yxml_kernels) / sizeof(*yxml_kernels); i++) {
+		if(strcmp(yxml_kernels[i].name, name) == 0 && yxml_find_supported(yxml_kernels[i].find)) {
+			x->find = yxml_kernels[i].find;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
 yxml_ret_t yxml_eof(yxml_t *x) {
 	if(x->state != YXMLS_misc3)
 		return YXML_EEOF;
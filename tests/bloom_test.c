@@ -0,0 +1,157 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <saerom.h>
+
+/* | `bloom_test` 모듈 매크로 정의... | */
+
+#define KEY_COUNT           10000
+#define PROBE_COUNT         100000
+
+#define FALSE_POSITIVE_RATE 0.01
+
+/* | `bloom_test` 모듈 함수... | */
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result);
+
+/* 추가한 문자열은 항상 찾을 수 있는지 확인한다. */
+static bool check_members(void);
+
+/* 추가하지 않은 문자열의 오탐률이 주어진 값에 가까운지 확인한다. */
+static bool check_false_positives(void);
+
+/* 잘못된 인자와 비어 있는 블룸 필터를 올바르게 처리하는지 확인한다. */
+static bool check_invalid(void);
+
+/* `utils` 모듈의 `read_input()`이 사용하는 명령어 목록. 이 테스트에서는 비어 있다. */
+const struct sr_command *sr_get_commands(int *len) {
+    if (len != NULL) *len = 0;
+
+    return NULL;
+}
+
+/* 블룸 필터가 표제어 목록에 없는 검색어만 걸러내는지 확인한다. */
+int main(void) {
+    int failed = 0;
+
+    failed += report("members", check_members());
+    failed += report("false positives", check_false_positives());
+    failed += report("invalid", check_invalid());
+
+    return (failed > 0) ? 1 : 0;
+}
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result) {
+    printf("%-8s %-32s %s\n", "bloom", name, result ? "ok" : "FAILED");
+
+    return result ? 0 : 1;
+}
+
+/* 추가한 문자열은 항상 찾을 수 있는지 확인한다. */
+static bool check_members(void) {
+    struct sr_bloom *bloom = sr_bloom_create(KEY_COUNT, FALSE_POSITIVE_RATE);
+
+    if (bloom == NULL) return false;
+
+    char key[MAX_STRING_SIZE] = "";
+
+    for (int i = 0; i < KEY_COUNT; i++) {
+        snprintf(key, sizeof(key), "word:y:표제어%d", i);
+
+        sr_bloom_add(bloom, key);
+    }
+
+    bool result = true;
+
+    for (int i = 0; i < KEY_COUNT && result; i++) {
+        snprintf(key, sizeof(key), "word:y:표제어%d", i);
+
+        result = sr_bloom_test(bloom, key);
+    }
+
+    sr_bloom_release(bloom);
+
+    return result;
+}
+
+/* 추가하지 않은 문자열의 오탐률이 주어진 값에 가까운지 확인한다. */
+static bool check_false_positives(void) {
+    struct sr_bloom *bloom = sr_bloom_create(KEY_COUNT, FALSE_POSITIVE_RATE);
+
+    if (bloom == NULL) return false;
+
+    char key[MAX_STRING_SIZE] = "";
+
+    for (int i = 0; i < KEY_COUNT; i++) {
+        snprintf(key, sizeof(key), "word:y:표제어%d", i);
+
+        sr_bloom_add(bloom, key);
+    }
+
+    int positives = 0;
+
+    for (int i = 0; i < PROBE_COUNT; i++) {
+        snprintf(key, sizeof(key), "word:y:검색어%d", i);
+
+        if (sr_bloom_test(bloom, key)) positives++;
+    }
+
+    const double rate = (double) positives / PROBE_COUNT;
+
+    // 해시 값이 고르게 퍼지지 않으면, 오탐률이 주어진 값보다 훨씬 높아진다.
+    const bool result = rate < 2 * FALSE_POSITIVE_RATE
+        && sr_bloom_get_size(bloom) < KEY_COUNT * 2;
+
+    if (!result)
+        fprintf(
+            stderr,
+            "bloom: %d/%d false positive(s), %zu byte(s)\n",
+            positives,
+            PROBE_COUNT,
+            sr_bloom_get_size(bloom)
+        );
+
+    sr_bloom_release(bloom);
+
+    return result;
+}
+
+/* 잘못된 인자와 비어 있는 블룸 필터를 올바르게 처리하는지 확인한다. */
+static bool check_invalid(void) {
+    if (sr_bloom_create(KEY_COUNT, 0.0) != NULL) return false;
+    if (sr_bloom_create(KEY_COUNT, 1.0) != NULL) return false;
+
+    // 블룸 필터가 없다면, 모든 문자열이 있을 수도 있다고 판단해야 한다.
+    if (!sr_bloom_test(NULL, "사과")) return false;
+
+    struct sr_bloom *bloom = sr_bloom_create(0, FALSE_POSITIVE_RATE);
+
+    if (bloom == NULL) return false;
+
+    const bool result = !sr_bloom_test(bloom, "사과");
+
+    sr_bloom_release(bloom);
+
+    return result;
+}
@@ -0,0 +1,445 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unistd.h>
+
+#include <saerom.h>
+
+/* | `cache_test` 모듈 매크로 정의... | */
+
+#define CACHE_BUDGET      65536
+#define CACHE_TTL         600000
+
+#define VALUE_SIZE        4096
+
+#define COMPACT_KEY_COUNT 8
+#define COMPACT_ROUNDS    64
+
+/* | `cache_test` 모듈 상수 및 변수... | */
+
+/* 캐시 파일을 만들 디렉토리의 경로. */
+static const char *directory;
+
+/* | `cache_test` 모듈 함수... | */
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result);
+
+/* 주어진 이름의 캐시 파일 경로를 만들고, 이전에 만든 파일을 지운다. */
+static void get_cache_path(const char *name, char *buffer, size_t size);
+
+/* 주어진 파일의 내용을 읽는다. */
+static char *read_file(const char *path, size_t *len);
+
+/* 주어진 파일에서 주어진 문자열이 처음 나오는 위치를 찾는다. */
+static long find_in_file(const char *path, const char *str);
+
+/* 캐시에서 주어진 키의 값이 주어진 문자열과 같은지 확인한다. */
+static bool expect_value(struct sr_cache *cache, const char *key, const char *value);
+
+/* 메모리 예산을 넘으면 가장 오래 사용되지 않은 항목부터 제거하는지 확인한다. */
+static bool check_eviction(void);
+
+/* 유효 기간이 지난 항목을 반환하지 않는지 확인한다. */
+static bool check_expiry(void);
+
+/* TinyLFU 정책에서 이미 캐시에 있는 항목의 값을 바꿀 수 있는지 확인한다. */
+static bool check_tinylfu_update(void);
+
+/* 캐시 파일을 다시 열었을 때, 각 키의 마지막 값을 읽을 수 있는지 확인한다. */
+static bool check_reopen(void);
+
+/* 기록하는 도중에 중단된 항목을 버리고, 그 뒤에 새로운 항목을 기록할 수 있는지 확인한다. */
+static bool check_torn_record(void);
+
+/* 내용이 손상된 항목을 버리고, 다른 항목은 그대로 읽을 수 있는지 확인한다. */
+static bool check_corrupt_record(void);
+
+/* 캐시 파일이 가득 찼을 때, 제거된 항목들을 정리하고 계속 기록하는지 확인한다. */
+static bool check_compaction(void);
+
+/* `utils` 모듈의 `read_input()`이 사용하는 명령어 목록. 이 테스트에서는 비어 있다. */
+const struct sr_command *sr_get_commands(int *len) {
+    if (len != NULL) *len = 0;
+
+    return NULL;
+}
+
+/* 메모리 캐시와 캐시 파일이 항목들을 올바르게 저장하고, 손상된 항목을 걸러내는지 확인한다. */
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s DIRECTORY\n", argv[0]);
+
+        return 2;
+    }
+
+    directory = argv[1];
+
+    int failed = 0;
+
+    failed += report("eviction", check_eviction());
+    failed += report("expiry", check_expiry());
+    failed += report("tinylfu update", check_tinylfu_update());
+    failed += report("reopen", check_reopen());
+    failed += report("torn record", check_torn_record());
+    failed += report("corrupt record", check_corrupt_record());
+    failed += report("compaction", check_compaction());
+
+    return (failed > 0) ? 1 : 0;
+}
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result) {
+    printf("%-8s %-32s %s\n", "cache", name, result ? "ok" : "FAILED");
+
+    return result ? 0 : 1;
+}
+
+/* 주어진 이름의 캐시 파일 경로를 만들고, 이전에 만든 파일을 지운다. */
+static void get_cache_path(const char *name, char *buffer, size_t size) {
+    snprintf(buffer, size, "%s/%s.cache", directory, name);
+
+    remove(buffer);
+}
+
+/* 주어진 파일의 내용을 읽는다. */
+static char *read_file(const char *path, size_t *len) {
+    FILE *fp = fopen(path, "rb");
+
+    if (fp == NULL) return NULL;
+
+    fseek(fp, 0, SEEK_END);
+
+    *len = ftell(fp);
+
+    fseek(fp, 0, SEEK_SET);
+
+    char *result = malloc(*len + 1);
+
+    if (fread(result, 1, *len, fp) != *len) *len = 0;
+
+    result[*len] = '\0';
+
+    fclose(fp);
+
+    return result;
+}
+
+/* 주어진 파일에서 주어진 문자열이 처음 나오는 위치를 찾는다. */
+static long find_in_file(const char *path, const char *str) {
+    size_t len = 0;
+
+    char *data = read_file(path, &len);
+
+    if (data == NULL) return -1;
+
+    const size_t str_len = strlen(str);
+
+    long result = -1;
+
+    for (size_t i = 0; i + str_len <= len && result < 0; i++)
+        if (memcmp(data + i, str, str_len) == 0) result = i;
+
+    free(data);
+
+    return result;
+}
+
+/* 캐시에서 주어진 키의 값이 주어진 문자열과 같은지 확인한다. */
+static bool expect_value(struct sr_cache *cache, const char *key, const char *value) {
+    char buffer[VALUE_SIZE + 1] = "";
+
+    const size_t len = sr_cache_get(cache, key, buffer, VALUE_SIZE);
+
+    if (value == NULL) return (len == 0);
+
+    return len == strlen(value) + 1 && streq(buffer, value);
+}
+
+/* 메모리 예산을 넘으면 가장 오래 사용되지 않은 항목부터 제거하는지 확인한다. */
+static bool check_eviction(void) {
+    struct sr_cache *cache = sr_cache_create(4096, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    char key[32] = "", value[256] = "";
+
+    memset(value, 'v', sizeof(value) - 1);
+
+    for (int i = 0; i < 64; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+
+        sr_cache_put(cache, key, value, sizeof(value));
+
+        // 첫 번째 항목은 계속 사용하여, 제거되지 않도록 한다.
+        sr_cache_get(cache, "key0", value, sizeof(value));
+    }
+
+    struct sr_cache_stats stats = { .count = 0 };
+
+    sr_cache_get_stats(cache, &stats);
+
+    const bool result = stats.size <= 4096 && stats.evictions > 0
+        && sr_cache_get(cache, "key0", value, sizeof(value)) == sizeof(value)
+        && sr_cache_get(cache, "key1", value, sizeof(value)) == 0
+        && sr_cache_get(cache, "key63", value, sizeof(value)) == sizeof(value);
+
+    sr_cache_release(cache);
+
+    return result;
+}
+
+/* 유효 기간이 지난 항목을 반환하지 않는지 확인한다. */
+static bool check_expiry(void) {
+    struct sr_cache *cache = sr_cache_create(CACHE_BUDGET, 0, SR_CACHE_POLICY_LRU);
+
+    sr_cache_put(cache, "사과", "apple", sizeof("apple"));
+
+    const bool result = expect_value(cache, "사과", NULL);
+
+    sr_cache_release(cache);
+
+    return result;
+}
+
+/* TinyLFU 정책에서 이미 캐시에 있는 항목의 값을 바꿀 수 있는지 확인한다. */
+static bool check_tinylfu_update(void) {
+    struct sr_cache *cache = sr_cache_create(4096, CACHE_TTL, SR_CACHE_POLICY_TINYLFU);
+
+    char key[32] = "", value[VALUE_SIZE] = "";
+
+    memset(value, 'x', 40);
+
+    // 한 번만 사용된 항목이 LRU 목록의 맨 뒤에 오도록 한다.
+    sr_cache_put(cache, "key0", value, 40);
+    sr_cache_get(cache, "key0", value, sizeof(value));
+
+    for (int i = 1; i < 20; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+
+        sr_cache_put(cache, key, value, 40);
+
+        for (int j = 0; j < 5; j++)
+            sr_cache_get(cache, key, value, sizeof(value));
+    }
+
+    /*
+        더 큰 값으로 바꾸려면 다른 항목들을 제거해야 한다. 바꿀 항목의 사용 빈도가 낮더라도,
+        이미 캐시에 있는 항목이므로 새로운 값을 거절해서는 안 된다.
+    */
+
+    memset(value, 'y', VALUE_SIZE / 2);
+
+    sr_cache_put(cache, "key0", value, VALUE_SIZE / 2);
+
+    memset(value, 0, sizeof(value));
+
+    const bool result = sr_cache_get(cache, "key0", value, sizeof(value)) == VALUE_SIZE / 2
+        && value[0] == 'y';
+
+    sr_cache_release(cache);
+
+    return result;
+}
+
+/* 캐시 파일을 다시 열었을 때, 각 키의 마지막 값을 읽을 수 있는지 확인한다. */
+static bool check_reopen(void) {
+    char path[MAX_STRING_SIZE] = "";
+
+    get_cache_path("reopen", path, sizeof(path));
+
+    struct sr_cache *cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    sr_cache_put(cache, "사과", "apple", sizeof("apple"));
+    sr_cache_put(cache, "포도", "grape", sizeof("grape"));
+    sr_cache_put(cache, "사과", "red apple", sizeof("red apple"));
+
+    sr_cache_release(cache);
+
+    cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    const bool result = expect_value(cache, "사과", "red apple")
+        && expect_value(cache, "포도", "grape")
+        && expect_value(cache, "딸기", NULL);
+
+    sr_cache_release(cache);
+
+    remove(path);
+
+    return result;
+}
+
+/* 기록하는 도중에 중단된 항목을 버리고, 그 뒤에 새로운 항목을 기록할 수 있는지 확인한다. */
+static bool check_torn_record(void) {
+    char path[MAX_STRING_SIZE] = "";
+
+    get_cache_path("torn", path, sizeof(path));
+
+    struct sr_cache *cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    sr_cache_put(cache, "사과", "apple", sizeof("apple"));
+    sr_cache_put(cache, "포도", "grape", sizeof("grape"));
+    sr_cache_put(cache, "딸기", "strawberry", sizeof("strawberry"));
+
+    sr_cache_release(cache);
+
+    // 마지막 항목의 값을 기록하는 도중에 프로세스가 종료된 것처럼 파일을 자른다.
+    const long offset = find_in_file(path, "strawberry");
+
+    if (offset < 0 || truncate(path, offset + 4) != 0) return false;
+
+    cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    bool result = expect_value(cache, "사과", "apple")
+        && expect_value(cache, "포도", "grape")
+        && expect_value(cache, "딸기", NULL);
+
+    sr_cache_put(cache, "수박", "watermelon", sizeof("watermelon"));
+
+    sr_cache_release(cache);
+
+    cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    result = result
+        && expect_value(cache, "사과", "apple")
+        && expect_value(cache, "수박", "watermelon")
+        && expect_value(cache, "딸기", NULL);
+
+    sr_cache_release(cache);
+
+    remove(path);
+
+    return result;
+}
+
+/* 내용이 손상된 항목을 버리고, 다른 항목은 그대로 읽을 수 있는지 확인한다. */
+static bool check_corrupt_record(void) {
+    char path[MAX_STRING_SIZE] = "";
+
+    get_cache_path("corrupt", path, sizeof(path));
+
+    struct sr_cache *cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    sr_cache_put(cache, "사과", "apple", sizeof("apple"));
+    sr_cache_put(cache, "포도", "grape", sizeof("grape"));
+    sr_cache_put(cache, "딸기", "strawberry", sizeof("strawberry"));
+
+    sr_cache_release(cache);
+
+    // 가운데 항목의 값 한 바이트만 바꾼다.
+    const long offset = find_in_file(path, "grape");
+
+    FILE *fp = fopen(path, "r+b");
+
+    if (offset < 0 || fp == NULL) {
+        if (fp != NULL) fclose(fp);
+
+        return false;
+    }
+
+    fseek(fp, offset, SEEK_SET);
+    fputc('G', fp);
+    fclose(fp);
+
+    cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    bool result = expect_value(cache, "사과", "apple")
+        && expect_value(cache, "포도", NULL)
+        && expect_value(cache, "딸기", "strawberry");
+
+    // 버려진 항목은 다시 기록할 수 있어야 한다.
+    sr_cache_put(cache, "포도", "grape", sizeof("grape"));
+
+    result = result && expect_value(cache, "포도", "grape");
+
+    sr_cache_release(cache);
+
+    remove(path);
+
+    return result;
+}
+
+/* 캐시 파일이 가득 찼을 때, 제거된 항목들을 정리하고 계속 기록하는지 확인한다. */
+static bool check_compaction(void) {
+    char path[MAX_STRING_SIZE] = "", tmp_path[MAX_STRING_SIZE + 4] = "";
+
+    get_cache_path("compact", path, sizeof(path));
+
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    struct sr_cache *cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    char key[32] = "", value[VALUE_SIZE] = "";
+
+    bool result = true;
+
+    /*
+        같은 키들의 값을 계속 바꾸면, 캐시 파일에는 제거된 항목들이 쌓인다.
+        기록한 양은 캐시 파일의 크기보다 크므로, 정리하지 않으면 새로운 값을 기록할 수 없다.
+    */
+
+    for (int round = 0; round < COMPACT_ROUNDS && result; round++) {
+        for (int i = 0; i < COMPACT_KEY_COUNT; i++) {
+            snprintf(key, sizeof(key), "key%d", i);
+
+            memset(value, 'a' + (round % 26), VALUE_SIZE - 1);
+
+            snprintf(value, sizeof(value), "%d:%d", i, round);
+
+            value[strlen(value)] = ' ';
+            value[VALUE_SIZE - 1] = '\0';
+
+            sr_cache_put(cache, key, value, VALUE_SIZE);
+        }
+
+        for (int i = 0; i < COMPACT_KEY_COUNT && result; i++) {
+            char expected[32] = "";
+
+            snprintf(key, sizeof(key), "key%d", i);
+            snprintf(expected, sizeof(expected), "%d:%d ", i, round);
+
+            result = sr_cache_get(cache, key, value, sizeof(value)) == VALUE_SIZE
+                && strncmp(value, expected, strlen(expected)) == 0;
+        }
+    }
+
+    sr_cache_release(cache);
+
+    // 정리한 뒤에 다시 열어도, 각 키의 마지막 값을 읽을 수 있어야 한다.
+    cache = sr_cache_open(path, CACHE_BUDGET, CACHE_TTL, SR_CACHE_POLICY_LRU);
+
+    for (int i = 0; i < COMPACT_KEY_COUNT && result; i++) {
+        char expected[32] = "";
+
+        snprintf(key, sizeof(key), "key%d", i);
+        snprintf(expected, sizeof(expected), "%d:%d ", i, COMPACT_ROUNDS - 1);
+
+        result = sr_cache_get(cache, key, value, sizeof(value)) == VALUE_SIZE
+            && strncmp(value, expected, strlen(expected)) == 0;
+    }
+
+    sr_cache_release(cache);
+
+    result = result && access(tmp_path, F_OK) != 0;
+
+    remove(path);
+
+    return result;
+}
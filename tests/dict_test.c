@@ -0,0 +1,503 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unistd.h>
+
+#include <saerom.h>
+
+/* | `dict_test` 모듈 매크로 정의... | */
+
+#define MAX_SENSE_COUNT   8
+#define MAX_WORD_COUNT    8
+
+#define LONG_VALUE_SIZE   (4 * MAX_STRING_SIZE)
+
+#define MERGE_TIMEOUT     10000
+
+/* | `dict_test` 모듈 상수 및 변수... | */
+
+/* 기본 파일로 변환할 사전 데이터. */
+static const char base_xml[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<LexicalResource><Lexicon>\n"
+    "<LexicalEntry att=\"id\" val=\"1\">"
+    "<feat att=\"partOfSpeech\" val=\"명사\"/>"
+    "<feat att=\"vocabularyLevel\" val=\"초급\"/>"
+    "<Lemma><feat att=\"writtenForm\" val=\"사과\"/></Lemma>"
+    "<Sense val=\"0\"><feat att=\"definition\" val=\"사과나무의 열매.\"/>"
+    "<Equivalent><feat att=\"language\" val=\"영어\"/><feat att=\"lemma\" val=\"apple\"/>"
+    "<feat att=\"definition\" val=\"The fruit of an apple tree.\"/></Equivalent></Sense>"
+    "<Sense val=\"1\"><feat att=\"definition\" val=\"사과의 두 번째 뜻.\"/></Sense>"
+    "</LexicalEntry>\n"
+    "<LexicalEntry att=\"id\" val=\"2\">"
+    "<feat att=\"partOfSpeech\" val=\"명사\"/>"
+    "<Lemma><feat att=\"writtenForm\" val=\"사과\"/></Lemma>"
+    "<Sense val=\"0\"><feat att=\"definition\" val=\"잘못을 인정하고 용서를 빎.\"/></Sense>"
+    "</LexicalEntry>\n"
+    "<LexicalEntry att=\"id\" val=\"3\">"
+    "<feat att=\"partOfSpeech\" val=\"명사\"/>"
+    "<Lemma><feat att=\"writtenForm\" val=\"사과나무\"/></Lemma>"
+    "<Sense val=\"0\"><feat att=\"definition\" val=\"사과가 열리는 나무.\"/></Sense>"
+    "</LexicalEntry>\n"
+    "<LexicalEntry att=\"id\" val=\"4\">"
+    "<feat att=\"partOfSpeech\" val=\"명사\"/>"
+    "<Lemma><feat att=\"writtenForm\" val=\"배\"/></Lemma>"
+    "<Sense val=\"0\"><feat att=\"definition\" val=\"배나무의 열매.\"/></Sense>"
+    "</LexicalEntry>\n"
+    "</Lexicon></LexicalResource>\n";
+
+/* 변경분 파일로 변환할 사전 데이터. */
+static const char update_xml[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<LexicalResource><Lexicon>\n"
+    "<LexicalEntry att=\"id\" val=\"1\">"
+    "<feat att=\"partOfSpeech\" val=\"명사\"/>"
+    "<Lemma><feat att=\"writtenForm\" val=\"사과\"/></Lemma>"
+    "<Sense val=\"0\"><feat att=\"definition\" val=\"고친 뜻풀이.\"/></Sense>"
+    "</LexicalEntry>\n"
+    "<LexicalEntry att=\"id\" val=\"5\">"
+    "<feat att=\"partOfSpeech\" val=\"명사\"/>"
+    "<Lemma><feat att=\"writtenForm\" val=\"포도\"/></Lemma>"
+    "<Sense val=\"0\"><feat att=\"definition\" val=\"포도나무의 열매.\"/></Sense>"
+    "</LexicalEntry>\n"
+    "</Lexicon></LexicalResource>\n";
+
+/* 사전 데이터 파일을 만들 디렉토리의 경로. */
+static const char *directory;
+
+/* | `dict_test` 모듈 함수... | */
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result);
+
+/* 주어진 이름의 파일 경로를 만든다. */
+static void get_path(const char *name, char *buffer, size_t size);
+
+/* 주어진 파일에 주어진 문자열을 기록한다. */
+static bool write_file(const char *path, const char *str);
+
+/* 사전 데이터 파일과 그 변경분 파일들을 지운다. */
+static void remove_dict(const char *path);
+
+/* 검색 결과의 표제어 목록이 주어진 목록과 같은지 확인한다. */
+static bool expect_words(const char **words, int count, const char *expected[], int len);
+
+/* 사전 데이터를 변환한 뒤에 표제어와 뜻풀이를 찾을 수 있는지 확인한다. */
+static bool check_import(void);
+
+/* 접두사와 범위로 표제어들을 바이트 순서대로 찾는지 확인한다. */
+static bool check_prefix(void);
+
+/* 필드보다 긴 속성 값을 잘라서, 버퍼 밖에 쓰지 않고 변환하는지 확인한다. */
+static bool check_long_values(void);
+
+/* 변경분 파일의 항목이 기본 파일의 같은 항목을 대신하고, 병합한 뒤에도 같은지 확인한다. */
+static bool check_update(void);
+
+/* 변경분 파일을 적용한 사전 데이터에서 `사과`의 검색 결과가 올바른지 확인한다. */
+static bool check_updated_senses(struct sr_dict_snapshot *snapshot);
+
+/* `utils` 모듈의 `read_input()`이 사용하는 명령어 목록. 이 테스트에서는 비어 있다. */
+const struct sr_command *sr_get_commands(int *len) {
+    if (len != NULL) *len = 0;
+
+    return NULL;
+}
+
+/* 사전 데이터 파일의 변환, 검색, 변경분 파일의 적용과 병합이 올바른지 확인한다. */
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s DIRECTORY\n", argv[0]);
+
+        return 2;
+    }
+
+    directory = argv[1];
+
+    int failed = 0;
+
+    failed += report("import", check_import());
+    failed += report("prefix", check_prefix());
+    failed += report("long values", check_long_values());
+    failed += report("update", check_update());
+
+    return (failed > 0) ? 1 : 0;
+}
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result) {
+    printf("%-8s %-32s %s\n", "dict", name, result ? "ok" : "FAILED");
+
+    return result ? 0 : 1;
+}
+
+/* 주어진 이름의 파일 경로를 만든다. */
+static void get_path(const char *name, char *buffer, size_t size) {
+    snprintf(buffer, size, "%s/%s", directory, name);
+}
+
+/* 주어진 파일에 주어진 문자열을 기록한다. */
+static bool write_file(const char *path, const char *str) {
+    FILE *fp = fopen(path, "w");
+
+    if (fp == NULL) return false;
+
+    const bool result = fputs(str, fp) >= 0;
+
+    return (fclose(fp) == 0) && result;
+}
+
+/* 사전 데이터 파일과 그 변경분 파일들을 지운다. */
+static void remove_dict(const char *path) {
+    char segment_path[MAX_STRING_SIZE + 24] = "";
+
+    for (int i = 1; i <= 16; i++) {
+        snprintf(segment_path, sizeof(segment_path), "%s.%d", path, i);
+
+        remove(segment_path);
+    }
+
+    remove(path);
+}
+
+/* 검색 결과의 표제어 목록이 주어진 목록과 같은지 확인한다. */
+static bool expect_words(const char **words, int count, const char *expected[], int len) {
+    if (count != len) return false;
+
+    for (int i = 0; i < len; i++)
+        if (!streq(words[i], expected[i])) return false;
+
+    return true;
+}
+
+/* 사전 데이터를 변환한 뒤에 표제어와 뜻풀이를 찾을 수 있는지 확인한다. */
+static bool check_import(void) {
+    char xml_path[MAX_STRING_SIZE] = "", path[MAX_STRING_SIZE] = "";
+
+    get_path("base.xml", xml_path, sizeof(xml_path));
+    get_path("import.dict", path, sizeof(path));
+
+    remove_dict(path);
+
+    const char *inputs[] = { xml_path };
+
+    if (!write_file(xml_path, base_xml) || !sr_dict_import(inputs, 1, path, 2)) return false;
+
+    struct sr_dict *dict = sr_dict_open(path);
+
+    if (dict == NULL) return false;
+
+    struct sr_dict_snapshot *snapshot = sr_dict_acquire(dict);
+
+    struct sr_dict_sense senses[MAX_SENSE_COUNT];
+
+    int total = 0;
+
+    // 같은 표제어의 항목들은 항목 번호, 뜻풀이 순서대로 나와야 한다.
+    const int count = sr_dict_find(snapshot, "사과", senses, MAX_SENSE_COUNT, &total);
+
+    bool result = count == 3 && total == 2
+        && streq(senses[0].definition, "사과나무의 열매.")
+        && streq(senses[0].trans_word, "apple")
+        && streq(senses[0].trans_dfn, "The fruit of an apple tree.")
+        && senses[0].level == SR_DICT_LEVEL_BEGINNER
+        && senses[0].order == 1
+        && streq(senses[1].definition, "사과의 두 번째 뜻.")
+        && senses[1].order == 2
+        && streq(senses[2].definition, "잘못을 인정하고 용서를 빎.")
+        && !streq(senses[0].link, senses[2].link);
+
+    result = result
+        && sr_dict_find(snapshot, "배", senses, MAX_SENSE_COUNT, &total) == 1
+        && sr_dict_find(snapshot, "포도", senses, MAX_SENSE_COUNT, &total) == 0
+        && total == 0
+        && sr_dict_find(snapshot, "사", senses, MAX_SENSE_COUNT, &total) == 0
+        && sr_dict_get_word_count(snapshot) == 3;
+
+    sr_dict_release(snapshot);
+    sr_dict_close(dict);
+
+    remove_dict(path);
+    remove(xml_path);
+
+    return result;
+}
+
+/* 접두사와 범위로 표제어들을 바이트 순서대로 찾는지 확인한다. */
+static bool check_prefix(void) {
+    char xml_path[MAX_STRING_SIZE] = "", path[MAX_STRING_SIZE] = "";
+
+    get_path("base.xml", xml_path, sizeof(xml_path));
+    get_path("prefix.dict", path, sizeof(path));
+
+    remove_dict(path);
+
+    const char *inputs[] = { xml_path };
+
+    if (!write_file(xml_path, base_xml) || !sr_dict_import(inputs, 1, path, 1)) return false;
+
+    struct sr_dict *dict = sr_dict_open(path);
+
+    if (dict == NULL) return false;
+
+    struct sr_dict_snapshot *snapshot = sr_dict_acquire(dict);
+
+    const char *words[MAX_WORD_COUNT] = { NULL };
+
+    const char *apples[] = { "사과", "사과나무" };
+    const char *all[] = { "배", "사과", "사과나무" };
+
+    bool result = expect_words(
+        words,
+        sr_dict_find_prefix(snapshot, "사", words, MAX_WORD_COUNT),
+        apples,
+        2
+    );
+
+    result = result && expect_words(
+        words,
+        sr_dict_find_prefix(snapshot, "사과", words, 1),
+        apples,
+        1
+    );
+
+    result = result
+        && sr_dict_find_prefix(snapshot, "포", words, MAX_WORD_COUNT) == 0
+        && sr_dict_find_prefix(snapshot, "사과나무들", words, MAX_WORD_COUNT) == 0;
+
+    result = result && expect_words(
+        words,
+        sr_dict_find_range(snapshot, NULL, NULL, words, MAX_WORD_COUNT),
+        all,
+        3
+    );
+
+    // 범위의 끝에 있는 표제어는 결과에 포함되지 않는다.
+    result = result && expect_words(
+        words,
+        sr_dict_find_range(snapshot, "배", "사과나무", words, MAX_WORD_COUNT),
+        all,
+        2
+    );
+
+    result = result && expect_words(
+        words,
+        sr_dict_find_range(snapshot, "바", "사", words, MAX_WORD_COUNT),
+        all,
+        1
+    );
+
+    sr_dict_release(snapshot);
+    sr_dict_close(dict);
+
+    remove_dict(path);
+    remove(xml_path);
+
+    return result;
+}
+
+/* 필드보다 긴 속성 값을 잘라서, 버퍼 밖에 쓰지 않고 변환하는지 확인한다. */
+static bool check_long_values(void) {
+    char xml_path[MAX_STRING_SIZE] = "", path[MAX_STRING_SIZE] = "";
+
+    get_path("long.xml", xml_path, sizeof(xml_path));
+    get_path("long.dict", path, sizeof(path));
+
+    remove_dict(path);
+
+    char *value = malloc(LONG_VALUE_SIZE);
+
+    memset(value, 'a', LONG_VALUE_SIZE - 1);
+
+    value[LONG_VALUE_SIZE - 1] = '\0';
+
+    const size_t size = 2 * LONG_VALUE_SIZE + 1024;
+
+    char *xml = malloc(size);
+
+    // 품사와 뜻풀이의 값은 각 필드의 크기보다 길다.
+    snprintf(
+        xml,
+        size,
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<LexicalResource><Lexicon>\n"
+        "<LexicalEntry att=\"id\" val=\"1\">"
+        "<feat att=\"partOfSpeech\" val=\"%s\"/>"
+        "<Lemma><feat att=\"writtenForm\" val=\"긴말\"/></Lemma>"
+        "<Sense val=\"0\"><feat att=\"definition\" val=\"%s\"/></Sense>"
+        "</LexicalEntry>\n"
+        "</Lexicon></LexicalResource>\n",
+        value,
+        value
+    );
+
+    const char *inputs[] = { xml_path };
+
+    bool result = write_file(xml_path, xml) && sr_dict_import(inputs, 1, path, 1);
+
+    free(xml);
+
+    struct sr_dict *dict = result ? sr_dict_open(path) : NULL;
+
+    if (dict != NULL) {
+        struct sr_dict_snapshot *snapshot = sr_dict_acquire(dict);
+
+        struct sr_dict_sense senses[MAX_SENSE_COUNT];
+
+        int total = 0;
+
+        result = sr_dict_find(snapshot, "긴말", senses, MAX_SENSE_COUNT, &total) == 1;
+
+        if (result) {
+            const size_t pos_len = strlen(senses[0].pos);
+            const size_t definition_len = strlen(senses[0].definition);
+
+            result = pos_len > 0 && pos_len < MAX_STRING_SIZE
+                && definition_len > pos_len && definition_len < 2 * MAX_STRING_SIZE
+                && strncmp(senses[0].pos, value, pos_len) == 0
+                && strncmp(senses[0].definition, value, definition_len) == 0;
+        }
+
+        sr_dict_release(snapshot);
+        sr_dict_close(dict);
+    } else {
+        result = false;
+    }
+
+    free(value);
+
+    remove_dict(path);
+    remove(xml_path);
+
+    return result;
+}
+
+/* 변경분 파일의 항목이 기본 파일의 같은 항목을 대신하고, 병합한 뒤에도 같은지 확인한다. */
+static bool check_update(void) {
+    char base_path[MAX_STRING_SIZE] = "", update_path[MAX_STRING_SIZE] = "";
+    char path[MAX_STRING_SIZE] = "", segment_path[MAX_STRING_SIZE + 24] = "";
+
+    get_path("base.xml", base_path, sizeof(base_path));
+    get_path("update.xml", update_path, sizeof(update_path));
+    get_path("update.dict", path, sizeof(path));
+
+    snprintf(segment_path, sizeof(segment_path), "%s.1", path);
+
+    remove_dict(path);
+
+    const char *base_inputs[] = { base_path }, *update_inputs[] = { update_path };
+
+    if (!write_file(base_path, base_xml) || !write_file(update_path, update_xml)) return false;
+
+    if (!sr_dict_import(base_inputs, 1, path, 1)
+        || !sr_dict_update(update_inputs, 1, path, 1)
+        || access(segment_path, F_OK) != 0) return false;
+
+    // 작업 스레드에서 병합하는 동안, 변경분 파일을 함께 검색하는 경우를 확인한다.
+    sr_worker_init(1);
+
+    struct sr_dict *dict = sr_dict_open(path);
+
+    if (dict == NULL) {
+        sr_worker_cleanup();
+
+        return false;
+    }
+
+    struct sr_dict_snapshot *snapshot = sr_dict_acquire(dict);
+
+    bool result = check_updated_senses(snapshot);
+
+    sr_dict_release(snapshot);
+
+    const uint64_t begin_time = cog_timestamp_ms();
+
+    // 병합이 끝나면 변경분 파일이 지워진다.
+    while (access(segment_path, F_OK) == 0
+        && cog_timestamp_ms() - begin_time < MERGE_TIMEOUT) {
+        sr_worker_read_results();
+
+        usleep(1000);
+    }
+
+    sr_worker_read_results();
+
+    result = result && access(segment_path, F_OK) != 0;
+
+    snapshot = sr_dict_acquire(dict);
+
+    result = result
+        && check_updated_senses(snapshot)
+        && sr_dict_get_word_count(snapshot) == 4;
+
+    sr_dict_release(snapshot);
+    sr_dict_close(dict);
+
+    sr_worker_cleanup();
+
+    // 병합된 기본 파일을 다시 열어도 같은 결과가 나와야 한다.
+    dict = sr_dict_open(path);
+
+    snapshot = sr_dict_acquire(dict);
+
+    result = result && check_updated_senses(snapshot);
+
+    sr_dict_release(snapshot);
+    sr_dict_close(dict);
+
+    remove_dict(path);
+    remove(base_path);
+    remove(update_path);
+
+    return result;
+}
+
+/* 변경분 파일을 적용한 사전 데이터에서 `사과`의 검색 결과가 올바른지 확인한다. */
+static bool check_updated_senses(struct sr_dict_snapshot *snapshot) {
+    if (snapshot == NULL) return false;
+
+    struct sr_dict_sense senses[MAX_SENSE_COUNT];
+
+    int total = 0;
+
+    // 1번 항목의 뜻풀이 두 개는 변경분 파일의 뜻풀이 하나로 바뀌고, 2번 항목은 그대로 남는다.
+    bool result = sr_dict_find(snapshot, "사과", senses, MAX_SENSE_COUNT, &total) == 2
+        && total == 2
+        && streq(senses[0].definition, "고친 뜻풀이.")
+        && streq(senses[1].definition, "잘못을 인정하고 용서를 빎.");
+
+    result = result
+        && sr_dict_find(snapshot, "포도", senses, MAX_SENSE_COUNT, &total) == 1
+        && streq(senses[0].definition, "포도나무의 열매.")
+        && sr_dict_find(snapshot, "배", senses, MAX_SENSE_COUNT, &total) == 1;
+
+    const char *words[MAX_WORD_COUNT] = { NULL };
+
+    const char *all[] = { "배", "사과", "사과나무", "포도" };
+
+    return result && expect_words(
+        words,
+        sr_dict_find_range(snapshot, NULL, NULL, words, MAX_WORD_COUNT),
+        all,
+        4
+    );
+}
@@ -0,0 +1,143 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <saerom.h>
+
+/* | `keyboard_test` 모듈 자료형 정의... | */
+
+/* 로마자 문자열과 한글로 바꾼 결과를 나타내는 구조체. */
+struct keyboard_case {
+    const char *input;
+    const char *expected;
+};
+
+/* | `keyboard_test` 모듈 상수 및 변수... | */
+
+/* 모든 글자가 한글 음절로 바뀌어야 하는 문자열들. */
+static const struct keyboard_case conversions[] = {
+    { "dkssud",       "안녕"       },
+    { "gksrmf",       "한글"       },
+    { "dkssudgktpdy", "안녕하세요" },
+    { "rkqt",         "값"         },
+    { "fkaus",        "라면"       },
+    { "qnpfr",        "뷁"         },
+    { "tktkd",        "사상"       },
+    { "dmlwk",        "의자"       },
+    { "Dkssud",       "안녕"       },
+    { "ek",           "다"         }
+};
+
+/* 한글 음절로 바뀌지 않는 글자가 있는 문자열들. */
+static const char *rejections[] = { "", "rrr", "dkssud123", "hello world", "사과" };
+
+/* | `keyboard_test` 모듈 함수... | */
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result);
+
+/* 두벌식 자판으로 입력한 문자열이 올바른 한글로 바뀌는지 확인한다. */
+static bool check_conversions(void);
+
+/* 한글 음절로 바뀌지 않는 글자가 있는 문자열을 거절하는지 확인한다. */
+static bool check_rejections(void);
+
+/* 결과를 저장할 공간이 부족할 때, 버퍼 밖에 쓰지 않고 거절하는지 확인한다. */
+static bool check_small_buffer(void);
+
+/* `utils` 모듈의 `read_input()`이 사용하는 명령어 목록. 이 테스트에서는 비어 있다. */
+const struct sr_command *sr_get_commands(int *len) {
+    if (len != NULL) *len = 0;
+
+    return NULL;
+}
+
+/* 한/영 키를 누르지 않고 입력한 검색어가 한글로 바뀌는지 확인한다. */
+int main(void) {
+    int failed = 0;
+
+    failed += report("conversions", check_conversions());
+    failed += report("rejections", check_rejections());
+    failed += report("small buffer", check_small_buffer());
+
+    return (failed > 0) ? 1 : 0;
+}
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result) {
+    printf("%-8s %-32s %s\n", "keyboard", name, result ? "ok" : "FAILED");
+
+    return result ? 0 : 1;
+}
+
+/* 두벌식 자판으로 입력한 문자열이 올바른 한글로 바뀌는지 확인한다. */
+static bool check_conversions(void) {
+    bool result = true;
+
+    for (int i = 0; i < sizeof(conversions) / sizeof(*conversions); i++) {
+        char buffer[MAX_STRING_SIZE] = "";
+
+        if (sr_keyboard_to_hangul(conversions[i].input, buffer, sizeof(buffer))
+            && streq(buffer, conversions[i].expected)) continue;
+
+        fprintf(
+            stderr,
+            "keyboard: \"%s\" -> \"%s\" (expected \"%s\")\n",
+            conversions[i].input,
+            buffer,
+            conversions[i].expected
+        );
+
+        result = false;
+    }
+
+    return result;
+}
+
+/* 한글 음절로 바뀌지 않는 글자가 있는 문자열을 거절하는지 확인한다. */
+static bool check_rejections(void) {
+    bool result = true;
+
+    for (int i = 0; i < sizeof(rejections) / sizeof(*rejections); i++) {
+        char buffer[MAX_STRING_SIZE] = "";
+
+        if (!sr_keyboard_to_hangul(rejections[i], buffer, sizeof(buffer))) continue;
+
+        fprintf(stderr, "keyboard: \"%s\" -> \"%s\" (expected none)\n", rejections[i], buffer);
+
+        result = false;
+    }
+
+    return result;
+}
+
+/* 결과를 저장할 공간이 부족할 때, 버퍼 밖에 쓰지 않고 거절하는지 확인한다. */
+static bool check_small_buffer(void) {
+    char buffer[8];
+
+    memset(buffer, '#', sizeof(buffer));
+
+    // "안녕"은 UTF-8로 6바이트이므로, 널 문자까지 7바이트가 필요하다.
+    if (sr_keyboard_to_hangul("dkssud", buffer, 4)) return false;
+    if (buffer[4] != '#') return false;
+
+    return sr_keyboard_to_hangul("dkssud", buffer, 7) && streq(buffer, "안녕");
+}
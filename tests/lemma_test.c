@@ -0,0 +1,188 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <saerom.h>
+
+/* | `lemma_test` 모듈 매크로 정의... | */
+
+#define MAX_LEMMA_COUNT 16
+
+/* | `lemma_test` 모듈 자료형 정의... | */
+
+/* 활용형과 그 기본형을 나타내는 구조체. */
+struct lemma_case {
+    const char *word;
+    const char *lemma;
+};
+
+/* | `lemma_test` 모듈 상수 및 변수... | */
+
+/* 기본형 후보에 주어진 기본형이 있어야 하는 활용형들. */
+static const struct lemma_case inflections[] = {
+    { "먹는",       "먹다"     },
+    { "먹었습니다", "먹다"     },
+    { "봐요",       "보다"     },
+    { "했다",       "하다"     },
+    { "갔어요",     "가다"     },
+    { "됐다",       "되다"     },
+    { "돼요",       "되다"     },
+    { "예뻐요",     "예쁘다"   },
+    { "몰라요",     "모르다"   },
+    { "추웠다",     "춥다"     },
+    { "아름다운",   "아름답다" },
+    { "들어요",     "듣다"     },
+    { "지어요",     "짓다"     },
+    { "가는",       "갈다"     }
+};
+
+/* 어미가 없으므로 기본형 후보도 없어야 하는 낱말들. */
+static const char *uninflected[] = { "사랑", "고양이", "책상", "" };
+
+/* | `lemma_test` 모듈 함수... | */
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result);
+
+/* 활용형의 기본형 후보에 올바른 기본형이 있는지 확인한다. */
+static bool check_inflections(void);
+
+/* 활용하지 않는 낱말에서 기본형 후보를 만들지 않는지 확인한다. */
+static bool check_uninflected(void);
+
+/* 후보를 저장할 공간이 부족할 때, 버퍼 밖에 쓰지 않는지 확인한다. */
+static bool check_small_buffer(void);
+
+/* `utils` 모듈의 `read_input()`이 사용하는 명령어 목록. 이 테스트에서는 비어 있다. */
+const struct sr_command *sr_get_commands(int *len) {
+    if (len != NULL) *len = 0;
+
+    return NULL;
+}
+
+/* 검색 결과가 없는 활용형에서 사전에서 찾아볼 기본형 후보를 올바르게 만드는지 확인한다. */
+int main(void) {
+    int failed = 0;
+
+    failed += report("inflections", check_inflections());
+    failed += report("uninflected", check_uninflected());
+    failed += report("small buffer", check_small_buffer());
+
+    return (failed > 0) ? 1 : 0;
+}
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result) {
+    printf("%-8s %-32s %s\n", "lemma", name, result ? "ok" : "FAILED");
+
+    return result ? 0 : 1;
+}
+
+/* 활용형의 기본형 후보에 올바른 기본형이 있는지 확인한다. */
+static bool check_inflections(void) {
+    bool result = true;
+
+    for (int i = 0; i < sizeof(inflections) / sizeof(*inflections); i++) {
+        char buffer[MAX_STRING_SIZE] = "";
+
+        const char *lemmas[MAX_LEMMA_COUNT] = { NULL };
+
+        const int count = sr_lemma_find(
+            inflections[i].word,
+            buffer,
+            sizeof(buffer),
+            lemmas,
+            MAX_LEMMA_COUNT
+        );
+
+        bool found = false;
+
+        for (int j = 0; j < count && !found; j++)
+            found = streq(lemmas[j], inflections[i].lemma);
+
+        if (found) continue;
+
+        fprintf(
+            stderr,
+            "lemma: \"%s\" has %d candidate(s) without \"%s\"\n",
+            inflections[i].word,
+            count,
+            inflections[i].lemma
+        );
+
+        result = false;
+    }
+
+    return result;
+}
+
+/* 활용하지 않는 낱말에서 기본형 후보를 만들지 않는지 확인한다. */
+static bool check_uninflected(void) {
+    bool result = true;
+
+    for (int i = 0; i < sizeof(uninflected) / sizeof(*uninflected); i++) {
+        char buffer[MAX_STRING_SIZE] = "";
+
+        const char *lemmas[MAX_LEMMA_COUNT] = { NULL };
+
+        const int count = sr_lemma_find(
+            uninflected[i],
+            buffer,
+            sizeof(buffer),
+            lemmas,
+            MAX_LEMMA_COUNT
+        );
+
+        if (count == 0) continue;
+
+        fprintf(
+            stderr,
+            "lemma: \"%s\" has %d candidate(s), first \"%s\"\n",
+            uninflected[i],
+            count,
+            lemmas[0]
+        );
+
+        result = false;
+    }
+
+    return result;
+}
+
+/* 후보를 저장할 공간이 부족할 때, 버퍼 밖에 쓰지 않는지 확인한다. */
+static bool check_small_buffer(void) {
+    char buffer[16];
+
+    memset(buffer, '#', sizeof(buffer));
+
+    const char *lemmas[MAX_LEMMA_COUNT] = { NULL };
+
+    const int count = sr_lemma_find("먹었습니다", buffer, 8, lemmas, MAX_LEMMA_COUNT);
+
+    if (buffer[8] != '#') return false;
+
+    // 버퍼에 저장된 후보만 반환해야 한다.
+    for (int i = 0; i < count; i++)
+        if (lemmas[i] < buffer || lemmas[i] + strlen(lemmas[i]) >= buffer + 8)
+            return false;
+
+    return sr_lemma_find("먹었습니다", buffer, sizeof(buffer), lemmas, 1) == 1;
+}
@@ -0,0 +1,284 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <saerom.h>
+
+/* | `suggest_test` 모듈 매크로 정의... | */
+
+#define MAX_WORD_COUNT 8
+
+/* | `suggest_test` 모듈 상수 및 변수... | */
+
+/* 검색 기록 파일을 만들 디렉토리의 경로. */
+static const char *directory;
+
+/* | `suggest_test` 모듈 함수... | */
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result);
+
+/* 테스트에 사용할 표제어 목록으로 자동 완성 색인을 만든다. */
+static struct sr_suggest *create_suggest(void);
+
+/* 검색 결과의 표제어 목록이 주어진 목록과 같은지 확인한다. */
+static bool expect_words(const char **words, int count, const char *expected[], int len);
+
+/* 검색 횟수와 학습 등급 순서대로 표제어들을 찾는지 확인한다. */
+static bool check_find(void);
+
+/* 자모 단위의 편집 거리가 가까운 표제어들을 찾는지 확인한다. */
+static bool check_correct(void);
+
+/* 색인에 없는 검색어를 모아 두었다가 합친 뒤에 찾을 수 있는지 확인한다. */
+static bool check_merge(void);
+
+/* 검색 기록을 파일에 기록하고 다시 읽었을 때, 같은 순서로 찾는지 확인한다. */
+static bool check_save(void);
+
+/* `utils` 모듈의 `read_input()`이 사용하는 명령어 목록. 이 테스트에서는 비어 있다. */
+const struct sr_command *sr_get_commands(int *len) {
+    if (len != NULL) *len = 0;
+
+    return NULL;
+}
+
+/* 자동 완성 색인의 검색, 오타 교정, 검색어 합치기와 검색 기록이 올바른지 확인한다. */
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s DIRECTORY\n", argv[0]);
+
+        return 2;
+    }
+
+    directory = argv[1];
+
+    int failed = 0;
+
+    failed += report("find", check_find());
+    failed += report("correct", check_correct());
+    failed += report("merge", check_merge());
+    failed += report("save", check_save());
+
+    return (failed > 0) ? 1 : 0;
+}
+
+/* 테스트 결과를 출력하고, 실패했다면 1을 반환한다. */
+static int report(const char *name, bool result) {
+    printf("%-8s %-32s %s\n", "suggest", name, result ? "ok" : "FAILED");
+
+    return result ? 0 : 1;
+}
+
+/* 테스트에 사용할 표제어 목록으로 자동 완성 색인을 만든다. */
+static struct sr_suggest *create_suggest(void) {
+    struct sr_suggest *result = sr_suggest_create();
+
+    sr_suggest_add(result, "사과", SR_DICT_LEVEL_BEGINNER);
+    sr_suggest_add(result, "사람", SR_DICT_LEVEL_INTERMEDIATE);
+    sr_suggest_add(result, "사랑", SR_DICT_LEVEL_NONE);
+    sr_suggest_add(result, "사자", SR_DICT_LEVEL_ADVANCED);
+    sr_suggest_add(result, "바다", SR_DICT_LEVEL_NONE);
+
+    sr_suggest_build(result);
+
+    return result;
+}
+
+/* 검색 결과의 표제어 목록이 주어진 목록과 같은지 확인한다. */
+static bool expect_words(const char **words, int count, const char *expected[], int len) {
+    bool result = (count == len);
+
+    for (int i = 0; i < len && result; i++)
+        result = streq(words[i], expected[i]);
+
+    if (!result) {
+        fprintf(stderr, "suggest: got %d word(s):", count);
+
+        for (int i = 0; i < count; i++) fprintf(stderr, " %s", words[i]);
+
+        fprintf(stderr, "\n");
+    }
+
+    return result;
+}
+
+/* 검색 횟수와 학습 등급 순서대로 표제어들을 찾는지 확인한다. */
+static bool check_find(void) {
+    struct sr_suggest *suggest = create_suggest();
+
+    const char *words[MAX_WORD_COUNT] = { NULL };
+
+    const char *by_level[] = { "사과", "사람", "사자", "사랑" };
+    const char *by_hits[] = { "사랑", "사과", "사람", "사자" };
+
+    bool result = expect_words(
+        words,
+        sr_suggest_find(suggest, "사", words, MAX_WORD_COUNT),
+        by_level,
+        4
+    );
+
+    // 검색 횟수가 많은 표제어는 학습 등급과 관계없이 먼저 나온다.
+    sr_suggest_hit(suggest, "사랑");
+
+    result = result && expect_words(
+        words,
+        sr_suggest_find(suggest, "사", words, MAX_WORD_COUNT),
+        by_hits,
+        4
+    );
+
+    result = result && expect_words(
+        words,
+        sr_suggest_find(suggest, "사", words, 2),
+        by_hits,
+        2
+    );
+
+    result = result
+        && sr_suggest_find(suggest, "포", words, MAX_WORD_COUNT) == 0
+        && sr_suggest_find(suggest, "", words, MAX_WORD_COUNT) == 5;
+
+    sr_suggest_release(suggest);
+
+    return result;
+}
+
+/* 자모 단위의 편집 거리가 가까운 표제어들을 찾는지 확인한다. */
+static bool check_correct(void) {
+    struct sr_suggest *suggest = create_suggest();
+
+    const char *words[MAX_WORD_COUNT] = { NULL };
+
+    bool found = false;
+
+    const int count = sr_suggest_correct(suggest, "사가", words, MAX_WORD_COUNT);
+
+    for (int i = 0; i < count && !found; i++)
+        found = streq(words[i], "사과");
+
+    const char *seas[] = { "바다" };
+
+    const bool result = found && expect_words(
+        words,
+        sr_suggest_correct(suggest, "바당", words, MAX_WORD_COUNT),
+        seas,
+        1
+    );
+
+    sr_suggest_release(suggest);
+
+    return result;
+}
+
+/* 색인에 없는 검색어를 모아 두었다가 합친 뒤에 찾을 수 있는지 확인한다. */
+static bool check_merge(void) {
+    struct sr_suggest *suggest = create_suggest();
+
+    const char *words[MAX_WORD_COUNT] = { NULL };
+
+    // 색인에 없는 검색어는 합치기 전까지 찾을 수 없다.
+    sr_suggest_hit(suggest, "사슴");
+    sr_suggest_hit(suggest, "사슴");
+
+    bool result = sr_suggest_find(suggest, "사슴", words, MAX_WORD_COUNT) == 0
+        && sr_suggest_begin_merge(suggest)
+        && !sr_suggest_begin_merge(suggest);
+
+    // 작업 스레드에서 합치는 동안 들어온 검색어는, 합친 뒤에 반영되어야 한다.
+    sr_suggest_merge(suggest);
+
+    sr_suggest_hit(suggest, "사자");
+    sr_suggest_hit(suggest, "사자");
+    sr_suggest_hit(suggest, "사자");
+    sr_suggest_hit(suggest, "사슴");
+    sr_suggest_hit(suggest, "사막");
+
+    sr_suggest_end_merge(suggest);
+
+    const char *merged[] = { "사자", "사슴", "사과", "사람", "사랑" };
+
+    result = result && expect_words(
+        words,
+        sr_suggest_find(suggest, "사", words, MAX_WORD_COUNT),
+        merged,
+        5
+    );
+
+    // 합치는 동안 들어온 새로운 검색어는 다음에 합칠 때 추가된다.
+    result = result
+        && sr_suggest_find(suggest, "사막", words, MAX_WORD_COUNT) == 0
+        && sr_suggest_find(suggest, "바", words, MAX_WORD_COUNT) == 1;
+
+    sr_suggest_release(suggest);
+
+    return result;
+}
+
+/* 검색 기록을 파일에 기록하고 다시 읽었을 때, 같은 순서로 찾는지 확인한다. */
+static bool check_save(void) {
+    char path[MAX_STRING_SIZE] = "";
+
+    snprintf(path, sizeof(path), "%s/suggest.log", directory);
+
+    struct sr_suggest *suggest = create_suggest();
+
+    sr_suggest_hit(suggest, "사람");
+    sr_suggest_hit(suggest, "사람");
+    sr_suggest_hit(suggest, "사자");
+
+    // 아직 합치지 않은 검색어도 기록되어야 한다.
+    sr_suggest_hit(suggest, "사슴");
+
+    bool result = sr_suggest_save(suggest, path);
+
+    sr_suggest_release(suggest);
+
+    suggest = sr_suggest_create();
+
+    sr_suggest_add(suggest, "사과", SR_DICT_LEVEL_BEGINNER);
+    sr_suggest_add(suggest, "사람", SR_DICT_LEVEL_INTERMEDIATE);
+    sr_suggest_add(suggest, "사랑", SR_DICT_LEVEL_NONE);
+    sr_suggest_add(suggest, "사자", SR_DICT_LEVEL_ADVANCED);
+    sr_suggest_add(suggest, "바다", SR_DICT_LEVEL_NONE);
+
+    result = result && sr_suggest_load(suggest, path);
+
+    sr_suggest_build(suggest);
+
+    const char *words[MAX_WORD_COUNT] = { NULL };
+
+    const char *loaded[] = { "사람", "사자", "사슴", "사과", "사랑" };
+
+    result = result && expect_words(
+        words,
+        sr_suggest_find(suggest, "사", words, MAX_WORD_COUNT),
+        loaded,
+        5
+    );
+
+    sr_suggest_release(suggest);
+
+    remove(path);
+
+    return result;
+}
@@ -0,0 +1,254 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <yxml.h>
+
+/* | `yxml_bench` 모듈 매크로 정의... | */
+
+#define PARSE_STACK_SIZE   512
+#define CONTENT_SIZE       4096
+
+/* 한 번 측정할 때마다 읽는 응답 데이터의 최소 크기. */
+#define ROUND_BYTES        (16 * 1024 * 1024)
+#define ROUND_COUNT        15
+
+/* | `yxml_bench` 모듈 상수 및 변수... | */
+
+/* `yxml_parse_buf()`가 사용할 수 있는 모든 커널의 이름. */
+static const char *kernels[] = { "scalar", "sse2", "avx2", "neon" };
+
+/* 파서가 반환한 내용을 복사해 두는 버퍼. */
+static char content[CONTENT_SIZE];
+
+/* `yxml_parse_buf()`가 지금 사용하는 커널의 이름. */
+static const char *kernel;
+
+/* | `yxml_bench` 모듈 함수... | */
+
+/* 주어진 파일의 내용을 읽는다. */
+static char *read_file(const char *path, size_t *len);
+
+/* 현재 시각을 초 단위로 반환한다. */
+static double get_time(void);
+
+/* 응답 데이터를 `yxml_parse()`로 한 바이트씩 읽고, 내용의 바이트 수를 반환한다. */
+static size_t parse_bytes(const char *data, size_t len);
+
+/* 응답 데이터를 지금 사용하는 커널과 `yxml_parse_buf()`로 읽고, 내용의 바이트 수를 반환한다. */
+static size_t parse_buf(const char *data, size_t len);
+
+/* 주어진 커널을 빌드와 CPU가 지원하는지 확인한다. */
+static bool is_supported(const char *name);
+
+/* 주어진 함수로 응답 데이터를 여러 번 읽고, 가장 빨랐던 처리량 (MB/s)을 반환한다. */
+static double measure(
+    size_t (*parse)(const char *, size_t),
+    const char *data,
+    size_t len
+);
+
+/*
+    응답 데이터를 `yxml_parse()`로 한 바이트씩 읽을 때와
+    `yxml_parse_buf()`로 읽을 때의 처리량을 커널마다 비교한다.
+*/
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s FILE...\n", argv[0]);
+
+        return 2;
+    }
+
+    printf("%-28s %9s %10s", "file", "bytes", "yxml_parse");
+
+    for (int i = 0; i < sizeof(kernels) / sizeof(*kernels); i++)
+        if (is_supported(kernels[i])) printf(" %10s", kernels[i]);
+
+    printf("   (MB/s)\n");
+
+    for (int i = 1; i < argc; i++) {
+        size_t len = 0;
+
+        char *data = read_file(argv[i], &len);
+
+        if (data == NULL) {
+            fprintf(stderr, "%s: cannot read file\n", argv[i]);
+
+            return 1;
+        }
+
+        printf("%-28s %9zu %10.1f", argv[i], len, measure(parse_bytes, data, len));
+
+        for (int j = 0; j < sizeof(kernels) / sizeof(*kernels); j++) {
+            if (!is_supported(kernels[j])) continue;
+
+            kernel = kernels[j];
+
+            // 두 방법이 읽은 내용의 양이 다르다면, 측정 결과를 비교할 수 없다.
+            if (parse_bytes(data, len) != parse_buf(data, len)) {
+                fprintf(stderr, "\n%s: yxml_parse() and %s disagree\n", argv[i], kernel);
+
+                return 1;
+            }
+
+            printf(" %10.1f", measure(parse_buf, data, len));
+
+            fflush(stdout);
+        }
+
+        printf("\n");
+
+        free(data);
+    }
+
+    return 0;
+}
+
+/* 주어진 파일의 내용을 읽는다. */
+static char *read_file(const char *path, size_t *len) {
+    FILE *fp = fopen(path, "rb");
+
+    if (fp == NULL) return NULL;
+
+    fseek(fp, 0, SEEK_END);
+
+    const long size = ftell(fp);
+
+    rewind(fp);
+
+    char *result = malloc((size > 0) ? size : 1);
+
+    *len = fread(result, 1, size, fp);
+
+    fclose(fp);
+
+    return result;
+}
+
+/* 현재 시각을 초 단위로 반환한다. */
+static double get_time(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 응답 데이터를 `yxml_parse()`로 한 바이트씩 읽고, 내용의 바이트 수를 반환한다. */
+static size_t parse_bytes(const char *data, size_t len) {
+    char stack[PARSE_STACK_SIZE];
+
+    yxml_t x;
+
+    yxml_init(&x, stack, sizeof(stack));
+
+    size_t result = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        const yxml_ret_t token = yxml_parse(&x, data[i]);
+
+        if (token < 0) break;
+
+        // `/krd` 명령어처럼, 내용을 한 글자씩 버퍼에 복사한다.
+        if (token == YXML_CONTENT)
+            for (const char *c = x.data; *c != '\0'; c++)
+                content[result++ % CONTENT_SIZE] = *c;
+    }
+
+    return result;
+}
+
+/* 응답 데이터를 지금 사용하는 커널과 `yxml_parse_buf()`로 읽고, 내용의 바이트 수를 반환한다. */
+static size_t parse_buf(const char *data, size_t len) {
+    char stack[PARSE_STACK_SIZE];
+
+    yxml_t x;
+
+    yxml_init(&x, stack, sizeof(stack));
+    yxml_set_kernel(&x, kernel);
+
+    size_t result = 0;
+
+    for (size_t i = 0; i < len;) {
+        size_t consumed = 0;
+
+        const yxml_ret_t token = yxml_parse_buf(&x, data + i, len - i, &consumed);
+
+        i += consumed;
+
+        if (token < 0) break;
+
+        // `/krd` 명령어처럼, 내용을 한 번에 버퍼에 복사한다.
+        if (token == YXML_CONTENT) {
+            const size_t offset = result % CONTENT_SIZE;
+
+            const size_t n = (x.spanlen < CONTENT_SIZE - offset)
+                ? x.spanlen
+                : CONTENT_SIZE - offset;
+
+            memcpy(content + offset, x.span, n);
+
+            result += x.spanlen;
+        }
+    }
+
+    return result;
+}
+
+/* 주어진 커널을 빌드와 CPU가 지원하는지 확인한다. */
+static bool is_supported(const char *name) {
+    char stack[PARSE_STACK_SIZE];
+
+    yxml_t x;
+
+    yxml_init(&x, stack, sizeof(stack));
+
+    return yxml_set_kernel(&x, name);
+}
+
+/* 주어진 함수로 응답 데이터를 여러 번 읽고, 가장 빨랐던 처리량 (MB/s)을 반환한다. */
+static double measure(
+    size_t (*parse)(const char *, size_t),
+    const char *data,
+    size_t len
+) {
+    const size_t repeat_count = (len > 0) ? 1 + ROUND_BYTES / len : 1;
+
+    volatile size_t sink = 0;
+
+    double best = 0.0;
+
+    for (int i = 0; i < ROUND_COUNT; i++) {
+        const double begin = get_time();
+
+        for (size_t j = 0; j < repeat_count; j++)
+            sink += parse(data, len);
+
+        const double elapsed = get_time() - begin;
+
+        if (i == 0 || elapsed < best) best = elapsed;
+    }
+
+    (void) sink;
+
+    return (best > 0.0) ? (len * repeat_count) / best / 1e6 : 0.0;
+}
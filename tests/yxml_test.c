@@ -0,0 +1,523 @@
+/*
+    Copyright (c) 2022 jdeokkim
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <yxml.h>
+
+/* | `yxml_test` 모듈 매크로 정의... | */
+
+#define PARSE_STACK_SIZE   512
+
+#define RANDOM_SPLIT_COUNT 100
+#define MUTATION_COUNT     100
+
+#define MAX_RUN_LENGTH     100
+
+/* | `yxml_test` 모듈 자료형 정의... | */
+
+/* XML 파서가 반환한 토큰을 순서대로 기록한 결과를 나타내는 구조체. */
+struct yxml_trace {
+    char *str;
+    size_t len;
+    size_t size;
+    yxml_ret_t error;
+    uint32_t line;
+    uint64_t byte;
+    uint64_t total;
+};
+
+/* | `yxml_test` 모듈 상수 및 변수... | */
+
+/* `yxml_parse_buf()`가 사용할 수 있는 모든 커널의 이름. */
+static const char *kernels[] = { "scalar", "sse2", "avx2", "neon" };
+
+/* 내용, 속성 값, CDATA 섹션을 만드는 XML 문서의 앞부분과 뒷부분. */
+static const char *run_templates[][2] = {
+    { "<r>",            "</r>"     },
+    { "<r a=\"",        "\"/>"     },
+    { "<r a='",         "'/>"      },
+    { "<r><![CDATA[",   "]]></r>"  }
+};
+
+/* 커널이 찾아야 하는 문자들과, 찾지 않아야 하는 문자 몇 가지. */
+static const char run_stops[] = "<&\r\n\0]\"'\t >";
+
+/* 내용을 채우는 문자들 (UTF-8 문자의 각 바이트는 부호 있는 `char`로 음수이다). */
+static const char run_filler[] = "x\xEA\xB0\x80y";
+
+/* 모든 분할 방법에서 사용하는 고정된 크기의 데이터 조각. */
+static const size_t chunk_sizes[] = { 1, 2, 3, 5, 7, 15, 16, 17, 31, 32, 33, 64, 4096 };
+
+/* 응답 데이터를 변형할 때 사용하는 문자들. */
+static const char mutations[] = "<>&;/\"'=]\r\n \t\0ab#x[!?-";
+
+/* 난수 생성기의 상태. */
+static uint32_t seed;
+
+/* `yxml_parse_buf()`가 지금 사용하는 커널의 이름. */
+static const char *kernel;
+
+/* | `yxml_test` 모듈 함수... | */
+
+/* 주어진 파일의 내용을 읽는다. */
+static char *read_file(const char *path, size_t *len);
+
+/* 항상 같은 순서로 난수를 생성한다. */
+static uint32_t next_random(void);
+
+/* 토큰 기록에 주어진 문자열을 추가한다. */
+static void trace_append(struct yxml_trace *trace, const char *str, size_t len);
+
+/* 토큰 기록에 XML 파서가 반환한 토큰 하나를 추가한다. */
+static void trace_token(
+    struct yxml_trace *trace,
+    const yxml_t *x,
+    yxml_ret_t token,
+    const char *data,
+    size_t len
+);
+
+/* 응답 데이터를 `yxml_parse()`로 한 바이트씩 읽고, 토큰을 기록한다. */
+static void trace_bytes(struct yxml_trace *trace, const char *data, size_t len);
+
+/*
+    응답 데이터를 주어진 위치에서 나눈 조각마다 `yxml_parse_buf()`로 읽고, 토큰을 기록한다.
+    각 조각은 따로 할당한 버퍼에 복사하여, 이전 조각의 내용을 읽지 못하도록 한다.
+*/
+static void trace_chunks(
+    struct yxml_trace *trace,
+    const char *data,
+    size_t len,
+    const size_t *splits,
+    size_t split_count
+);
+
+/* 두 토큰 기록이 같은지 확인한다. */
+static bool trace_equals(const struct yxml_trace *lhs, const struct yxml_trace *rhs);
+
+/* 응답 데이터를 주어진 위치에서 나누어 읽은 결과가 한 바이트씩 읽은 결과와 같은지 확인한다. */
+static bool check_splits(
+    const char *path,
+    const struct yxml_trace *expected,
+    const char *data,
+    size_t len,
+    const size_t *splits,
+    size_t split_count
+);
+
+/* 
+    응답 데이터를 여러 방법으로 나누어 읽은 결과가 한 바이트씩 읽은 결과와 같은지 확인한다.
+    같은 크기의 조각으로 나누는 방법 외에, 무작위로 고른 위치에서 `random_count`번 나누어 읽는다.
+*/
+static bool check_file(const char *path, const char *data, size_t len, int random_count);
+
+/*
+    내용, 속성 값, CDATA 섹션의 길이와 그 안에서 멈춰야 하는 문자의 위치를 바꿔 가며,
+    커널로 읽은 결과가 한 바이트씩 읽은 결과와 같은지 확인한다.
+*/
+static bool check_runs(void);
+
+/* 주어진 파일들을 지금 사용하는 커널로 읽은 결과가 한 바이트씩 읽은 결과와 같은지 확인한다. */
+static int check_files(int count, char *paths[]);
+
+/*
+    `yxml_parse()`와 `yxml_parse_buf()`가 같은 토큰을 반환하는지 확인한다.
+    응답 데이터를 여러 크기의 조각으로 나누어 읽어도, 조각의 경계와 관계없이 같은 결과가 나와야 한다.
+    `yxml_parse_buf()`는 빌드와 CPU가 지원하는 모든 커널로 한 번씩 확인한다.
+*/
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s FILE...\n", argv[0]);
+
+        return 2;
+    }
+
+    int failed = 0;
+
+    for (int i = 0; i < sizeof(kernels) / sizeof(*kernels); i++) {
+        char stack[PARSE_STACK_SIZE];
+
+        yxml_t x;
+
+        yxml_init(&x, stack, sizeof(stack));
+
+        if (!yxml_set_kernel(&x, kernels[i])) {
+            printf("%-8s %-32s %s\n", kernels[i], "-", "not available");
+
+            continue;
+        }
+
+        kernel = kernels[i];
+
+        // 모든 커널이 같은 방법으로 나누고 변형한 응답 데이터를 읽도록 한다.
+        seed = 45;
+
+        const bool result = check_runs();
+
+        printf("%-8s %-32s %s\n", kernel, "(runs)", result ? "ok" : "FAILED");
+
+        if (!result) failed++;
+
+        failed += check_files(argc - 1, argv + 1);
+    }
+
+    return (failed > 0) ? 1 : 0;
+}
+
+/* 주어진 파일의 내용을 읽는다. */
+static char *read_file(const char *path, size_t *len) {
+    FILE *fp = fopen(path, "rb");
+
+    if (fp == NULL) return NULL;
+
+    fseek(fp, 0, SEEK_END);
+
+    const long size = ftell(fp);
+
+    rewind(fp);
+
+    char *result = malloc((size > 0) ? size : 1);
+
+    *len = fread(result, 1, size, fp);
+
+    fclose(fp);
+
+    return result;
+}
+
+/* 항상 같은 순서로 난수를 생성한다. */
+static uint32_t next_random(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    return seed;
+}
+
+/* 토큰 기록에 주어진 문자열을 추가한다. */
+static void trace_append(struct yxml_trace *trace, const char *str, size_t len) {
+    if (trace->len + len > trace->size) {
+        trace->size = 2 * (trace->len + len);
+        trace->str = realloc(trace->str, trace->size);
+    }
+
+    memcpy(trace->str + trace->len, str, len);
+
+    trace->len += len;
+}
+
+/* 토큰 기록에 XML 파서가 반환한 토큰 하나를 추가한다. */
+static void trace_token(
+    struct yxml_trace *trace,
+    const yxml_t *x,
+    yxml_ret_t token,
+    const char *data,
+    size_t len
+) {
+    if (token == YXML_CONTENT || token == YXML_ATTRVAL || token == YXML_PICONTENT) {
+        // 내용은 한 번에 반환된 바이트 수와 관계없이, 바이트마다 같은 방식으로 기록한다.
+        for (size_t i = 0; i < len; i++) {
+            const char pair[2] = { 'A' + token, data[i] };
+
+            trace_append(trace, pair, sizeof(pair));
+        }
+    } else if (token != YXML_OK) {
+        const char marker = '0' + token;
+
+        trace_append(trace, &marker, 1);
+
+        if (token == YXML_ELEMSTART) trace_append(trace, x->elem, strlen(x->elem) + 1);
+        else if (token == YXML_ATTRSTART) trace_append(trace, x->attr, strlen(x->attr) + 1);
+        else if (token == YXML_PISTART) trace_append(trace, x->pi, strlen(x->pi) + 1);
+    }
+}
+
+/* 응답 데이터를 `yxml_parse()`로 한 바이트씩 읽고, 토큰을 기록한다. */
+static void trace_bytes(struct yxml_trace *trace, const char *data, size_t len) {
+    char stack[PARSE_STACK_SIZE];
+
+    yxml_t x;
+
+    yxml_init(&x, stack, sizeof(stack));
+
+    trace->error = YXML_OK;
+
+    for (size_t i = 0; i < len; i++) {
+        const yxml_ret_t token = yxml_parse(&x, data[i]);
+
+        if (token < 0) {
+            trace->error = token;
+
+            break;
+        }
+
+        trace_token(trace, &x, token, x.data, strlen(x.data));
+    }
+
+    trace->line = x.line;
+    trace->byte = x.byte;
+    trace->total = x.total;
+}
+
+/*
+    응답 데이터를 주어진 위치에서 나눈 조각마다 `yxml_parse_buf()`로 읽고, 토큰을 기록한다.
+    각 조각은 따로 할당한 버퍼에 복사하여, 이전 조각의 내용을 읽지 못하도록 한다.
+*/
+static void trace_chunks(
+    struct yxml_trace *trace,
+    const char *data,
+    size_t len,
+    const size_t *splits,
+    size_t split_count
+) {
+    char stack[PARSE_STACK_SIZE];
+
+    yxml_t x;
+
+    yxml_init(&x, stack, sizeof(stack));
+    yxml_set_kernel(&x, kernel);
+
+    trace->error = YXML_OK;
+
+    size_t begin = 0;
+
+    for (size_t i = 0; i <= split_count && trace->error == YXML_OK; i++) {
+        const size_t end = (i < split_count) ? splits[i] : len;
+
+        char *chunk = malloc((end > begin) ? end - begin : 1);
+
+        memcpy(chunk, data + begin, end - begin);
+
+        for (size_t offset = 0; offset < end - begin;) {
+            size_t consumed = 0;
+
+            const yxml_ret_t token = yxml_parse_buf(
+                &x,
+                chunk + offset,
+                end - begin - offset,
+                &consumed
+            );
+
+            offset += consumed;
+
+            if (token < 0) {
+                trace->error = token;
+
+                break;
+            }
+
+            trace_token(trace, &x, token, x.span, x.spanlen);
+        }
+
+        free(chunk);
+
+        begin = end;
+    }
+
+    trace->line = x.line;
+    trace->byte = x.byte;
+    trace->total = x.total;
+}
+
+/* 두 토큰 기록이 같은지 확인한다. */
+static bool trace_equals(const struct yxml_trace *lhs, const struct yxml_trace *rhs) {
+    return lhs->len == rhs->len
+        && memcmp(lhs->str, rhs->str, lhs->len) == 0
+        && lhs->error == rhs->error
+        && lhs->line == rhs->line
+        && lhs->byte == rhs->byte
+        && lhs->total == rhs->total;
+}
+
+/* 응답 데이터를 주어진 위치에서 나누어 읽은 결과가 한 바이트씩 읽은 결과와 같은지 확인한다. */
+static bool check_splits(
+    const char *path,
+    const struct yxml_trace *expected,
+    const char *data,
+    size_t len,
+    const size_t *splits,
+    size_t split_count
+) {
+    struct yxml_trace actual = { .str = NULL };
+
+    trace_chunks(&actual, data, len, splits, split_count);
+
+    const bool result = trace_equals(expected, &actual);
+
+    if (!result) {
+        size_t i = 0;
+
+        while (i < expected->len && i < actual.len && expected->str[i] == actual.str[i]) i++;
+
+        fprintf(
+            stderr,
+            "%s: %s: %zu split(s), first at %zu: traces differ at %zu"
+            " (error %d/%d, line %u/%u, total %llu/%llu)\n",
+            kernel,
+            path,
+            split_count,
+            (split_count > 0) ? splits[0] : len,
+            i,
+            expected->error,
+            actual.error,
+            expected->line,
+            actual.line,
+            (unsigned long long) expected->total,
+            (unsigned long long) actual.total
+        );
+    }
+
+    free(actual.str);
+
+    return result;
+}
+
+/* 
+    응답 데이터를 여러 방법으로 나누어 읽은 결과가 한 바이트씩 읽은 결과와 같은지 확인한다.
+    같은 크기의 조각으로 나누는 방법 외에, 무작위로 고른 위치에서 `random_count`번 나누어 읽는다.
+*/
+static bool check_file(const char *path, const char *data, size_t len, int random_count) {
+    struct yxml_trace expected = { .str = NULL };
+
+    trace_bytes(&expected, data, len);
+
+    size_t *splits = malloc((len + 1) * sizeof(*splits));
+
+    // 한 번에 모두 읽는 경우
+    bool result = check_splits(path, &expected, data, len, NULL, 0);
+
+    // 같은 크기의 조각으로 나누어 읽는 경우
+    for (size_t i = 0; result && i < sizeof(chunk_sizes) / sizeof(*chunk_sizes); i++) {
+        size_t split_count = 0;
+
+        for (size_t offset = chunk_sizes[i]; offset < len; offset += chunk_sizes[i])
+            splits[split_count++] = offset;
+
+        result = check_splits(path, &expected, data, len, splits, split_count);
+    }
+
+    // 무작위로 고른 위치에서 나누어 읽는 경우
+    for (int i = 0; result && i < random_count && len > 1; i++) {
+        size_t split_count = 0;
+
+        for (size_t offset = 1 + next_random() % len; offset < len;
+            offset += 1 + next_random() % (1 + len / 8))
+            splits[split_count++] = offset;
+
+        result = check_splits(path, &expected, data, len, splits, split_count);
+    }
+
+    free(splits);
+    free(expected.str);
+
+    return result;
+}
+
+/*
+    내용, 속성 값, CDATA 섹션의 길이와 그 안에서 멈춰야 하는 문자의 위치를 바꿔 가며,
+    커널로 읽은 결과가 한 바이트씩 읽은 결과와 같은지 확인한다.
+*/
+static bool check_runs(void) {
+    char data[MAX_RUN_LENGTH + 32];
+
+    for (int i = 0; i < sizeof(run_templates) / sizeof(*run_templates); i++) {
+        const size_t prefix_len = strlen(run_templates[i][0]);
+        const size_t suffix_len = strlen(run_templates[i][1]);
+
+        for (size_t run_len = 1; run_len <= MAX_RUN_LENGTH; run_len++) {
+            for (size_t pos = 0; pos < run_len; pos++) {
+                for (size_t j = 0; j < sizeof(run_stops) - 1; j++) {
+                    char *run = data + prefix_len;
+
+                    memcpy(data, run_templates[i][0], prefix_len);
+
+                    for (size_t k = 0; k < run_len; k++)
+                        run[k] = run_filler[k % (sizeof(run_filler) - 1)];
+
+                    run[pos] = run_stops[j];
+
+                    memcpy(run + run_len, run_templates[i][1], suffix_len);
+
+                    const size_t len = prefix_len + run_len + suffix_len;
+
+                    struct yxml_trace expected = { .str = NULL };
+
+                    trace_bytes(&expected, data, len);
+
+                    // 한 번에 모두 읽는 경우와, 멈춰야 하는 문자 바로 앞에서 나누어 읽는 경우
+                    const size_t split = prefix_len + pos;
+
+                    const bool result = check_splits("(runs)", &expected, data, len, NULL, 0)
+                        && check_splits("(runs)", &expected, data, len, &split, 1);
+
+                    free(expected.str);
+
+                    if (!result) return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/* 주어진 파일들을 지금 사용하는 커널로 읽은 결과가 한 바이트씩 읽은 결과와 같은지 확인한다. */
+static int check_files(int count, char *paths[]) {
+    int failed = 0;
+
+    for (int i = 0; i < count; i++) {
+        size_t len = 0;
+
+        char *data = read_file(paths[i], &len);
+
+        if (data == NULL) {
+            fprintf(stderr, "%s: cannot read file\n", paths[i]);
+
+            failed++;
+
+            continue;
+        }
+
+        bool result = check_file(paths[i], data, len, RANDOM_SPLIT_COUNT);
+
+        // 응답 데이터의 일부를 변형하여, 오류가 발생하는 경우도 확인한다.
+        for (int j = 0; result && j < MUTATION_COUNT && len > 0; j++) {
+            char *copy = malloc(len);
+
+            memcpy(copy, data, len);
+
+            for (int k = next_random() % 4; k >= 0; k--)
+                copy[next_random() % len] = mutations[next_random() % sizeof(mutations)];
+
+            result = check_file(paths[i], copy, len, RANDOM_SPLIT_COUNT / 25);
+
+            free(copy);
+        }
+
+        printf("%-8s %-32s %s\n", kernel, paths[i], result ? "ok" : "FAILED");
+
+        if (!result) failed++;
+
+        free(data);
+    }
+
+    return failed;
+}